@@ -132,7 +132,7 @@ static void FreeOldCacheDirectory(const fml::UniqueFD& cache_base_dir) {
 static std::shared_ptr<fml::UniqueFD> MakeCacheDirectory(
     const std::string& global_cache_base_path,
     bool read_only,
-    bool cache_sksl) {
+    const char* subdir_name) {
   fml::UniqueFD cache_base_dir;
   if (global_cache_base_path.length()) {
     cache_base_dir = fml::OpenDirectory(global_cache_base_path.c_str(), false,
@@ -145,8 +145,8 @@ static std::shared_ptr<fml::UniqueFD> MakeCacheDirectory(
     FreeOldCacheDirectory(cache_base_dir);
     std::vector<std::string> components = {
         kEngineComponent, GetFlutterEngineVersion(), "skia", GetSkiaVersion()};
-    if (cache_sksl) {
-      components.push_back(PersistentCache::kSkSLSubdirName);
+    if (subdir_name != nullptr) {
+      components.push_back(subdir_name);
     }
     return std::make_shared<fml::UniqueFD>(
         CreateDirectory(cache_base_dir, components,
@@ -251,9 +251,14 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() {
 
 PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
-      cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
+      cache_directory_(
+          MakeCacheDirectory(cache_base_path_, read_only, nullptr)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, kSkSLSubdirName)),
+      font_coverage_cache_directory_(MakeCacheDirectory(
+          cache_base_path_,
+          read_only,
+          kFontCoverageSubdirName)) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
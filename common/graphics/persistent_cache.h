@@ -85,7 +85,14 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   static void SetCacheSkSL(bool value);
   static void MarkStrategySet() { strategy_set_ = true; }
 
+  /// The directory in which the coverage of fonts is cached. See
+  /// |txt::FontCoverageCache|.
+  std::shared_ptr<fml::UniqueFD> GetFontCoverageCacheDirectory() const {
+    return font_coverage_cache_directory_;
+  }
+
   static constexpr char kSkSLSubdirName[] = "sksl";
+  static constexpr char kFontCoverageSubdirName[] = "fonts";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
 
  private:
@@ -109,6 +116,7 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  const std::shared_ptr<fml::UniqueFD> font_coverage_cache_directory_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
 
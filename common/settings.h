@@ -155,6 +155,40 @@ struct Settings {
   // Selects the SkParagraph implementation of the text layout engine.
   bool enable_skparagraph = false;
 
+  // Compiles the layer tree of every scene into a flat array of ops that the
+  // rasterizer prerolls and paints instead of walking the layers. Scenes with
+  // layers that cannot be compiled are rendered as usual.
+  bool enable_compiled_layer_trees = false;
+
+  // Fingerprints the content of every recorded picture so that the raster
+  // cache can reuse the entries of earlier pictures with the same content.
+  // Computing a fingerprint serializes the picture on the UI thread. See
+  // |ComputePictureFingerprint|.
+  bool enable_picture_fingerprints = false;
+
+  // Lets the raster cache draw entries rasterized at a scale within this
+  // relative tolerance of the one they are drawn at, e.g. 0.25 for 25%, so
+  // that zoom and scale animations don't miss the cache on every frame. Zero
+  // disables this. See |RasterCache::SetScaleTolerance|.
+  double raster_cache_scale_tolerance = 0;
+
+  // Packs small raster cache entries into shared atlas surfaces instead of
+  // giving each entry a surface of its own.
+  bool enable_raster_cache_atlas = false;
+
+  // Prerolls the sibling subtrees of large layer trees in parallel on the
+  // workers of the VM. See |ContainerLayer::PrerollChildren|.
+  bool enable_parallel_preroll = false;
+
+  // The CPUs that the workers of the VM, which decode images and run other
+  // background tasks, may run on, one bit per CPU. Keeps them off the cores
+  // of the UI and raster threads. Zero allows all CPUs.
+  uint64_t worker_cpu_affinity_mask = 0;
+
+  // Drops the nodes of semantics updates that haven't changed since they were
+  // last sent to the platform. See |SemanticsUpdateFilter|.
+  bool enable_semantics_update_filter = false;
+
   // All shells in the process share the same VM. The last shell to shutdown
   // should typically shut down the VM as well. However, applications depend on
   // the behavior of "warming-up" the VM by creating a shell that does not do
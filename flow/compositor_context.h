@@ -14,6 +14,7 @@
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
+#include "flutter/fml/task_runner.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
@@ -122,12 +123,23 @@ class CompositorContext {
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  // Lets large layer trees be prerolled in parallel on |task_runner|, or
+  // turns this off if it is null. See |PrerollContext::preroll_task_runner|.
+  void SetPrerollTaskRunner(std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+    preroll_task_runner_ = std::move(task_runner);
+  }
+
+  fml::BasicTaskRunner* preroll_task_runner() const {
+    return preroll_task_runner_.get();
+  }
+
  private:
   RasterCache raster_cache_;
   TextureRegistry texture_registry_;
   Counter frame_count_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
+  std::shared_ptr<fml::BasicTaskRunner> preroll_task_runner_;
 
   void BeginFrame(ScopedFrame& frame, bool enable_instrumentation);
 
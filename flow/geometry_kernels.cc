@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/geometry_kernels.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace flutter {
+
+static_assert(sizeof(SkRect) == 4 * sizeof(float),
+              "SkRect must be laid out as left, top, right, bottom");
+
+// The vector versions keep the rect in one register as (left, top, right,
+// bottom). |SkRect::join| takes std::min and std::max of the edges, i.e.
+// (b < a) ? b : a and (a < b) ? b : a, which the comparisons below reproduce
+// exactly for NaNs and zeros of either sign.
+
+#if defined(__SSE2__)
+
+void JoinRects(const SkRect rects[], size_t count, SkRect* bounds) {
+  __m128 result = _mm_loadu_ps(&bounds->fLeft);
+  for (size_t i = 0; i < count; i++) {
+    const __m128 rect = _mm_loadu_ps(&rects[i].fLeft);
+    // An empty rect has left >= right or top >= bottom, which compares the
+    // first two lanes with the last two.
+    const __m128 rect_rblt =
+        _mm_shuffle_ps(rect, rect, _MM_SHUFFLE(1, 0, 3, 2));
+    if (_mm_movemask_ps(_mm_cmpge_ps(rect, rect_rblt)) & 0x3) {
+      continue;
+    }
+    const __m128 result_rblt =
+        _mm_shuffle_ps(result, result, _MM_SHUFFLE(1, 0, 3, 2));
+    if (_mm_movemask_ps(_mm_cmpge_ps(result, result_rblt)) & 0x3) {
+      result = rect;
+      continue;
+    }
+    // _mm_min_ps(a, b) is a < b ? a : b, and _mm_max_ps(a, b) is a > b ? a : b.
+    const __m128 min = _mm_min_ps(rect, result);
+    const __m128 max = _mm_max_ps(rect, result);
+    result = _mm_shuffle_ps(min, max, _MM_SHUFFLE(3, 2, 1, 0));
+  }
+  _mm_storeu_ps(&bounds->fLeft, result);
+}
+
+#elif defined(__ARM_NEON)
+
+static inline bool IsEmpty(float32x4_t ltrb) {
+  const uint32x2_t ge = vget_low_u32(vcgeq_f32(ltrb, vextq_f32(ltrb, ltrb, 2)));
+  return (vget_lane_u32(ge, 0) | vget_lane_u32(ge, 1)) != 0;
+}
+
+void JoinRects(const SkRect rects[], size_t count, SkRect* bounds) {
+  float32x4_t result = vld1q_f32(&bounds->fLeft);
+  for (size_t i = 0; i < count; i++) {
+    const float32x4_t rect = vld1q_f32(&rects[i].fLeft);
+    if (IsEmpty(rect)) {
+      continue;
+    }
+    if (IsEmpty(result)) {
+      result = rect;
+      continue;
+    }
+    // vminq_f32 and vmaxq_f32 order -0 before +0, unlike std::min and
+    // std::max, so select with comparisons instead.
+    const float32x4_t min = vbslq_f32(vcltq_f32(rect, result), rect, result);
+    const float32x4_t max = vbslq_f32(vcgtq_f32(rect, result), rect, result);
+    result = vcombine_f32(vget_low_f32(min), vget_high_f32(max));
+  }
+  vst1q_f32(&bounds->fLeft, result);
+}
+
+#else
+
+void JoinRects(const SkRect rects[], size_t count, SkRect* bounds) {
+  for (size_t i = 0; i < count; i++) {
+    bounds->join(rects[i]);
+  }
+}
+
+#endif
+
+}  // namespace flutter
@@ -0,0 +1,22 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_GEOMETRY_KERNELS_H_
+#define FLUTTER_FLOW_GEOMETRY_KERNELS_H_
+
+#include <cstddef>
+
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+// Joins each of the |count| |rects| into |bounds|, in order, skipping the
+// empty ones. Uses SSE2 or NEON where available, with results that are bit
+// for bit those of calling |SkRect::join| for each rect, NaNs and signed zeros
+// included.
+void JoinRects(const SkRect rects[], size_t count, SkRect* bounds);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_GEOMETRY_KERNELS_H_
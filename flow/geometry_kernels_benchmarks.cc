@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/geometry_kernels.h"
+
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/matrix_decomposition.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+
+namespace flutter {
+
+namespace {
+
+// Returns |count| rects like the paint bounds of the children of a list, with
+// an empty one every so often.
+std::vector<SkRect> MakeRects(int64_t count) {
+  std::vector<SkRect> rects;
+  for (int64_t i = 0; i < count; i++) {
+    const float y = i * 48.0f;
+    rects.push_back(i % 8 == 7 ? SkRect::MakeEmpty()
+                               : SkRect::MakeXYWH(i % 3, y, 400.0f, 44.0f));
+  }
+  return rects;
+}
+
+}  // namespace
+
+static void BM_JoinRectsWithSkRect(benchmark::State& state) {
+  const std::vector<SkRect> rects = MakeRects(state.range(0));
+  while (state.KeepRunning()) {
+    SkRect bounds = SkRect::MakeEmpty();
+    for (const SkRect& rect : rects) {
+      bounds.join(rect);
+    }
+    benchmark::DoNotOptimize(bounds);
+  }
+}
+BENCHMARK(BM_JoinRectsWithSkRect)->Arg(16)->Arg(1024);
+
+static void BM_JoinRects(benchmark::State& state) {
+  const std::vector<SkRect> rects = MakeRects(state.range(0));
+  while (state.KeepRunning()) {
+    SkRect bounds = SkRect::MakeEmpty();
+    JoinRects(rects.data(), rects.size(), &bounds);
+    benchmark::DoNotOptimize(bounds);
+  }
+}
+BENCHMARK(BM_JoinRects)->Arg(16)->Arg(1024);
+
+// Checks the matrix of a scrolled and scaled picture, as the raster cache does
+// for every picture it prepares.
+static void BM_MatrixDecompositionIsValid(benchmark::State& state) {
+  SkMatrix matrix = SkMatrix::Scale(2.0f, 2.0f);
+  matrix.postTranslate(10.0f, -2000.5f);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(MatrixDecomposition(matrix).IsValid());
+  }
+}
+BENCHMARK(BM_MatrixDecompositionIsValid);
+
+static void BM_MatrixDecompositionIsDecomposable(benchmark::State& state) {
+  SkMatrix matrix = SkMatrix::Scale(2.0f, 2.0f);
+  matrix.postTranslate(10.0f, -2000.5f);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(MatrixDecomposition::IsDecomposable(matrix));
+  }
+}
+BENCHMARK(BM_MatrixDecompositionIsDecomposable);
+
+}  // namespace flutter
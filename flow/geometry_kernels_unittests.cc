@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/geometry_kernels.h"
+
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+bool BitwiseEqual(const SkRect& a, const SkRect& b) {
+  return std::memcmp(&a, &b, sizeof(SkRect)) == 0;
+}
+
+}  // namespace
+
+TEST(GeometryKernels, JoinRectsSkipsEmptyRects) {
+  const SkRect rects[] = {
+      SkRect::MakeLTRB(10, 10, 20, 20),
+      SkRect::MakeEmpty(),
+      SkRect::MakeLTRB(-5, 15, -5, 100),
+      SkRect::MakeLTRB(0, 0, 15, 15),
+  };
+  SkRect bounds = SkRect::MakeEmpty();
+  JoinRects(rects, 4, &bounds);
+  EXPECT_EQ(bounds, SkRect::MakeLTRB(0, 0, 20, 20));
+
+  bounds = SkRect::MakeLTRB(100, 100, 50, 50);
+  JoinRects(rects + 1, 2, &bounds);
+  EXPECT_EQ(bounds, SkRect::MakeLTRB(100, 100, 50, 50));
+}
+
+TEST(GeometryKernels, JoinRectsMatchesSkRectJoin) {
+  // Mostly small integers, so that edges often coincide, mixed with values
+  // that |std::min| and |std::max| are sensitive to the order of.
+  const float specials[] = {
+      0.0f,
+      -0.0f,
+      std::numeric_limits<float>::infinity(),
+      -std::numeric_limits<float>::infinity(),
+      std::numeric_limits<float>::quiet_NaN(),
+      std::numeric_limits<float>::denorm_min(),
+  };
+  std::mt19937 generator(42);
+  auto random_value = [&]() {
+    if (generator() % 4 == 0) {
+      return specials[generator() % std::size(specials)];
+    }
+    return static_cast<float>(static_cast<int>(generator() % 21) - 10);
+  };
+  auto random_rect = [&]() {
+    return SkRect::MakeLTRB(random_value(), random_value(), random_value(),
+                            random_value());
+  };
+
+  for (int i = 0; i < 10000; i++) {
+    std::vector<SkRect> rects(generator() % 10);
+    for (SkRect& rect : rects) {
+      rect = random_rect();
+    }
+    SkRect expected = random_rect();
+    SkRect bounds = expected;
+    for (const SkRect& rect : rects) {
+      expected.join(rect);
+    }
+    JoinRects(rects.data(), rects.size(), &bounds);
+    ASSERT_TRUE(BitwiseEqual(bounds, expected))
+        << i << ": " << bounds.x() << ", " << bounds.y() << ", "
+        << bounds.right() << ", " << bounds.bottom();
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
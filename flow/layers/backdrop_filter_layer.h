@@ -18,6 +18,9 @@ class BackdropFilterLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // |ContainerLayer|
+  bool Compile(CompiledLayerTreeBuilder* builder) override { return false; }
+
  private:
   sk_sp<SkImageFilter> filter_;
 
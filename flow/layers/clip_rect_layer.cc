@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/layers/clip_rect_layer.h"
+
+#include "flutter/flow/layers/compiled_layer_tree.h"
 #include "flutter/flow/paint_utils.h"
 
 namespace flutter {
@@ -31,6 +33,15 @@ void ClipRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   context->cull_rect = previous_cull_rect;
 }
 
+bool ClipRectLayer::Compile(CompiledLayerTreeBuilder* builder) {
+  builder->PushClipRect(this, clip_rect_, clip_behavior_);
+  if (!CompileChildren(builder)) {
+    return false;
+  }
+  builder->Pop();
+  return true;
+}
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
 
 void ClipRectLayer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
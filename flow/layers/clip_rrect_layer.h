@@ -17,6 +17,9 @@ class ClipRRectLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // |ContainerLayer|
+  bool Compile(CompiledLayerTreeBuilder* builder) override { return false; }
+
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
@@ -18,6 +18,9 @@ class ColorFilterLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // |ContainerLayer|
+  bool Compile(CompiledLayerTreeBuilder* builder) override { return false; }
+
  private:
   sk_sp<SkColorFilter> filter_;
 
@@ -0,0 +1,253 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/compiled_layer_tree.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/flow/paint_utils.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+std::unique_ptr<CompiledLayerTree> CompiledLayerTree::Compile(Layer* root) {
+  TRACE_EVENT0("flutter", "CompiledLayerTree::Compile");
+  if (root == nullptr) {
+    return nullptr;
+  }
+  CompiledLayerTreeBuilder builder;
+  if (!root->Compile(&builder)) {
+    return nullptr;
+  }
+  return builder.Build();
+}
+
+CompiledLayerTree::CompiledLayerTree(std::vector<Op> ops, size_t max_depth)
+    : ops_(std::move(ops)), max_depth_(max_depth) {}
+
+void CompiledLayerTree::Preroll(PrerollContext* context,
+                                const SkMatrix& matrix) const {
+  TRACE_EVENT0("flutter", "CompiledLayerTree::Preroll");
+
+  RasterCache* cache = context->raster_cache;
+  if (cache == nullptr) {
+    for (const Op& op : ops_) {
+      op.layer->set_paint_bounds(op.paint_bounds);
+    }
+    return;
+  }
+
+  // The matrices of the transform ops the traversal is in, each paired with
+  // the end of its subtree. They are concatenated one transform at a time,
+  // like the canvas does in |Paint|, so that the pictures are prepared with
+  // the exact matrix they are drawn with.
+  std::vector<std::pair<uint32_t, SkMatrix>> transforms;
+  transforms.reserve(max_depth_);
+
+  const uint32_t count = ops_.size();
+  for (uint32_t index = 0; index < count; index++) {
+    const Op& op = ops_[index];
+    op.layer->set_paint_bounds(op.paint_bounds);
+    while (!transforms.empty() && transforms.back().first == index) {
+      transforms.pop_back();
+    }
+    const SkMatrix& parent_matrix =
+        transforms.empty() ? matrix : transforms.back().second;
+
+    if (op.type == Op::Type::kTransform) {
+      transforms.emplace_back(op.end,
+                              SkMatrix::Concat(parent_matrix, op.matrix));
+    } else if (op.type == Op::Type::kPicture) {
+      SkMatrix ctm = parent_matrix;
+      ctm.preTranslate(op.rect.x(), op.rect.y());
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+      ctm = RasterCache::GetIntegralTransCTM(ctm);
+#endif
+      cache->Prepare(context->gr_context, op.picture, ctm,
+                     context->dst_color_space, op.is_complex, op.will_change,
+                     op.fingerprint);
+    }
+  }
+}
+
+void CompiledLayerTree::Paint(Layer::PaintContext& context) const {
+  TRACE_EVENT0("flutter", "CompiledLayerTree::Paint");
+
+  // The transform and clip ops whose canvas state has to be restored once the
+  // traversal moves past the end of their subtree.
+  std::vector<uint32_t> open_ops;
+  open_ops.reserve(max_depth_);
+
+  const uint32_t count = ops_.size();
+  uint32_t index = 0;
+  while (true) {
+    while (!open_ops.empty() && ops_[open_ops.back()].end == index) {
+      RestoreAfterSubtree(context, ops_[open_ops.back()]);
+      open_ops.pop_back();
+    }
+    if (index >= count) {
+      break;
+    }
+
+    const Op& op = ops_[index];
+    // Mirrors Layer::needs_painting, but skips the whole subtree at once.
+    if (op.paint_bounds.isEmpty() ||
+        context.leaf_nodes_canvas->quickReject(op.paint_bounds)) {
+      index = op.end;
+      continue;
+    }
+
+    switch (op.type) {
+      case Op::Type::kContainer:
+        break;
+      case Op::Type::kTransform:
+        context.internal_nodes_canvas->save();
+        context.internal_nodes_canvas->concat(op.matrix);
+        open_ops.push_back(index);
+        break;
+      case Op::Type::kClipRect:
+        context.internal_nodes_canvas->save();
+        context.internal_nodes_canvas->clipRect(
+            op.rect, op.clip_behavior != Clip::hardEdge);
+        if (op.clip_behavior == Clip::antiAliasWithSaveLayer) {
+          context.internal_nodes_canvas->saveLayer(op.rect, nullptr);
+        }
+        open_ops.push_back(index);
+        break;
+      case Op::Type::kPicture:
+        PaintPicture(context, op);
+        break;
+    }
+    index++;
+  }
+}
+
+void CompiledLayerTree::RestoreAfterSubtree(Layer::PaintContext& context,
+                                            const Op& op) const {
+  if (op.type == Op::Type::kClipRect &&
+      op.clip_behavior == Clip::antiAliasWithSaveLayer) {
+    context.internal_nodes_canvas->restore();
+    if (context.checkerboard_offscreen_layers) {
+      DrawCheckerboard(context.internal_nodes_canvas, op.rect);
+    }
+  }
+  context.internal_nodes_canvas->restore();
+}
+
+void CompiledLayerTree::PaintPicture(Layer::PaintContext& context,
+                                     const Op& op) const {
+  SkAutoCanvasRestore save(context.leaf_nodes_canvas, true);
+  context.leaf_nodes_canvas->translate(op.rect.x(), op.rect.y());
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  context.leaf_nodes_canvas->setMatrix(RasterCache::GetIntegralTransCTM(
+      context.leaf_nodes_canvas->getTotalMatrix()));
+#endif
+
+  if (context.raster_cache &&
+      context.raster_cache->Draw(*op.picture, *context.leaf_nodes_canvas,
+                                 op.fingerprint)) {
+    TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
+    return;
+  }
+  op.picture->playback(context.leaf_nodes_canvas);
+}
+
+CompiledLayerTreeBuilder::CompiledLayerTreeBuilder() = default;
+
+CompiledLayerTreeBuilder::~CompiledLayerTreeBuilder() = default;
+
+void CompiledLayerTreeBuilder::Push(Op op) {
+  stack_.push_back({static_cast<uint32_t>(ops_.size()), SkRect::MakeEmpty()});
+  max_depth_ = std::max(max_depth_, stack_.size());
+  ops_.push_back(op);
+}
+
+void CompiledLayerTreeBuilder::PushContainer(Layer* layer) {
+  Op op;
+  op.type = Op::Type::kContainer;
+  op.layer = layer;
+  Push(op);
+}
+
+void CompiledLayerTreeBuilder::PushTransform(Layer* layer,
+                                             const SkMatrix& transform) {
+  Op op;
+  op.type = Op::Type::kTransform;
+  op.layer = layer;
+  op.matrix = transform;
+  Push(op);
+}
+
+void CompiledLayerTreeBuilder::PushClipRect(Layer* layer,
+                                            const SkRect& clip_rect,
+                                            Clip clip_behavior) {
+  Op op;
+  op.type = Op::Type::kClipRect;
+  op.layer = layer;
+  op.clip_behavior = clip_behavior;
+  op.rect = clip_rect;
+  Push(op);
+}
+
+void CompiledLayerTreeBuilder::Pop() {
+  FML_DCHECK(!stack_.empty());
+  Frame frame = stack_.back();
+  stack_.pop_back();
+
+  Op& op = ops_[frame.index];
+  op.end = ops_.size();
+  SkRect bounds = frame.child_paint_bounds;
+  switch (op.type) {
+    case Op::Type::kContainer:
+      break;
+    case Op::Type::kTransform:
+      op.matrix.mapRect(&bounds);
+      break;
+    case Op::Type::kClipRect:
+      if (!bounds.intersect(op.rect)) {
+        bounds.setEmpty();
+      }
+      break;
+    case Op::Type::kPicture:
+      FML_DCHECK(false);
+      break;
+  }
+  op.paint_bounds = bounds;
+  JoinIntoParent(bounds);
+}
+
+void CompiledLayerTreeBuilder::AddPicture(Layer* layer,
+                                          const SkPoint& offset,
+                                          SkPicture* picture,
+                                          bool is_complex,
+                                          bool will_change,
+                                          PictureFingerprint fingerprint) {
+  Op op;
+  op.type = Op::Type::kPicture;
+  op.layer = layer;
+  op.picture = picture;
+  op.fingerprint = fingerprint;
+  op.is_complex = is_complex;
+  op.will_change = will_change;
+  op.rect = SkRect::MakeXYWH(offset.x(), offset.y(), 0, 0);
+  op.paint_bounds = picture->cullRect().makeOffset(offset.x(), offset.y());
+  op.end = ops_.size() + 1;
+  ops_.push_back(op);
+  JoinIntoParent(op.paint_bounds);
+}
+
+void CompiledLayerTreeBuilder::JoinIntoParent(const SkRect& paint_bounds) {
+  if (!stack_.empty()) {
+    stack_.back().child_paint_bounds.join(paint_bounds);
+  }
+}
+
+std::unique_ptr<CompiledLayerTree> CompiledLayerTreeBuilder::Build() {
+  FML_DCHECK(stack_.empty());
+  return std::unique_ptr<CompiledLayerTree>(
+      new CompiledLayerTree(std::move(ops_), max_depth_));
+}
+
+}  // namespace flutter
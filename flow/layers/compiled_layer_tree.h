@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_COMPILED_LAYER_TREE_H_
+#define FLUTTER_FLOW_LAYERS_COMPILED_LAYER_TREE_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/flow/layers/layer.h"
+#include "flutter/flow/picture_fingerprint.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A flattened form of a layer tree that can be prerolled and painted without
+/// walking the layers.
+///
+/// The layers of the tree are stored in a single contiguous array in paint
+/// order. Each entry records the index just past its subtree so that culled
+/// subtrees are skipped with a single jump. The paint bounds of every entry
+/// are computed once when the tree is compiled, since they don't depend on
+/// the state of the rasterizer.
+///
+/// Only trees made of ContainerLayers, TransformLayers, ClipRectLayers and
+/// PictureLayers can be compiled. These make up the bulk of large scenes.
+/// Layers that interact with the raster cache, the view embedder or the
+/// destination surface opt out by not overriding Layer::Compile, and any such
+/// layer causes the whole tree to be rendered through the layers instead.
+///
+class CompiledLayerTree {
+ public:
+  // Returns nullptr if |root| or any layer below it cannot be compiled.
+  static std::unique_ptr<CompiledLayerTree> Compile(Layer* root);
+
+  // Equivalent to calling |Layer::Preroll| on the root layer of the tree. The
+  // paint bounds of the original layers are updated as well so that they stay
+  // valid for anyone walking the layers.
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) const;
+
+  // Equivalent to calling |Layer::Paint| on the root layer of the tree if it
+  // |needs_painting|.
+  void Paint(Layer::PaintContext& context) const;
+
+  size_t op_count() const { return ops_.size(); }
+
+  const SkRect& paint_bounds() const {
+    return ops_.empty() ? kEmptyRect : ops_[0].paint_bounds;
+  }
+
+ private:
+  friend class CompiledLayerTreeBuilder;
+
+  static constexpr SkRect kEmptyRect = SkRect::MakeEmpty();
+
+  struct Op {
+    enum class Type : uint8_t { kContainer, kTransform, kClipRect, kPicture };
+
+    Type type;
+    Clip clip_behavior = Clip::none;
+    bool is_complex = false;
+    bool will_change = false;
+
+    // The index one past the last op of the subtree rooted at this op.
+    uint32_t end = 0;
+
+    Layer* layer = nullptr;
+    SkPicture* picture = nullptr;
+    PictureFingerprint fingerprint = kNoPictureFingerprint;
+
+    // For kTransform, the transform of the layer.
+    SkMatrix matrix;
+
+    // For kClipRect, the clip rect. For kPicture, the offset is stored in
+    // the top left corner.
+    SkRect rect = SkRect::MakeEmpty();
+
+    SkRect paint_bounds = SkRect::MakeEmpty();
+  };
+
+  CompiledLayerTree(std::vector<Op> ops, size_t max_depth);
+
+  void PaintPicture(Layer::PaintContext& context, const Op& op) const;
+
+  void RestoreAfterSubtree(Layer::PaintContext& context, const Op& op) const;
+
+  const std::vector<Op> ops_;
+  const size_t max_depth_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CompiledLayerTree);
+};
+
+//------------------------------------------------------------------------------
+/// Collects the ops of a CompiledLayerTree from the |Layer::Compile| calls of
+/// the layers of a tree.
+///
+class CompiledLayerTreeBuilder {
+ public:
+  CompiledLayerTreeBuilder();
+
+  ~CompiledLayerTreeBuilder();
+
+  // Each Push must be balanced with a Pop once the children of |layer| have
+  // been compiled.
+  void PushContainer(Layer* layer);
+
+  void PushTransform(Layer* layer, const SkMatrix& transform);
+
+  void PushClipRect(Layer* layer, const SkRect& clip_rect, Clip clip_behavior);
+
+  void Pop();
+
+  void AddPicture(Layer* layer,
+                  const SkPoint& offset,
+                  SkPicture* picture,
+                  bool is_complex,
+                  bool will_change,
+                  PictureFingerprint fingerprint);
+
+  std::unique_ptr<CompiledLayerTree> Build();
+
+ private:
+  using Op = CompiledLayerTree::Op;
+
+  struct Frame {
+    uint32_t index;
+    SkRect child_paint_bounds;
+  };
+
+  std::vector<Op> ops_;
+  std::vector<Frame> stack_;
+  size_t max_depth_ = 0;
+
+  void Push(Op op);
+
+  void JoinIntoParent(const SkRect& paint_bounds);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CompiledLayerTreeBuilder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_COMPILED_LAYER_TREE_H_
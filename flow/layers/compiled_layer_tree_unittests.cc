@@ -0,0 +1,236 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/flow/layers/compiled_layer_tree.h"
+
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/testing/skia_gpu_object_layer_test.h"
+#include "flutter/fml/macros.h"
+#include "flutter/testing/mock_canvas.h"
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace flutter {
+namespace testing {
+
+class CompiledLayerTreeTest : public SkiaGPUObjectLayerTest {
+ public:
+  std::shared_ptr<PictureLayer> MakePictureLayer(const SkPoint& offset,
+                                                 const SkRect& bounds) {
+    return std::make_shared<PictureLayer>(
+        offset,
+        SkiaGPUObject(SkPicture::MakePlaceholder(bounds), unref_queue()),
+        false, false);
+  }
+
+  // Builds a tree that exercises every kind of op, including a subtree that
+  // is entirely outside of the canvas.
+  std::shared_ptr<ContainerLayer> MakeTree() {
+    auto root = std::make_shared<ContainerLayer>();
+    auto transform = std::make_shared<TransformLayer>(
+        SkMatrix::Translate(10.0f, 20.0f));
+    auto clip = std::make_shared<ClipRectLayer>(
+        SkRect::MakeXYWH(0.0f, 0.0f, 50.0f, 50.0f), Clip::hardEdge);
+    auto aa_clip = std::make_shared<ClipRectLayer>(
+        SkRect::MakeXYWH(5.0f, 5.0f, 30.0f, 30.0f),
+        Clip::antiAliasWithSaveLayer);
+    auto offscreen = std::make_shared<TransformLayer>(
+        SkMatrix::Translate(10000.0f, 10000.0f));
+
+    aa_clip->Add(MakePictureLayer(SkPoint::Make(1.5f, 2.5f),
+                                  SkRect::MakeWH(20.0f, 20.0f)));
+    clip->Add(MakePictureLayer(SkPoint::Make(0.0f, 0.0f),
+                               SkRect::MakeWH(100.0f, 100.0f)));
+    clip->Add(aa_clip);
+    transform->Add(clip);
+    offscreen->Add(MakePictureLayer(SkPoint::Make(0.0f, 0.0f),
+                                    SkRect::MakeWH(10.0f, 10.0f)));
+    root->Add(transform);
+    root->Add(offscreen);
+    root->Add(MakePictureLayer(SkPoint::Make(-3.0f, 4.0f),
+                               SkRect::MakeWH(5.0f, 5.0f)));
+    return root;
+  }
+
+  // Returns a copy of |paint_context()| that paints into |canvas| instead.
+  Layer::PaintContext PaintContextFor(MockCanvas& canvas) {
+    Layer::PaintContext& context = paint_context();
+    return {
+        canvas.internal_canvas(),
+        &canvas,
+        context.gr_context,
+        context.view_embedder,
+        context.raster_time,
+        context.ui_time,
+        context.texture_registry,
+        context.raster_cache,
+        context.checkerboard_offscreen_layers,
+        context.frame_device_pixel_ratio,
+    };
+  }
+};
+
+TEST_F(CompiledLayerTreeTest, NullRootIsNotCompiled) {
+  EXPECT_EQ(CompiledLayerTree::Compile(nullptr), nullptr);
+}
+
+TEST_F(CompiledLayerTreeTest, EmptyContainer) {
+  auto root = std::make_shared<ContainerLayer>();
+  auto compiled = CompiledLayerTree::Compile(root.get());
+  ASSERT_NE(compiled, nullptr);
+  EXPECT_EQ(compiled->op_count(), 1u);
+
+  compiled->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(compiled->paint_bounds(), SkRect::MakeEmpty());
+  EXPECT_EQ(root->paint_bounds(), SkRect::MakeEmpty());
+
+  compiled->Paint(paint_context());
+  EXPECT_TRUE(mock_canvas().draw_calls().empty());
+}
+
+TEST_F(CompiledLayerTreeTest, UnsupportedLayersAreNotCompiled) {
+  auto root = std::make_shared<ContainerLayer>();
+  auto opacity = std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  opacity->Add(MakePictureLayer(SkPoint::Make(0.0f, 0.0f),
+                                SkRect::MakeWH(10.0f, 10.0f)));
+  root->Add(opacity);
+  EXPECT_EQ(CompiledLayerTree::Compile(root.get()), nullptr);
+  EXPECT_EQ(CompiledLayerTree::Compile(opacity.get()), nullptr);
+}
+
+TEST_F(CompiledLayerTreeTest, PictureWithoutSkPictureIsNotCompiled) {
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(std::make_shared<PictureLayer>(
+      SkPoint::Make(0, 0), SkiaGPUObject<SkPicture>(), false, false));
+  EXPECT_EQ(CompiledLayerTree::Compile(root.get()), nullptr);
+}
+
+TEST_F(CompiledLayerTreeTest, PrerollMatchesLayers) {
+  auto root = MakeTree();
+  root->Preroll(preroll_context(), SkMatrix());
+  const SkRect expected_bounds = root->paint_bounds();
+  ASSERT_FALSE(expected_bounds.isEmpty());
+
+  auto compiled_root = MakeTree();
+  auto compiled = CompiledLayerTree::Compile(compiled_root.get());
+  ASSERT_NE(compiled, nullptr);
+  EXPECT_EQ(compiled->op_count(), 9u);
+  compiled->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(compiled->paint_bounds(), expected_bounds);
+  EXPECT_EQ(compiled_root->paint_bounds(), expected_bounds);
+
+  const auto& layers = root->layers();
+  const auto& compiled_layers = compiled_root->layers();
+  ASSERT_EQ(layers.size(), compiled_layers.size());
+  for (size_t i = 0; i < layers.size(); i++) {
+    EXPECT_EQ(compiled_layers[i]->paint_bounds(), layers[i]->paint_bounds());
+  }
+}
+
+TEST_F(CompiledLayerTreeTest, PaintMatchesLayers) {
+  auto root = MakeTree();
+  root->Preroll(preroll_context(), SkMatrix());
+  MockCanvas layer_canvas;
+  Layer::PaintContext layer_context = PaintContextFor(layer_canvas);
+  root->Paint(layer_context);
+  ASSERT_FALSE(layer_canvas.draw_calls().empty());
+
+  auto compiled_root = MakeTree();
+  auto compiled = CompiledLayerTree::Compile(compiled_root.get());
+  ASSERT_NE(compiled, nullptr);
+  compiled->Preroll(preroll_context(), SkMatrix());
+  MockCanvas compiled_canvas;
+  Layer::PaintContext compiled_context = PaintContextFor(compiled_canvas);
+  compiled->Paint(compiled_context);
+
+  EXPECT_EQ(compiled_canvas.draw_calls(), layer_canvas.draw_calls());
+}
+
+TEST_F(CompiledLayerTreeTest, CulledSubtreeIsSkipped) {
+  auto root = std::make_shared<ContainerLayer>();
+  auto offscreen = std::make_shared<TransformLayer>(
+      SkMatrix::Translate(10000.0f, 10000.0f));
+  offscreen->Add(MakePictureLayer(SkPoint::Make(0.0f, 0.0f),
+                                  SkRect::MakeWH(10.0f, 10.0f)));
+  root->Add(offscreen);
+
+  auto compiled = CompiledLayerTree::Compile(root.get());
+  ASSERT_NE(compiled, nullptr);
+  compiled->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(offscreen->paint_bounds(),
+            SkRect::MakeXYWH(10000.0f, 10000.0f, 10.0f, 10.0f));
+
+  compiled->Paint(paint_context());
+  EXPECT_TRUE(mock_canvas().draw_calls().empty());
+}
+
+TEST_F(CompiledLayerTreeTest, PrerollPreparesPicturesInRasterCache) {
+  use_mock_raster_cache();
+  const SkRect picture_bounds = SkRect::MakeWH(20.0f, 20.0f);
+  auto root = std::make_shared<ContainerLayer>();
+  auto transform = std::make_shared<TransformLayer>(SkMatrix::Scale(2, 2));
+  transform->Add(std::make_shared<PictureLayer>(
+      SkPoint::Make(0, 0),
+      SkiaGPUObject(SkPicture::MakePlaceholder(picture_bounds), unref_queue()),
+      true, false));
+  root->Add(transform);
+  root->Add(std::make_shared<PictureLayer>(
+      SkPoint::Make(5, 5),
+      SkiaGPUObject(SkPicture::MakePlaceholder(picture_bounds), unref_queue()),
+      true, false));
+
+  auto compiled = CompiledLayerTree::Compile(root.get());
+  ASSERT_NE(compiled, nullptr);
+  EXPECT_EQ(raster_cache()->GetPictureCachedEntriesCount(), 0u);
+  compiled->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(raster_cache()->GetPictureCachedEntriesCount(), 2u);
+}
+
+TEST_F(CompiledLayerTreeTest, PicturesAreCachedUnderNonIdentityRoot) {
+  use_mock_raster_cache();
+  // Nested rotations, whose product depends on the order they are
+  // concatenated in.
+  SkMatrix outer = SkMatrix::RotateDeg(17.0f);
+  outer.preScale(0.7f, 0.7f);
+  SkMatrix inner = SkMatrix::RotateDeg(41.0f);
+  inner.preScale(1.9f, 1.9f);
+  auto root = std::make_shared<ContainerLayer>();
+  auto outer_layer = std::make_shared<TransformLayer>(outer);
+  auto inner_layer = std::make_shared<TransformLayer>(inner);
+  inner_layer->Add(std::make_shared<PictureLayer>(
+      SkPoint::Make(3.0f, 4.0f),
+      SkiaGPUObject(SkPicture::MakePlaceholder(SkRect::MakeWH(8.0f, 8.0f)),
+                    unref_queue()),
+      true, false));
+  outer_layer->Add(inner_layer);
+  root->Add(outer_layer);
+
+  auto compiled = CompiledLayerTree::Compile(root.get());
+  ASSERT_NE(compiled, nullptr);
+  SkMatrix root_matrix = SkMatrix::RotateDeg(30.0f);
+  root_matrix.preScale(1.3f, 1.3f);
+  root_matrix.postTranslate(20.0f, 10.0f);
+
+  // The picture is only rasterized once it has been drawn often enough with
+  // the matrix it is prepared with.
+  for (int frame = 0; frame < 4; frame++) {
+    compiled->Preroll(preroll_context(), root_matrix);
+    MockCanvas canvas;
+    canvas.setMatrix(root_matrix);
+    Layer::PaintContext context = PaintContextFor(canvas);
+    compiled->Paint(context);
+    raster_cache()->SweepAfterFrame();
+  }
+  compiled->Preroll(preroll_context(), root_matrix);
+  EXPECT_EQ(raster_cache()->GetPictureCachedEntriesCount(), 1u);
+  EXPECT_GT(raster_cache()->EstimatePictureCacheByteSize(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,14 +4,134 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <optional>
 
+#include "flutter/flow/geometry_kernels.h"
+#include "flutter/flow/layers/compiled_layer_tree.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
 namespace flutter {
 
+namespace {
+
+// Children are only prerolled in parallel if those that can add up to at
+// least this many layers, so that the work outweighs the cost of the tasks.
+constexpr size_t kMinConcurrentPrerollWeight = 256;
+
+// The most tasks posted for the children of one container. The raster thread
+// prerolls children as well.
+constexpr size_t kMaxConcurrentPrerollTasks = 7;
+
+// Joins the paint bounds of children in batches through |JoinRects|, so that
+// a container doesn't need to allocate to use the kernel.
+class ChildBoundsAccumulator {
+ public:
+  explicit ChildBoundsAccumulator(SkRect* bounds) : bounds_(bounds) {}
+
+  ~ChildBoundsAccumulator() { Flush(); }
+
+  void Add(const SkRect& rect) {
+    if (count_ == kBufferSize) {
+      Flush();
+    }
+    buffer_[count_++] = rect;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 16;
+
+  void Flush() {
+    JoinRects(buffer_, count_, bounds_);
+    count_ = 0;
+  }
+
+  SkRect* bounds_;
+  SkRect buffer_[kBufferSize];
+  size_t count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ChildBoundsAccumulator);
+};
+
+// A child prerolled on its own, and its effects on the context.
+struct ChildPreroll {
+  Layer* layer = nullptr;
+  bool is_concurrent = false;
+  RasterCache::PrepareRecording prepares;
+  bool has_platform_view = false;
+  bool surface_needs_readback = false;
+  bool has_volatile_preroll = false;
+};
+
+// Prerolls |child| with a copy of |parent| that records the raster cache
+// calls instead of making them, so that it can run on any thread as long as
+// the subtree doesn't embed platform views. The containers in the subtree may
+// preroll their own children in parallel if |preroll_task_runner| is set.
+void PrerollChild(const PrerollContext& parent,
+                  const SkMatrix& matrix,
+                  fml::BasicTaskRunner* preroll_task_runner,
+                  ChildPreroll* child) {
+  MutatorsStack mutators_stack = parent.mutators_stack;
+  PrerollContext context = {
+      parent.raster_cache,
+      parent.gr_context,
+      parent.view_embedder,
+      mutators_stack,
+      parent.dst_color_space,
+      parent.cull_rect,
+      false,
+      parent.raster_time,
+      parent.ui_time,
+      parent.texture_registry,
+      parent.checkerboard_offscreen_layers,
+      parent.frame_device_pixel_ratio,
+  };
+  context.preroll_task_runner = preroll_task_runner;
+  if (parent.raster_cache) {
+    context.deferred_prepares = &child->prepares;
+  }
+  child->layer->PrerollOrReuse(&context, matrix);
+  child->has_platform_view = context.has_platform_view;
+  child->surface_needs_readback = context.surface_needs_readback;
+  child->has_volatile_preroll = context.has_volatile_preroll;
+}
+
+// The children that may be prerolled by any thread. Tasks that start after
+// all of them have been claimed return without touching anything else, so
+// they may safely run after the preroll is over.
+struct ConcurrentPrerolls {
+  ConcurrentPrerolls(const PrerollContext* context,
+                     const SkMatrix* matrix,
+                     std::vector<ChildPreroll*> children)
+      : context(context),
+        matrix(matrix),
+        children(std::move(children)),
+        latch(this->children.size()) {}
+
+  void Run() {
+    size_t index;
+    while ((index = next.fetch_add(1)) < children.size()) {
+      PrerollChild(*context, *matrix, nullptr, children[index]);
+      latch.CountDown();
+    }
+  }
+
+  const PrerollContext* context;
+  const SkMatrix* matrix;
+  const std::vector<ChildPreroll*> children;
+  std::atomic<size_t> next{0};
+  fml::CountDownLatch latch;
+};
+
+}  // namespace
+
 ContainerLayer::ContainerLayer() {}
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.emplace_back(std::move(layer));
+  concurrent_preroll_weight_.reset();
 }
 
 void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
@@ -28,6 +148,15 @@ void ContainerLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+bool ContainerLayer::Compile(CompiledLayerTreeBuilder* builder) {
+  builder->PushContainer(this);
+  if (!CompileChildren(builder)) {
+    return false;
+  }
+  builder->Pop();
+  return true;
+}
+
 void ContainerLayer::PrerollChildren(PrerollContext* context,
                                      const SkMatrix& child_matrix,
                                      SkRect* child_paint_bounds) {
@@ -42,19 +171,28 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   // Platform views have no children, so context->has_platform_view should
   // always be false.
   FML_DCHECK(!context->has_platform_view);
+#if !defined(LEGACY_FUCHSIA_EMBEDDER)
+  // Fuchsia system compositing depends on the order in which the children are
+  // visited.
+  if (context->preroll_task_runner && ShouldPrerollChildrenConcurrently()) {
+    PrerollChildrenConcurrently(context, child_matrix, child_paint_bounds);
+    return;
+  }
+#endif
   bool child_has_platform_view = false;
+  ChildBoundsAccumulator bounds(child_paint_bounds);
   for (auto& layer : layers_) {
     // Reset context->has_platform_view to false so that layers aren't treated
     // as if they have a platform view based on one being previously found in a
     // sibling tree.
     context->has_platform_view = false;
 
-    layer->Preroll(context, child_matrix);
+    layer->PrerollOrReuse(context, child_matrix);
 
     if (layer->needs_system_composite()) {
       set_needs_system_composite(true);
     }
-    child_paint_bounds->join(layer->paint_bounds());
+    bounds.Add(layer->paint_bounds());
 
     child_has_platform_view =
         child_has_platform_view || context->has_platform_view;
@@ -71,6 +209,79 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
 #endif
 }
 
+bool ContainerLayer::ShouldPrerollChildrenConcurrently() {
+  if (layers_.size() < 2) {
+    return false;
+  }
+  size_t concurrent_children = 0;
+  size_t concurrent_weight = 0;
+  for (auto& layer : layers_) {
+    const size_t weight = layer->ConcurrentPrerollWeight();
+    if (weight > 0) {
+      concurrent_children++;
+      concurrent_weight += weight;
+    }
+  }
+  return concurrent_children >= 2 &&
+         concurrent_weight >= kMinConcurrentPrerollWeight;
+}
+
+void ContainerLayer::PrerollChildrenConcurrently(PrerollContext* context,
+                                                 const SkMatrix& child_matrix,
+                                                 SkRect* child_paint_bounds) {
+  TRACE_EVENT0("flutter", "ContainerLayer::PrerollChildrenConcurrently");
+
+  std::vector<ChildPreroll> children(layers_.size());
+  std::vector<ChildPreroll*> concurrent_children;
+  for (size_t i = 0; i < layers_.size(); i++) {
+    children[i].layer = layers_[i].get();
+    children[i].is_concurrent = layers_[i]->ConcurrentPrerollWeight() > 0;
+    if (children[i].is_concurrent) {
+      concurrent_children.push_back(&children[i]);
+    }
+  }
+
+  auto prerolls = std::make_shared<ConcurrentPrerolls>(
+      context, &child_matrix, std::move(concurrent_children));
+  const size_t task_count =
+      std::min(prerolls->children.size() - 1, kMaxConcurrentPrerollTasks);
+  for (size_t i = 0; i < task_count; i++) {
+    context->preroll_task_runner->PostTask([prerolls]() { prerolls->Run(); });
+  }
+
+  // The children that have to stay on this thread go first, while the tasks
+  // get started. Their own subtrees may still be split further.
+  for (ChildPreroll& child : children) {
+    if (!child.is_concurrent) {
+      PrerollChild(*context, child_matrix, context->preroll_task_runner,
+                   &child);
+    }
+  }
+  prerolls->Run();
+  prerolls->latch.Wait();
+
+  // Apply the effects of the children in order, as |PrerollChildren| would
+  // have. The raster cache admits entries in the order they are prepared.
+  bool child_has_platform_view = false;
+  ChildBoundsAccumulator bounds(child_paint_bounds);
+  for (const ChildPreroll& child : children) {
+    if (context->raster_cache) {
+      context->raster_cache->ReplayPrepares(context, child.prepares);
+    }
+    if (child.layer->needs_system_composite()) {
+      set_needs_system_composite(true);
+    }
+    bounds.Add(child.layer->paint_bounds());
+    child_has_platform_view =
+        child_has_platform_view || child.has_platform_view;
+    context->surface_needs_readback =
+        context->surface_needs_readback || child.surface_needs_readback;
+    context->has_volatile_preroll =
+        context->has_volatile_preroll || child.has_volatile_preroll;
+  }
+  context->has_platform_view = child_has_platform_view;
+}
+
 void ContainerLayer::PaintChildren(PaintContext& context) const {
   // We can no longer call FML_DCHECK here on the needs_painting(context)
   // condition as that test is only valid for the PaintContext that
@@ -87,6 +298,31 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   }
 }
 
+size_t ContainerLayer::ConcurrentPrerollWeight() {
+  if (!concurrent_preroll_weight_) {
+    size_t weight = 1;
+    for (auto& layer : layers_) {
+      const size_t child_weight = layer->ConcurrentPrerollWeight();
+      if (child_weight == 0) {
+        weight = 0;
+        break;
+      }
+      weight += child_weight;
+    }
+    concurrent_preroll_weight_ = weight;
+  }
+  return *concurrent_preroll_weight_;
+}
+
+bool ContainerLayer::CompileChildren(CompiledLayerTreeBuilder* builder) {
+  for (auto& layer : layers_) {
+    if (!layer->Compile(builder)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void ContainerLayer::TryToPrepareRasterCache(PrerollContext* context,
                                              Layer* layer,
                                              const SkMatrix& matrix) {
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 
+#include <optional>
 #include <vector>
 
 #include "flutter/flow/layers/layer.h"
@@ -19,6 +20,11 @@ class ContainerLayer : public Layer {
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
+
+  // Subclasses that do more than paint their children must override this to
+  // either compile themselves or return false.
+  bool Compile(CompiledLayerTreeBuilder* builder) override;
+  size_t ConcurrentPrerollWeight() override;
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void CheckForChildLayerBelow(PrerollContext* context) override;
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
@@ -27,10 +33,16 @@ class ContainerLayer : public Layer {
   const std::vector<std::shared_ptr<Layer>>& layers() const { return layers_; }
 
  protected:
+  // Prerolls the children in order. If |context->preroll_task_runner| is set
+  // and enough of the children can be prerolled off the raster thread, they
+  // are prerolled in parallel instead. Either way the children's effects on
+  // |context| and on the raster cache are applied in order, so the results
+  // are the same.
   void PrerollChildren(PrerollContext* context,
                        const SkMatrix& child_matrix,
                        SkRect* child_paint_bounds);
   void PaintChildren(PaintContext& context) const;
+  bool CompileChildren(CompiledLayerTreeBuilder* builder);
 
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void UpdateSceneChildren(std::shared_ptr<SceneUpdateContext> context);
@@ -51,7 +63,14 @@ class ContainerLayer : public Layer {
                                       const SkMatrix& matrix);
 
  private:
+  bool ShouldPrerollChildrenConcurrently();
+  void PrerollChildrenConcurrently(PrerollContext* context,
+                                   const SkMatrix& child_matrix,
+                                   SkRect* child_paint_bounds);
+
   std::vector<std::shared_ptr<Layer>> layers_;
+  // Computed on first use, see |ConcurrentPrerollWeight|.
+  std::optional<size_t> concurrent_preroll_weight_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
@@ -103,6 +122,9 @@ class MergedContainerLayer : public ContainerLayer {
 
   void Add(std::shared_ptr<Layer> layer) override;
 
+  // |ContainerLayer|
+  bool Compile(CompiledLayerTreeBuilder* builder) override { return false; }
+
  protected:
   /**
    * @brief Returns the ContainerLayer used to hold all of the children of the
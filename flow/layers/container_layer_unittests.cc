@@ -4,8 +4,15 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <atomic>
+#include <vector>
+
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 
@@ -268,5 +275,229 @@ TEST_F(ContainerLayerTest, MergedMultipleChildren) {
                                                child_path2, child_paint2}}}));
 }
 
+#if !defined(LEGACY_FUCHSIA_EMBEDDER)
+TEST_F(ContainerLayerTest, RetainedChildIsNotPrerolledAgain) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+  retained->set_retained();
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->preroll_count(), 1);
+  EXPECT_EQ(layer->paint_bounds(), child_path.getBounds());
+
+  layer->set_paint_bounds(SkRect::MakeEmpty());
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->preroll_count(), 1);
+  EXPECT_EQ(retained->paint_bounds(), child_path.getBounds());
+  EXPECT_EQ(layer->paint_bounds(), child_path.getBounds());
+}
+
+TEST_F(ContainerLayerTest, RetainedChildIsPrerolledWhenInputsChange) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+  retained->set_retained();
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->preroll_count(), 1);
+
+  const SkMatrix transform = SkMatrix::Translate(1.0f, 2.0f);
+  layer->Preroll(preroll_context(), transform);
+  EXPECT_EQ(mock_layer->preroll_count(), 2);
+  EXPECT_EQ(mock_layer->parent_matrix(), transform);
+
+  preroll_context()->cull_rect = SkRect::MakeWH(10.0f, 10.0f);
+  layer->Preroll(preroll_context(), transform);
+  EXPECT_EQ(mock_layer->preroll_count(), 3);
+  EXPECT_EQ(mock_layer->parent_cull_rect(), SkRect::MakeWH(10.0f, 10.0f));
+
+  layer->Preroll(preroll_context(), transform);
+  EXPECT_EQ(mock_layer->preroll_count(), 3);
+}
+
+TEST_F(ContainerLayerTest, ChildThatIsNotRetainedIsAlwaysPrerolled) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto child = std::make_shared<ContainerLayer>();
+  child->Add(mock_layer);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(child);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->preroll_count(), 2);
+}
+
+TEST_F(ContainerLayerTest, RetainedChildReplaysSurfaceReadback) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, SkPaint(), false,
+                                                false, true);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+  retained->set_retained();
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+
+  preroll_context()->surface_needs_readback = false;
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->preroll_count(), 1);
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+}
+
+TEST_F(ContainerLayerTest, RetainedChildWithPlatformViewIsAlwaysPrerolled) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, SkPaint(), true);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+  retained->set_retained();
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(preroll_context()->has_platform_view);
+  preroll_context()->has_platform_view = false;
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->preroll_count(), 2);
+}
+
+TEST_F(ContainerLayerTest, RetainedChildKeepsRasterCacheEntriesAlive) {
+  use_mock_raster_cache();
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto retained = std::make_shared<OpacityLayer>(128, SkPoint::Make(0, 0));
+  retained->Add(mock_layer);
+  retained->set_retained();
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  raster_cache()->SweepAfterFrame();
+  EXPECT_EQ(raster_cache()->GetLayerCachedEntriesCount(), 1u);
+
+  // The entry would be swept if the replayed preroll didn't prepare it.
+  layer->Preroll(preroll_context(), SkMatrix());
+  raster_cache()->SweepAfterFrame();
+  EXPECT_EQ(mock_layer->preroll_count(), 1);
+  EXPECT_EQ(raster_cache()->GetLayerCachedEntriesCount(), 1u);
+}
+
+namespace {
+
+// Counts the tasks posted to a concurrent task runner.
+class CountingTaskRunner : public fml::BasicTaskRunner {
+ public:
+  explicit CountingTaskRunner(std::shared_ptr<fml::BasicTaskRunner> runner)
+      : runner_(std::move(runner)) {}
+
+  void PostTask(const fml::closure& task) override {
+    task_count_++;
+    runner_->PostTask(task);
+  }
+
+  int task_count() const { return task_count_; }
+
+ private:
+  std::shared_ptr<fml::BasicTaskRunner> runner_;
+  std::atomic<int> task_count_{0};
+};
+
+}  // namespace
+
+TEST_F(ContainerLayerTest, ConcurrentPrerollMatchesSequentialPreroll) {
+  // A wide tree of transforms with complex pictures, some of them retained,
+  // so that the raster cache admits a few pictures per frame in the order
+  // they are prepared. Each run gets a tree of its own, with the same
+  // pictures, since retained layers remember their last preroll.
+  std::vector<sk_sp<SkPicture>> pictures;
+  for (int i = 0; i < 64 * 4; i++) {
+    pictures.push_back(SkPicture::MakePlaceholder(SkRect::MakeWH(8, 8)));
+  }
+  auto make_tree = [&pictures]() {
+    auto root = std::make_shared<ContainerLayer>();
+    for (int i = 0; i < 64; i++) {
+      auto transform =
+          std::make_shared<TransformLayer>(SkMatrix::Translate(i * 10.0f, 0));
+      for (int j = 0; j < 4; j++) {
+        transform->Add(std::make_shared<PictureLayer>(
+            SkPoint::Make(0, j * 10.0f),
+            SkiaGPUObject<SkPicture>(pictures[i * 4 + j], nullptr), true,
+            false));
+      }
+      if (i % 4 == 0) {
+        transform->set_retained();
+      }
+      root->Add(transform);
+    }
+    SkPath path;
+    path.addRect(0, 0, 10, 10);
+    root->Add(std::make_shared<MockLayer>(path, SkPaint(), true, false, false));
+    root->Add(std::make_shared<MockLayer>(path, SkPaint(), false, false, true));
+    return root;
+  };
+
+  struct Frame {
+    SkRect paint_bounds;
+    bool has_platform_view;
+    bool surface_needs_readback;
+    std::vector<MockCanvas::DrawCall> draw_calls;
+  };
+  auto preroll_frames = [this, &make_tree](fml::BasicTaskRunner* task_runner) {
+    use_mock_raster_cache();
+    auto root = make_tree();
+    std::vector<Frame> frames;
+    for (int i = 0; i < 5; i++) {
+      preroll_context()->preroll_task_runner = task_runner;
+      preroll_context()->has_platform_view = false;
+      preroll_context()->surface_needs_readback = false;
+      root->Preroll(preroll_context(), SkMatrix());
+
+      MockCanvas canvas;
+      Layer::PaintContext paint_context = this->paint_context();
+      paint_context.internal_nodes_canvas = canvas.internal_canvas();
+      paint_context.leaf_nodes_canvas = &canvas;
+      root->Paint(paint_context);
+      raster_cache()->SweepAfterFrame();
+
+      frames.push_back({root->paint_bounds(),
+                        preroll_context()->has_platform_view,
+                        preroll_context()->surface_needs_readback,
+                        canvas.draw_calls()});
+    }
+    return frames;
+  };
+
+  std::vector<Frame> sequential = preroll_frames(nullptr);
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  CountingTaskRunner task_runner(loop->GetTaskRunner());
+  std::vector<Frame> concurrent = preroll_frames(&task_runner);
+
+  EXPECT_GT(task_runner.task_count(), 0);
+  ASSERT_EQ(concurrent.size(), sequential.size());
+  EXPECT_NE(sequential.front().draw_calls, sequential.back().draw_calls);
+  for (size_t i = 0; i < sequential.size(); i++) {
+    EXPECT_EQ(concurrent[i].paint_bounds, sequential[i].paint_bounds);
+    EXPECT_TRUE(concurrent[i].has_platform_view);
+    EXPECT_TRUE(concurrent[i].surface_needs_readback);
+    EXPECT_EQ(concurrent[i].draw_calls, sequential[i].draw_calls) << i;
+  }
+}
+#endif
+
 }  // namespace testing
 }  // namespace flutter
@@ -44,6 +44,7 @@ void ImageFilterLayer::Preroll(PrerollContext* context,
     // increment the count to measure how many times it has been
     // seen from frame to frame.
     render_count_++;
+    context->has_volatile_preroll = true;
 
     // Now we will try to pre-render the children into the cache.
     // To apply the filter to pre-rendered children, we must first
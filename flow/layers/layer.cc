@@ -5,6 +5,7 @@
 #include "flutter/flow/layers/layer.h"
 
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/closure.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
 
 namespace flutter {
@@ -27,6 +28,86 @@ uint64_t Layer::NextUniqueID() {
 
 void Layer::Preroll(PrerollContext* context, const SkMatrix& matrix) {}
 
+void Layer::PrerollOrReuse(PrerollContext* context, const SkMatrix& matrix) {
+#if defined(LEGACY_FUCHSIA_EMBEDDER)
+  // Retained subtrees still have to update the system composited scene.
+  const bool can_reuse = false;
+#else
+  const bool can_reuse = is_retained();
+#endif
+  if (!can_reuse) {
+    Preroll(context, matrix);
+    return;
+  }
+#ifndef NDEBUG
+  FML_DCHECK(!prerolling_retained_.exchange(true))
+      << "A retained layer is used more than once in the layer tree.";
+  fml::ScopedCleanupClosure release_retained(
+      [this]() { prerolling_retained_.store(false); });
+#endif
+
+  RasterCache* cache = context->raster_cache;
+  const RetainedPreroll* last = retained_preroll_.get();
+  if (last && last->matrix == matrix && last->cull_rect == context->cull_rect &&
+      last->raster_cache == cache &&
+      last->frame_device_pixel_ratio == context->frame_device_pixel_ratio) {
+    TRACE_EVENT0("flutter", "Layer::PrerollOrReuse (reused)");
+    if (cache) {
+      cache->ReplayPrepares(context, last->prepares);
+    }
+    context->surface_needs_readback =
+        context->surface_needs_readback || last->surface_needs_readback;
+    return;
+  }
+
+  // Preroll the subtree in isolation so that its own contribution to the
+  // context can be told apart from that of the layers before it.
+  const bool surface_needs_readback = context->surface_needs_readback;
+  const bool has_volatile_preroll = context->has_volatile_preroll;
+  context->surface_needs_readback = false;
+  context->has_volatile_preroll = false;
+  RasterCache::PrepareRecording* deferred = context->deferred_prepares;
+  const size_t deferred_start = deferred ? deferred->size() : 0;
+  if (cache && !deferred) {
+    cache->BeginRecordingPrepares();
+  }
+
+  Preroll(context, matrix);
+
+  RasterCache::PrepareRecording prepares;
+  if (deferred) {
+    prepares.assign(deferred->begin() + deferred_start, deferred->end());
+  } else if (cache) {
+    prepares = cache->EndRecordingPrepares();
+  }
+  const bool subtree_needs_readback = context->surface_needs_readback;
+  // Platform views need to be prerolled every frame so that the view embedder
+  // sees them.
+  const bool reusable =
+      !context->has_platform_view && !context->has_volatile_preroll;
+  context->surface_needs_readback =
+      surface_needs_readback || subtree_needs_readback;
+  context->has_volatile_preroll =
+      has_volatile_preroll || context->has_volatile_preroll;
+
+  if (!reusable) {
+    retained_preroll_.reset();
+    return;
+  }
+  retained_preroll_ = std::make_unique<RetainedPreroll>(RetainedPreroll{
+      matrix,
+      context->cull_rect,
+      cache,
+      context->frame_device_pixel_ratio,
+      subtree_needs_readback,
+      std::move(prepares),
+  });
+}
+
+bool Layer::Compile(CompiledLayerTreeBuilder* builder) {
+  return false;
+}
+
 Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
     PrerollContext* preroll_context,
     bool save_layer_is_active,
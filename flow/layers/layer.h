@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_LAYERS_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_LAYER_H_
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -16,6 +17,7 @@
 #include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
@@ -40,6 +42,8 @@ static constexpr SkRect kGiantRect = SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 // This should be an exact copy of the Clip enum in painting.dart.
 enum Clip { none, hardEdge, antiAlias, antiAliasWithSaveLayer };
 
+class CompiledLayerTreeBuilder;
+
 struct PrerollContext {
   RasterCache* raster_cache;
   GrDirectContext* gr_context;
@@ -59,6 +63,17 @@ struct PrerollContext {
   // These allow us to track properties like elevation, opacity, and the
   // prescence of a platform view during Preroll.
   bool has_platform_view = false;
+  // Set by layers whose Preroll results may change from frame to frame even
+  // if their inputs don't. Retained subtrees that contain such a layer are
+  // prerolled every frame.
+  bool has_volatile_preroll = false;
+  // If set, containers may preroll large subtrees in parallel on this task
+  // runner. See |ContainerLayer::PrerollChildren|.
+  fml::BasicTaskRunner* preroll_task_runner = nullptr;
+  // If set, the raster cache must not be modified: the |Prepare| calls that
+  // would be made are appended here instead, to be replayed in order by the
+  // thread that owns the cache.
+  RasterCache::PrepareRecording* deferred_prepares = nullptr;
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   // True if, during the traversal so far, we have seen a child_scene_layer.
   // Informs whether a layer needs to be system composited.
@@ -75,6 +90,17 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context, const SkMatrix& matrix);
 
+  // Calls |Preroll|, unless this layer is retained and was last prerolled with
+  // the same matrix, cull rect and raster cache. In that case the paint bounds
+  // computed by the last preroll are kept, and its effects on |context| and on
+  // the raster cache are replayed without visiting the subtree.
+  void PrerollOrReuse(PrerollContext* context, const SkMatrix& matrix);
+
+  // Returns the number of layers in this subtree, or zero if the subtree has
+  // to be prerolled on the raster thread, e.g. because it embeds a platform
+  // view. Used to decide which subtrees are worth prerolling in parallel.
+  virtual size_t ConcurrentPrerollWeight() { return 1; }
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -152,6 +178,11 @@ class Layer {
 
   virtual void Paint(PaintContext& context) const = 0;
 
+  // Appends this layer and its subtree to |builder|. Returns false if the
+  // layer cannot be represented in a CompiledLayerTree, in which case the
+  // whole tree is prerolled and painted by walking the layers.
+  virtual bool Compile(CompiledLayerTreeBuilder* builder);
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   // Updates the system composited scene.
   virtual void UpdateScene(std::shared_ptr<SceneUpdateContext> context);
@@ -200,15 +231,47 @@ class Layer {
 
   uint64_t unique_id() const { return unique_id_; }
 
+  // Marks this layer as the root of a subtree that the framework retains
+  // across frames, see |SceneBuilder::addRetained|. The layers of a retained
+  // subtree never change, which allows |PrerollOrReuse| to skip them.
+  //
+  // Called on the UI thread while the layer may be prerolled on the raster
+  // thread.
+  void set_retained() { retained_.store(true, std::memory_order_relaxed); }
+
+  bool is_retained() const { return retained_.load(std::memory_order_relaxed); }
+
  protected:
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   bool child_layer_exists_below_ = false;
 #endif
 
  private:
+  // The inputs and side effects of the last preroll of a retained layer.
+  struct RetainedPreroll {
+    SkMatrix matrix;
+    SkRect cull_rect;
+    const RasterCache* raster_cache;
+    float frame_device_pixel_ratio;
+    bool surface_needs_readback;
+    RasterCache::PrepareRecording prepares;
+  };
+
   SkRect paint_bounds_;
   uint64_t unique_id_;
   bool needs_system_composite_;
+  std::atomic<bool> retained_{false};
+  // Only accessed by the thread prerolling the subtree of this layer, which
+  // may be a preroll worker, see |ContainerLayer::PrerollChildren|. Each
+  // subtree is prerolled by one thread as long as a layer appears once in a
+  // tree. Only retained layers can be shared between parents, and dart:ui
+  // asserts that a retained layer is only used once in a scene.
+  std::unique_ptr<RetainedPreroll> retained_preroll_;
+#ifndef NDEBUG
+  // Set while a thread prerolls this retained layer, to catch a layer that is
+  // used twice in a tree being prerolled on two threads at once.
+  std::atomic<bool> prerolling_retained_{false};
+#endif
 
   static uint64_t NextUniqueID();
 
@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+struct LayerArena::Block {
+  explicit Block(size_t holds) : holds(holds) {}
+
+  // One for each allocation that has not been freed, and one for the arena
+  // while it allocates from the block.
+  std::atomic<size_t> holds;
+};
+
+namespace {
+
+constexpr size_t kMaxAlignment = alignof(std::max_align_t);
+
+// The block header is followed by the allocations, each of which is preceded
+// by a pointer to its block so that it can be freed without a lookup.
+constexpr size_t kBlockHeaderSize = kMaxAlignment;
+
+char* AlignUp(char* pointer, size_t alignment) {
+  uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+  address = (address + alignment - 1) & ~(alignment - 1);
+  return reinterpret_cast<char*>(address);
+}
+
+char* BlockData(void* block) {
+  return static_cast<char*>(block) + kBlockHeaderSize;
+}
+
+void* Place(void* block, char* allocation) {
+  reinterpret_cast<void**>(allocation)[-1] = block;
+  return allocation;
+}
+
+}  // namespace
+
+std::shared_ptr<LayerArena> LayerArena::Create(size_t block_size) {
+  return std::shared_ptr<LayerArena>(new LayerArena(block_size));
+}
+
+LayerArena::LayerArena(size_t block_size) : block_size_(block_size) {
+  FML_DCHECK(block_size_ > 0);
+}
+
+LayerArena::~LayerArena() {
+  if (current_ != nullptr) {
+    Release(current_);
+  }
+  FML_DCHECK(live_block_count_ == 0);
+}
+
+void* LayerArena::Allocate(size_t size, size_t alignment) {
+  FML_DCHECK(alignment > 0 && (alignment & (alignment - 1)) == 0);
+  FML_CHECK(alignment <= kMaxAlignment);
+
+  allocated_bytes_ += size;
+  alignment = std::max(alignment, alignof(void*));
+
+  // Allocations that would waste a large part of a block get their own, and
+  // leave the current block to the allocations that follow.
+  if (size > block_size_ / 4) {
+    Block* block = NewBlock(kMaxAlignment + size, 1);
+    return Place(block, BlockData(block) + kMaxAlignment);
+  }
+
+  char* result = current_ != nullptr
+                     ? AlignUp(cursor_ + sizeof(void*), alignment)
+                     : nullptr;
+  if (result == nullptr || result + size > limit_) {
+    if (current_ != nullptr) {
+      Release(current_);
+    }
+    current_ = NewBlock(block_size_, 1);
+    limit_ = BlockData(current_) + block_size_;
+    result = AlignUp(BlockData(current_) + sizeof(void*), alignment);
+  }
+  // The arena's own hold keeps the block alive, so this can't race with the
+  // release of the last of its other allocations.
+  current_->holds.fetch_add(1, std::memory_order_relaxed);
+  cursor_ = result + size;
+  return Place(current_, result);
+}
+
+void LayerArena::Free(void* allocation) {
+  Release(static_cast<Block*>(reinterpret_cast<void**>(allocation)[-1]));
+}
+
+LayerArena::Block* LayerArena::NewBlock(size_t size, size_t holds) {
+  static_assert(sizeof(Block) <= kBlockHeaderSize, "Block header too large");
+  const size_t count =
+      (kBlockHeaderSize + size + sizeof(std::max_align_t) - 1) /
+      sizeof(std::max_align_t);
+  block_count_++;
+  live_block_count_.fetch_add(1, std::memory_order_relaxed);
+  return new (new std::max_align_t[count]) Block(holds);
+}
+
+void LayerArena::Release(Block* block) {
+  if (block->holds.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  block->~Block();
+  delete[] reinterpret_cast<std::max_align_t*>(block);
+  live_block_count_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+}  // namespace flutter
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A bump allocator for the layers of a single frame.
+///
+/// Building a scene allocates thousands of small layers and their shared_ptr
+/// control blocks, most of which are destroyed together when the next frame
+/// replaces the tree. Layers made by |MakeLayer| are placed next to each other
+/// in blocks of |block_size| bytes instead. A block is returned to the heap
+/// at once when the last of its layers is destroyed, after the arena has
+/// moved on to the next block.
+///
+/// Every layer made by the arena holds a reference to it, so the arena lives
+/// until the last of its layers is gone. A layer that outlives its frame only
+/// keeps its own block and the last block of the arena alive, not the rest of
+/// the frame. The SceneBuilder still makes the layers that Dart can retain
+/// through an EngineLayer on the heap, since those are the ones expected to
+/// outlive their frame.
+///
+/// Allocation is not thread safe. An arena is meant to be filled by the thread
+/// building the tree, while the layers themselves may be released from any
+/// thread.
+///
+class LayerArena : public std::enable_shared_from_this<LayerArena> {
+ public:
+  static constexpr size_t kDefaultBlockSize = 16 * 1024;
+
+  // An allocator for |std::allocate_shared| that carves memory out of an
+  // arena. It holds a reference to the arena, so the control block of every
+  // shared_ptr it creates keeps the arena alive.
+  template <typename T>
+  class Allocator {
+   public:
+    using value_type = T;
+
+    explicit Allocator(std::shared_ptr<LayerArena> arena)
+        : arena_(std::move(arena)) {}
+
+    template <typename U>
+    Allocator(const Allocator<U>& other) : arena_(other.arena_) {}
+
+    T* allocate(size_t n) {
+      return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) { arena_->Free(p); }
+
+    template <typename U>
+    bool operator==(const Allocator<U>& other) const {
+      return arena_ == other.arena_;
+    }
+
+    template <typename U>
+    bool operator!=(const Allocator<U>& other) const {
+      return arena_ != other.arena_;
+    }
+
+   private:
+    template <typename U>
+    friend class Allocator;
+
+    std::shared_ptr<LayerArena> arena_;
+  };
+
+  static std::shared_ptr<LayerArena> Create(
+      size_t block_size = kDefaultBlockSize);
+
+  ~LayerArena();
+
+  // Makes a layer, together with its reference counts, in the arena.
+  template <typename T, typename... Args>
+  std::shared_ptr<T> MakeLayer(Args&&... args) {
+    return std::allocate_shared<T>(Allocator<T>(shared_from_this()),
+                                   std::forward<Args>(args)...);
+  }
+
+  // Returns |size| bytes aligned to |alignment|, which must be a power of two
+  // no larger than the alignment of |std::max_align_t|. The allocation must
+  // be passed to |Free| before the arena is destroyed.
+  void* Allocate(size_t size, size_t alignment);
+
+  // Frees an allocation made by |Allocate|. Unlike |Allocate|, this may be
+  // called on any thread.
+  void Free(void* allocation);
+
+  // The number of blocks allocated so far.
+  size_t block_count() const { return block_count_; }
+
+  // The number of blocks that have not been returned to the heap yet.
+  size_t live_block_count() const { return live_block_count_; }
+
+  size_t allocated_bytes() const { return allocated_bytes_; }
+
+ private:
+  struct Block;
+
+  explicit LayerArena(size_t block_size);
+
+  // Makes a block with room for |size| bytes, that is returned to the heap
+  // once |Release| has been called |holds| times.
+  Block* NewBlock(size_t size, size_t holds);
+
+  void Release(Block* block);
+
+  const size_t block_size_;
+  // The block allocations are made from. The arena holds it until it moves on
+  // to the next block.
+  Block* current_ = nullptr;
+  char* cursor_ = nullptr;
+  char* limit_ = nullptr;
+  size_t block_count_ = 0;
+  std::atomic<size_t> live_block_count_{0};
+  size_t allocated_bytes_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerArena);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
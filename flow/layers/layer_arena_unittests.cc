@@ -0,0 +1,159 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class CountedLayer : public ContainerLayer {
+ public:
+  explicit CountedLayer(int* destroyed_count)
+      : destroyed_count_(destroyed_count) {}
+
+  ~CountedLayer() override { (*destroyed_count_)++; }
+
+ private:
+  int* destroyed_count_;
+};
+
+}  // namespace
+
+TEST(LayerArena, AllocationsAreAlignedAndPacked) {
+  auto arena = LayerArena::Create(1024);
+  std::vector<void*> allocations = {arena->Allocate(1, 1)};
+  for (size_t alignment = 1; alignment <= alignof(std::max_align_t);
+       alignment *= 2) {
+    void* allocation = arena->Allocate(3, alignment);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation) % alignment, 0u);
+    EXPECT_GT(allocation, allocations.back());
+    allocations.push_back(allocation);
+  }
+  EXPECT_EQ(arena->block_count(), 1u);
+
+  for (void* allocation : allocations) {
+    arena->Free(allocation);
+  }
+}
+
+TEST(LayerArena, GrowsByBlocks) {
+  auto arena = LayerArena::Create(1024);
+  std::vector<void*> allocations;
+  for (int i = 0; i < 48; i++) {
+    allocations.push_back(arena->Allocate(64, 8));
+  }
+  EXPECT_EQ(arena->block_count(), 4u);
+  EXPECT_EQ(arena->allocated_bytes(), 48u * 64u);
+
+  // Large allocations don't end the current block.
+  allocations.push_back(arena->Allocate(4096, 8));
+  EXPECT_EQ(arena->block_count(), 5u);
+  allocations.push_back(arena->Allocate(64, 8));
+  EXPECT_EQ(arena->block_count(), 5u);
+
+  for (void* allocation : allocations) {
+    arena->Free(allocation);
+  }
+}
+
+TEST(LayerArena, FillsBlocksToTheEnd) {
+  // Each allocation takes 64 bytes with the pointer to its block, so that 16
+  // of them end exactly at the end of a 1024 byte block. Writing all of their
+  // bytes lets the sanitizers catch blocks that are too small.
+  auto arena = LayerArena::Create(1024);
+  std::vector<void*> allocations;
+  for (int i = 0; i < 16; i++) {
+    allocations.push_back(arena->Allocate(56, 8));
+    memset(allocations.back(), 0xff, 56);
+  }
+  EXPECT_EQ(arena->block_count(), 1u);
+  EXPECT_EQ(static_cast<char*>(allocations.back()) -
+                static_cast<char*>(allocations.front()),
+            15 * 64);
+
+  allocations.push_back(arena->Allocate(56, 8));
+  memset(allocations.back(), 0xff, 56);
+  EXPECT_EQ(arena->block_count(), 2u);
+
+  // Large allocations get a block of their own that fits them exactly.
+  allocations.push_back(arena->Allocate(1000, 8));
+  memset(allocations.back(), 0xff, 1000);
+  EXPECT_EQ(arena->block_count(), 3u);
+
+  for (void* allocation : allocations) {
+    arena->Free(allocation);
+  }
+}
+
+TEST(LayerArena, ReturnsBlocksOnceTheyAreFreed) {
+  auto arena = LayerArena::Create(1024);
+  std::vector<void*> allocations;
+  for (int i = 0; i < 48; i++) {
+    allocations.push_back(arena->Allocate(64, 8));
+  }
+  EXPECT_EQ(arena->live_block_count(), 4u);
+
+  // Blocks the arena has moved on from are returned as soon as they are
+  // empty, and the current one once the arena is gone.
+  for (int i = 0; i < 28; i++) {
+    arena->Free(allocations[i]);
+  }
+  EXPECT_EQ(arena->live_block_count(), 2u);
+  for (int i = 28; i < 48; i++) {
+    arena->Free(allocations[i]);
+  }
+  EXPECT_EQ(arena->live_block_count(), 1u);
+}
+
+TEST(LayerArena, LayersKeepArenaAlive) {
+  int destroyed_count = 0;
+  auto arena = LayerArena::Create();
+  std::weak_ptr<LayerArena> weak_arena = arena;
+
+  auto root = arena->MakeLayer<ContainerLayer>();
+  auto child = arena->MakeLayer<CountedLayer>(&destroyed_count);
+  root->Add(child);
+  root->Add(arena->MakeLayer<MockLayer>(SkPath()));
+  EXPECT_EQ(arena->block_count(), 1u);
+
+  // A retained layer outlives both the arena handle and the rest of its tree.
+  arena.reset();
+  root.reset();
+  EXPECT_EQ(destroyed_count, 0);
+  EXPECT_FALSE(weak_arena.expired());
+
+  child.reset();
+  EXPECT_EQ(destroyed_count, 1);
+  EXPECT_TRUE(weak_arena.expired());
+}
+
+TEST(LayerArena, RetainedLayersOnlyKeepTheirOwnBlock) {
+  auto arena = LayerArena::Create(1024);
+  std::vector<std::shared_ptr<ContainerLayer>> layers;
+  while (arena->block_count() < 8) {
+    layers.push_back(arena->MakeLayer<ContainerLayer>());
+  }
+  EXPECT_EQ(arena->live_block_count(), 8u);
+
+  // The arena stays alive for the retained layer, but only keeps the block
+  // that holds it and the one it was allocating from.
+  LayerArena* retained_arena = arena.get();
+  std::shared_ptr<ContainerLayer> retained = layers.front();
+  layers.clear();
+  arena.reset();
+  EXPECT_EQ(retained_arena->live_block_count(), 2u);
+}
+
+}  // namespace testing
+}  // namespace flutter
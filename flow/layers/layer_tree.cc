@@ -56,11 +56,27 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       frame.context().texture_registry(),
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
+  context.preroll_task_runner = frame.context().preroll_task_runner();
+
+  if (compiled_tree_) {
+    compiled_tree_->Preroll(&context, frame.root_surface_transformation());
+    return context.surface_needs_readback;
+  }
 
   root_layer_->Preroll(&context, frame.root_surface_transformation());
   return context.surface_needs_readback;
 }
 
+bool LayerTree::Compile() {
+#if defined(LEGACY_FUCHSIA_EMBEDDER)
+  // System compositing relies on the layers being prerolled.
+  return false;
+#else
+  compiled_tree_ = CompiledLayerTree::Compile(root_layer_.get());
+  return compiled_tree_ != nullptr;
+#endif
+}
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
 void LayerTree::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
   TRACE_EVENT0("flutter", "LayerTree::UpdateScene");
@@ -113,6 +129,11 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
 
+  if (compiled_tree_) {
+    compiled_tree_->Paint(context);
+    return;
+  }
+
   if (root_layer_->needs_painting(context)) {
     root_layer_->Paint(context);
   }
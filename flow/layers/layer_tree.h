@@ -9,6 +9,7 @@
 #include <memory>
 
 #include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/compiled_layer_tree.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
@@ -44,8 +45,18 @@ class LayerTree {
 
   void set_root_layer(std::shared_ptr<Layer> root_layer) {
     root_layer_ = std::move(root_layer);
+    compiled_tree_.reset();
   }
 
+  // Compiles the layers into a CompiledLayerTree that |Preroll| and |Paint|
+  // use instead of walking the layers. The tree is left as is if any of its
+  // layers cannot be compiled.
+  //
+  // Returns whether the tree was compiled.
+  bool Compile();
+
+  bool is_compiled() const { return compiled_tree_ != nullptr; }
+
   const SkISize& frame_size() const { return frame_size_; }
   float device_pixel_ratio() const { return device_pixel_ratio_; }
 
@@ -80,6 +91,7 @@ class LayerTree {
 
  private:
   std::shared_ptr<Layer> root_layer_;
+  std::unique_ptr<CompiledLayerTree> compiled_tree_;
   fml::TimePoint vsync_start_;
   fml::TimePoint build_start_;
   fml::TimePoint build_finish_;
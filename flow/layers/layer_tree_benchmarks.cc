@@ -0,0 +1,228 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/common/graphics/texture.h"
+#include "flutter/flow/instrumentation.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/compiled_layer_tree.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_arena.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr int kCanvasSize = 1000;
+
+// Makes a layer in |arena|, or on the heap if |arena| is null.
+template <typename T, typename... Args>
+std::shared_ptr<T> MakeLayer(LayerArena* arena, Args&&... args) {
+  if (arena != nullptr) {
+    return arena->MakeLayer<T>(std::forward<Args>(args)...);
+  }
+  return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+// A group is a transform, a clip and two pictures. Every other group is
+// placed outside of the canvas to exercise culling. Like the SceneBuilder,
+// only the pictures are made in |arena|.
+std::shared_ptr<Layer> MakeGroup(int index,
+                                 sk_sp<SkPicture> picture,
+                                 LayerArena* arena = nullptr) {
+  const SkScalar offset = (index % 2 == 0) ? (index % kCanvasSize) : -1000;
+  auto transform =
+      std::make_shared<TransformLayer>(SkMatrix::Translate(offset, offset));
+  auto clip =
+      std::make_shared<ClipRectLayer>(SkRect::MakeWH(40, 40), Clip::hardEdge);
+  clip->Add(MakeLayer<PictureLayer>(
+      arena, SkPoint::Make(0, 0), SkiaGPUObject<SkPicture>(picture, nullptr),
+      false, false));
+  clip->Add(MakeLayer<PictureLayer>(
+      arena, SkPoint::Make(10, 10), SkiaGPUObject<SkPicture>(picture, nullptr),
+      false, false));
+  transform->Add(clip);
+  return transform;
+}
+
+// Returns a tree of |group_count| groups, roughly 4 * |group_count| layers.
+std::shared_ptr<ContainerLayer> MakeTree(int group_count,
+                                         LayerArena* arena = nullptr) {
+  auto picture = SkPicture::MakePlaceholder(SkRect::MakeWH(20, 20));
+  auto root = MakeLayer<ContainerLayer>(arena);
+  for (int i = 0; i < group_count; i++) {
+    root->Add(MakeGroup(i, picture, arena));
+  }
+  return root;
+}
+
+// Holds the state needed to build preroll and paint contexts outside of a
+// rasterizer.
+class FrameState {
+ public:
+  FrameState() : canvas_(kCanvasSize, kCanvasSize) {}
+
+  PrerollContext preroll_context() {
+    return {
+        nullptr,           /* raster_cache */
+        nullptr,           /* gr_context */
+        nullptr,           /* external_view_embedder */
+        mutators_stack_,   /* mutators_stack */
+        nullptr,           /* color_space */
+        kGiantRect,        /* cull_rect */
+        false,             /* layer reads from surface */
+        raster_time_,      /* raster stopwatch */
+        ui_time_,          /* frame build stopwatch */
+        texture_registry_, /* texture_registry */
+        false,             /* checkerboard_offscreen_layers */
+        1.0f,              /* frame_device_pixel_ratio */
+    };
+  }
+
+  Layer::PaintContext paint_context() {
+    return {
+        &canvas_,          /* internal_nodes_canvas */
+        &canvas_,          /* leaf_nodes_canvas */
+        nullptr,           /* gr_context */
+        nullptr,           /* external_view_embedder */
+        raster_time_,      /* raster stopwatch */
+        ui_time_,          /* frame build stopwatch */
+        texture_registry_, /* texture_registry */
+        nullptr,           /* raster_cache */
+        false,             /* checkerboard_offscreen_layers */
+        1.0f,              /* frame_device_pixel_ratio */
+    };
+  }
+
+ private:
+  SkNoDrawCanvas canvas_;
+  MutatorsStack mutators_stack_;
+  Stopwatch raster_time_;
+  Stopwatch ui_time_;
+  TextureRegistry texture_registry_;
+};
+
+}  // namespace
+
+static void BM_LayerTreePrerollAndPaint(benchmark::State& state) {
+  auto root = MakeTree(state.range(0));
+  FrameState frame;
+  while (state.KeepRunning()) {
+    PrerollContext preroll_context = frame.preroll_context();
+    root->Preroll(&preroll_context, SkMatrix::I());
+    Layer::PaintContext paint_context = frame.paint_context();
+    root->Paint(paint_context);
+  }
+}
+BENCHMARK(BM_LayerTreePrerollAndPaint)->Arg(100)->Arg(2500);
+
+static void BM_CompiledLayerTreePrerollAndPaint(benchmark::State& state) {
+  auto root = MakeTree(state.range(0));
+  auto compiled = CompiledLayerTree::Compile(root.get());
+  FML_CHECK(compiled);
+  FrameState frame;
+  while (state.KeepRunning()) {
+    PrerollContext preroll_context = frame.preroll_context();
+    compiled->Preroll(&preroll_context, SkMatrix::I());
+    Layer::PaintContext paint_context = frame.paint_context();
+    compiled->Paint(paint_context);
+  }
+}
+BENCHMARK(BM_CompiledLayerTreePrerollAndPaint)->Arg(100)->Arg(2500);
+
+static void BM_CompileLayerTree(benchmark::State& state) {
+  auto root = MakeTree(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(CompiledLayerTree::Compile(root.get()));
+  }
+}
+BENCHMARK(BM_CompileLayerTree)->Arg(100)->Arg(2500);
+
+// Prerolls a mostly static scene in which only a single picture moves from
+// frame to frame. Like the framework, every frame builds a new root and adds
+// the unchanged groups to it, marking them as retained if range(1) is set.
+static void BM_PrerollRetainedGroups(benchmark::State& state) {
+  const bool retained = state.range(1) != 0;
+  auto picture = SkPicture::MakePlaceholder(SkRect::MakeWH(20, 20));
+  std::vector<std::shared_ptr<Layer>> groups;
+  for (int i = 0; i < state.range(0); i++) {
+    groups.push_back(MakeGroup(i, picture));
+    if (retained) {
+      groups.back()->set_retained();
+    }
+  }
+  FrameState frame;
+  int frame_count = 0;
+  while (state.KeepRunning()) {
+    auto root = std::make_shared<ContainerLayer>();
+    for (const auto& group : groups) {
+      root->Add(group);
+    }
+    root->Add(std::make_shared<PictureLayer>(
+        SkPoint::Make(frame_count++ % kCanvasSize, 0),
+        SkiaGPUObject<SkPicture>(picture, nullptr), false, true));
+    PrerollContext preroll_context = frame.preroll_context();
+    root->Preroll(&preroll_context, SkMatrix::I());
+  }
+}
+BENCHMARK(BM_PrerollRetainedGroups)
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({2500, 0})
+    ->Args({2500, 1});
+
+// Prerolls a wide tree of range(0) groups, in parallel on four workers if
+// range(1) is set.
+static void BM_PrerollWideLayerTree(benchmark::State& state) {
+  auto root = MakeTree(state.range(0));
+  std::shared_ptr<fml::ConcurrentMessageLoop> loop;
+  std::shared_ptr<fml::ConcurrentTaskRunner> task_runner;
+  if (state.range(1) != 0) {
+    loop = fml::ConcurrentMessageLoop::Create(4);
+    task_runner = loop->GetTaskRunner();
+  }
+  FrameState frame;
+  while (state.KeepRunning()) {
+    PrerollContext preroll_context = frame.preroll_context();
+    preroll_context.preroll_task_runner = task_runner.get();
+    root->Preroll(&preroll_context, SkMatrix::I());
+  }
+}
+BENCHMARK(BM_PrerollWideLayerTree)
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({2500, 0})
+    ->Args({2500, 1})
+    ->UseRealTime();
+
+// Builds and destroys a tree of roughly 4 * range(0) layers, allocating the
+// layers that can't be retained from a per-frame arena like the SceneBuilder
+// does if range(1) is set.
+static void BM_BuildAndDestroyLayerTree(benchmark::State& state) {
+  const bool use_arena = state.range(1) != 0;
+  while (state.KeepRunning()) {
+    std::shared_ptr<LayerArena> arena;
+    if (use_arena) {
+      arena = LayerArena::Create();
+    }
+    auto root = MakeTree(state.range(0), arena.get());
+    arena.reset();
+    root.reset();
+  }
+}
+BENCHMARK(BM_BuildAndDestroyLayerTree)
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({2500, 0})
+    ->Args({2500, 1});
+
+}  // namespace flutter
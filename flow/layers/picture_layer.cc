@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/picture_layer.h"
 
+#include "flutter/flow/layers/compiled_layer_tree.h"
 #include "flutter/fml/logging.h"
 
 namespace flutter {
@@ -11,11 +12,13 @@ namespace flutter {
 PictureLayer::PictureLayer(const SkPoint& offset,
                            SkiaGPUObject<SkPicture> picture,
                            bool is_complex,
-                           bool will_change)
+                           bool will_change,
+                           PictureFingerprint fingerprint)
     : offset_(offset),
       picture_(std::move(picture)),
       is_complex_(is_complex),
-      will_change_(will_change) {}
+      will_change_(will_change),
+      fingerprint_(fingerprint) {}
 
 void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "PictureLayer::Preroll");
@@ -34,14 +37,29 @@ void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
     ctm = RasterCache::GetIntegralTransCTM(ctm);
 #endif
-    cache->Prepare(context->gr_context, sk_picture, ctm,
-                   context->dst_color_space, is_complex_, will_change_);
+    if (context->deferred_prepares) {
+      context->deferred_prepares->push_back(
+          {sk_picture, nullptr, ctm, is_complex_, will_change_, fingerprint_});
+    } else {
+      cache->Prepare(context->gr_context, sk_picture, ctm,
+                     context->dst_color_space, is_complex_, will_change_,
+                     fingerprint_);
+    }
   }
 
   SkRect bounds = sk_picture->cullRect().makeOffset(offset_.x(), offset_.y());
   set_paint_bounds(bounds);
 }
 
+bool PictureLayer::Compile(CompiledLayerTreeBuilder* builder) {
+  if (!picture()) {
+    return false;
+  }
+  builder->AddPicture(this, offset_, picture(), is_complex_, will_change_,
+                      fingerprint_);
+  return true;
+}
+
 void PictureLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "PictureLayer::Paint");
   FML_DCHECK(picture_.get());
@@ -55,7 +73,8 @@ void PictureLayer::Paint(PaintContext& context) const {
 #endif
 
   if (context.raster_cache &&
-      context.raster_cache->Draw(*picture(), *context.leaf_nodes_canvas)) {
+      context.raster_cache->Draw(*picture(), *context.leaf_nodes_canvas,
+                                 fingerprint_)) {
     TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
     return;
   }
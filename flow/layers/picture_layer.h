@@ -18,14 +18,19 @@ class PictureLayer : public Layer {
   PictureLayer(const SkPoint& offset,
                SkiaGPUObject<SkPicture> picture,
                bool is_complex,
-               bool will_change);
+               bool will_change,
+               PictureFingerprint fingerprint = kNoPictureFingerprint);
 
   SkPicture* picture() const { return picture_.get().get(); }
 
+  PictureFingerprint fingerprint() const { return fingerprint_; }
+
   void Preroll(PrerollContext* frame, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
 
+  bool Compile(CompiledLayerTreeBuilder* builder) override;
+
  private:
   SkPoint offset_;
   // Even though pictures themselves are not GPU resources, they may reference
@@ -33,6 +38,7 @@ class PictureLayer : public Layer {
   SkiaGPUObject<SkPicture> picture_;
   bool is_complex_ = false;
   bool will_change_ = false;
+  PictureFingerprint fingerprint_ = kNoPictureFingerprint;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PictureLayer);
 };
@@ -17,6 +17,9 @@ class PlatformViewLayer : public Layer {
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
+  // Platform views are prerolled with the view embedder, which is only used
+  // on the raster thread.
+  size_t ConcurrentPrerollWeight() override { return 0; }
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   // Updates the system composited scene.
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
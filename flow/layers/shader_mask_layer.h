@@ -20,6 +20,9 @@ class ShaderMaskLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // |ContainerLayer|
+  bool Compile(CompiledLayerTreeBuilder* builder) override { return false; }
+
  private:
   sk_sp<SkShader> shader_;
   SkRect mask_rect_;
@@ -6,6 +6,8 @@
 
 #include <optional>
 
+#include "flutter/flow/layers/compiled_layer_tree.h"
+
 namespace flutter {
 
 TransformLayer::TransformLayer(const SkMatrix& transform)
@@ -52,6 +54,15 @@ void TransformLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   context->mutators_stack.Pop();
 }
 
+bool TransformLayer::Compile(CompiledLayerTreeBuilder* builder) {
+  builder->PushTransform(this, transform_);
+  if (!CompileChildren(builder)) {
+    return false;
+  }
+  builder->Pop();
+  return true;
+}
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
 
 void TransformLayer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
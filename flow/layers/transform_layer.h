@@ -19,6 +19,8 @@ class TransformLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  bool Compile(CompiledLayerTreeBuilder* builder) override;
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
 #endif
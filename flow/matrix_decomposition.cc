@@ -121,6 +121,17 @@ MatrixDecomposition::MatrixDecomposition(SkM44 matrix) : valid_(false) {
 
 MatrixDecomposition::~MatrixDecomposition() = default;
 
+bool MatrixDecomposition::IsDecomposable(const SkMatrix& matrix) {
+  if (matrix.hasPerspective()) {
+    return MatrixDecomposition(matrix).IsValid();
+  }
+  // The bottom row of the matrix is (0, 0, 0, 1), so the constructor neither
+  // rescales it nor strips a perspective from it, and the decomposition is
+  // valid exactly when the matrix can be inverted.
+  SkM44 inverted(SkM44::Uninitialized_Constructor::kUninitialized_Constructor);
+  return SkM44(matrix).invert(&inverted);
+}
+
 bool MatrixDecomposition::IsValid() const {
   return valid_;
 }
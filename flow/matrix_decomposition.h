@@ -22,6 +22,11 @@ class MatrixDecomposition {
 
   ~MatrixDecomposition();
 
+  // Returns |MatrixDecomposition(matrix).IsValid()|. Matrices without
+  // perspective, such as the scale and translate matrices of most layers, are
+  // only inverted instead of fully decomposed.
+  static bool IsDecomposable(const SkMatrix& matrix);
+
   bool IsValid() const;
 
   const SkV3& translation() const { return translation_; }
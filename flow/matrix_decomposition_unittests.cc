@@ -5,6 +5,8 @@
 #include "flutter/flow/matrix_decomposition.h"
 
 #include <cmath>
+#include <limits>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -155,5 +157,35 @@ TEST(MatrixDecomposition, ScaleFloatError) {
   ASSERT_FLOAT_EQ(0, decomposition3.rotation().z);
 }
 
+TEST(MatrixDecomposition, IsDecomposableMatchesIsValid) {
+  std::vector<SkMatrix> matrices = {
+      SkMatrix::I(),
+      SkMatrix::Translate(10.5f, -3.25f),
+      SkMatrix::Scale(2.0f, 3.0f),
+      SkMatrix::Scale(-1.0f, 1.0f),
+      SkMatrix::Scale(0.0f, 1.0f),
+      SkMatrix::Scale(1e-30f, 1e-30f),
+      SkMatrix::Scale(1e30f, 1e30f),
+      SkMatrix::Scale(1e20f, 1e-20f),
+      SkMatrix::RotateDeg(30.0f),
+      SkMatrix::MakeAll(1, 2, 3, 2, 4, 6, 0, 0, 1),
+      SkMatrix::MakeAll(1, 0.5f, 0, 0, 1, 0, 0, 0, 1),
+      SkMatrix::MakeAll(1, 0, 0, 0, 1, 0, 0.001f, 0, 1),
+      SkMatrix::MakeAll(1, 0, 0, 0, 1, 0, 0, 0, 0),
+      SkMatrix::MakeAll(2, 0, 0, 0, 2, 0, 0, 0, 4),
+      SkMatrix::Scale(std::numeric_limits<float>::quiet_NaN(), 1.0f),
+      SkMatrix::Translate(std::numeric_limits<float>::infinity(), 0.0f),
+  };
+  SkMatrix scaled_and_translated = SkMatrix::Scale(2.0f, 2.0f);
+  scaled_and_translated.postTranslate(10.0f, -2000.5f);
+  matrices.push_back(scaled_and_translated);
+
+  for (size_t i = 0; i < matrices.size(); i++) {
+    EXPECT_EQ(MatrixDecomposition::IsDecomposable(matrices[i]),
+              MatrixDecomposition(matrices[i]).IsValid())
+        << i;
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
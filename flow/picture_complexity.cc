@@ -0,0 +1,383 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_complexity.h"
+
+#include <algorithm>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRegion.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkVertices.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+
+namespace flutter {
+
+namespace {
+
+using PC = PictureComplexity;
+
+// A canvas that draws nothing but accumulates the estimated cost of every op
+// played back into it. Matrix and clip state are tracked by SkNoDrawCanvas so
+// that costs are computed for the area each op actually touches.
+class ComplexityCanvas final : public SkNoDrawCanvas {
+ public:
+  ComplexityCanvas(const SkIRect& bounds, PictureComplexity* complexity)
+      : SkNoDrawCanvas(bounds), complexity_(complexity) {}
+
+ protected:
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override {
+    double cost_per_pixel = PC::kSaveLayerCostPerPixel;
+    if (rec.fPaint) {
+      cost_per_pixel += PaintCostPerPixel(*rec.fPaint);
+    }
+    if (rec.fBackdrop) {
+      cost_per_pixel += PC::kImageFilterCostPerPixel;
+    }
+    double area = rec.fBounds ? DeviceArea(*rec.fBounds) : ClipArea();
+    AddOp(area * cost_per_pixel);
+    return kNoLayer_SaveLayerStrategy;
+  }
+
+  void onDrawPaint(const SkPaint& paint) override {
+    AddOp(ClipArea() * (PC::kRectCostPerPixel + PaintCostPerPixel(paint)));
+  }
+
+  void onDrawBehind(const SkPaint& paint) override { onDrawPaint(paint); }
+
+  void onDrawPoints(PointMode mode,
+                    size_t count,
+                    const SkPoint pts[],
+                    const SkPaint& paint) override {
+    SkRect bounds;
+    bounds.setBounds(pts, static_cast<int>(count));
+    AddDraw(bounds, paint, PC::kPathCostPerPixel,
+            count * PC::kPathCostPerVerb);
+  }
+
+  void onDrawRect(const SkRect& rect, const SkPaint& paint) override {
+    AddDraw(rect, paint, PC::kRectCostPerPixel);
+  }
+
+  void onDrawRegion(const SkRegion& region, const SkPaint& paint) override {
+    AddDraw(SkRect::Make(region.getBounds()), paint, PC::kRectCostPerPixel,
+            region.computeRegionComplexity() * PC::kPathCostPerVerb);
+  }
+
+  void onDrawOval(const SkRect& rect, const SkPaint& paint) override {
+    AddDraw(rect, paint, PC::kRRectCostPerPixel);
+  }
+
+  void onDrawArc(const SkRect& rect,
+                 SkScalar start_angle,
+                 SkScalar sweep_angle,
+                 bool use_center,
+                 const SkPaint& paint) override {
+    AddDraw(rect, paint, PathCostPerPixel(paint));
+  }
+
+  void onDrawRRect(const SkRRect& rrect, const SkPaint& paint) override {
+    AddDraw(rrect.getBounds(), paint, PC::kRRectCostPerPixel);
+  }
+
+  void onDrawDRRect(const SkRRect& outer,
+                    const SkRRect& inner,
+                    const SkPaint& paint) override {
+    AddDraw(outer.getBounds(), paint, PathCostPerPixel(paint));
+  }
+
+  void onDrawPath(const SkPath& path, const SkPaint& paint) override {
+    const double verb_cost = path.countVerbs() * PC::kPathCostPerVerb;
+    if (path.isInverseFillType()) {
+      AddOp(ClipArea() * (PathCostPerPixel(paint) + PaintCostPerPixel(paint)) +
+            verb_cost);
+      return;
+    }
+    AddDraw(path.getBounds(), paint, PathCostPerPixel(paint), verb_cost);
+  }
+
+  void onDrawTextBlob(const SkTextBlob* blob,
+                      SkScalar x,
+                      SkScalar y,
+                      const SkPaint& paint) override {
+    int glyph_count = 0;
+    SkTextBlob::Iter::Run run;
+    for (SkTextBlob::Iter it(*blob); it.next(&run);) {
+      glyph_count += run.fGlyphCount;
+    }
+    AddDraw(blob->bounds().makeOffset(x, y), paint, PC::kTextCostPerPixel,
+            glyph_count * PC::kTextCostPerGlyph);
+  }
+
+#ifdef SK_SUPPORT_LEGACY_ONDRAWIMAGERECT
+  void onDrawImage(const SkImage* image,
+                   SkScalar left,
+                   SkScalar top,
+                   const SkPaint* paint) override {
+    onDrawImage2(image, left, top, SkSamplingOptions(), paint);
+  }
+
+  void onDrawImageRect(const SkImage* image,
+                       const SkRect* src,
+                       const SkRect& dst,
+                       const SkPaint* paint,
+                       SrcRectConstraint constraint) override {
+    AddImageDraw(dst, paint, PC::kImageCostPerPixel);
+  }
+
+  void onDrawImageLattice(const SkImage* image,
+                          const Lattice& lattice,
+                          const SkRect& dst,
+                          const SkPaint* paint) override {
+    AddImageDraw(dst, paint, PC::kImageCostPerPixel);
+  }
+
+  void onDrawAtlas(const SkImage* image,
+                   const SkRSXform xform[],
+                   const SkRect tex[],
+                   const SkColor colors[],
+                   int count,
+                   SkBlendMode mode,
+                   const SkRect* cull,
+                   const SkPaint* paint) override {
+    onDrawAtlas2(image, xform, tex, colors, count, mode, SkSamplingOptions(),
+                 cull, paint);
+  }
+
+  void onDrawEdgeAAImageSet(const ImageSetEntry set[],
+                            int count,
+                            const SkPoint dst_clips[],
+                            const SkMatrix pre_view_matrices[],
+                            const SkPaint* paint,
+                            SrcRectConstraint constraint) override {
+    onDrawEdgeAAImageSet2(set, count, dst_clips, pre_view_matrices,
+                          SkSamplingOptions(), paint, constraint);
+  }
+#endif
+
+  void onDrawImage2(const SkImage* image,
+                    SkScalar left,
+                    SkScalar top,
+                    const SkSamplingOptions& sampling,
+                    const SkPaint* paint) override {
+    AddImageDraw(SkRect::MakeXYWH(left, top, image->width(), image->height()),
+                 paint, ImageCostPerPixel(sampling));
+  }
+
+  void onDrawImageRect2(const SkImage* image,
+                        const SkRect& src,
+                        const SkRect& dst,
+                        const SkSamplingOptions& sampling,
+                        const SkPaint* paint,
+                        SrcRectConstraint constraint) override {
+    AddImageDraw(dst, paint, ImageCostPerPixel(sampling));
+  }
+
+  void onDrawImageLattice2(const SkImage* image,
+                           const Lattice& lattice,
+                           const SkRect& dst,
+                           SkFilterMode filter,
+                           const SkPaint* paint) override {
+    AddImageDraw(dst, paint,
+                 filter == SkFilterMode::kNearest
+                     ? PC::kImageCostPerPixel
+                     : PC::kFilteredImageCostPerPixel);
+  }
+
+  void onDrawAtlas2(const SkImage* image,
+                    const SkRSXform xform[],
+                    const SkRect tex[],
+                    const SkColor colors[],
+                    int count,
+                    SkBlendMode mode,
+                    const SkSamplingOptions& sampling,
+                    const SkRect* cull,
+                    const SkPaint* paint) override {
+    // Sprites are rotated and scaled by their RSXform, so sum up their
+    // individual areas instead of mapping a single bounding box.
+    double local_area = 0;
+    for (int i = 0; i < count; i++) {
+      const double scale_squared = xform[i].fSCos * xform[i].fSCos +
+                                   xform[i].fSSin * xform[i].fSSin;
+      local_area += tex[i].width() * tex[i].height() * scale_squared;
+    }
+    double area = local_area * LocalToDeviceAreaScale();
+    if (cull) {
+      area = std::min(area, DeviceArea(*cull));
+    }
+    double cost_per_pixel = ImageCostPerPixel(sampling);
+    if (paint) {
+      cost_per_pixel += PaintCostPerPixel(*paint);
+    }
+    AddOp(area * cost_per_pixel);
+  }
+
+  void onDrawVerticesObject(const SkVertices* vertices,
+                            SkBlendMode mode,
+                            const SkPaint& paint) override {
+    AddDraw(vertices->bounds(), paint, PC::kVerticesCostPerPixel);
+  }
+
+  void onDrawPatch(const SkPoint cubics[12],
+                   const SkColor colors[4],
+                   const SkPoint tex_coords[4],
+                   SkBlendMode mode,
+                   const SkPaint& paint) override {
+    SkRect bounds;
+    bounds.setBounds(cubics, 12);
+    AddDraw(bounds, paint, PC::kVerticesCostPerPixel);
+  }
+
+  void onDrawShadowRec(const SkPath& path, const SkDrawShadowRec&) override {
+    AddOp(DeviceArea(path.getBounds()) * PC::kShadowCostPerPixel);
+  }
+
+  void onDrawEdgeAAQuad(const SkRect& rect,
+                        const SkPoint clip[4],
+                        QuadAAFlags aa,
+                        const SkColor4f& color,
+                        SkBlendMode mode) override {
+    AddOp(DeviceArea(rect) * PC::kRectCostPerPixel);
+  }
+
+  void onDrawEdgeAAImageSet2(const ImageSetEntry set[],
+                             int count,
+                             const SkPoint dst_clips[],
+                             const SkMatrix pre_view_matrices[],
+                             const SkSamplingOptions& sampling,
+                             const SkPaint* paint,
+                             SrcRectConstraint constraint) override {
+    for (int i = 0; i < count; i++) {
+      AddImageDraw(set[i].fDstRect, paint, ImageCostPerPixel(sampling));
+    }
+  }
+
+ private:
+  PictureComplexity* complexity_;
+
+  void AddOp(double cost) {
+    complexity_->raster_cost += PC::kOpCost + cost;
+    complexity_->op_count++;
+  }
+
+  // Adds an op that covers |bounds| (before the paint is applied) with the
+  // given per-pixel cost, plus any cost that does not depend on the area.
+  void AddDraw(const SkRect& bounds,
+               const SkPaint& paint,
+               double cost_per_pixel,
+               double fixed_cost = 0) {
+    AddOp(PaintedArea(bounds, paint) *
+              (cost_per_pixel + PaintCostPerPixel(paint)) +
+          fixed_cost);
+  }
+
+  void AddImageDraw(const SkRect& dst,
+                    const SkPaint* paint,
+                    double cost_per_pixel) {
+    if (paint) {
+      AddDraw(dst, *paint, cost_per_pixel);
+    } else {
+      AddOp(DeviceArea(dst) * cost_per_pixel);
+    }
+  }
+
+  static double PaintCostPerPixel(const SkPaint& paint) {
+    double cost = 0;
+    if (paint.getShader()) {
+      cost += PC::kShaderCostPerPixel;
+    }
+    if (paint.getMaskFilter()) {
+      cost += PC::kMaskFilterCostPerPixel;
+    }
+    if (paint.getImageFilter()) {
+      cost += PC::kImageFilterCostPerPixel;
+    }
+    return cost;
+  }
+
+  static double PathCostPerPixel(const SkPaint& paint) {
+    return paint.isAntiAlias() ? PC::kAntiAliasedPathCostPerPixel
+                               : PC::kPathCostPerPixel;
+  }
+
+  static double ImageCostPerPixel(const SkSamplingOptions& sampling) {
+    if (sampling.useCubic || sampling.filter != SkFilterMode::kNearest) {
+      return PC::kFilteredImageCostPerPixel;
+    }
+    return PC::kImageCostPerPixel;
+  }
+
+  // The number of device pixels a draw of |bounds| with |paint| touches.
+  double PaintedArea(const SkRect& bounds, const SkPaint& paint) {
+    if (!paint.canComputeFastBounds()) {
+      return ClipArea();
+    }
+    SkRect storage;
+    const SkRect& painted = paint.computeFastBounds(bounds, &storage);
+    const SkRect device = DeviceRect(painted);
+    double area = device.width() * device.height();
+    if (paint.getStyle() != SkPaint::kFill_Style) {
+      // Strokes only touch the pixels along the outline.
+      const SkScalar max_scale = getTotalMatrix().getMaxScale();
+      const double stroke_width = std::max(
+          1.0, static_cast<double>(paint.getStrokeWidth()) *
+                   (max_scale > 0 ? max_scale : 1.0));
+      const double perimeter = 2.0 * (device.width() + device.height());
+      area = std::min(area, perimeter * stroke_width);
+    }
+    return area;
+  }
+
+  SkRect DeviceRect(const SkRect& local) {
+    SkRect device = getTotalMatrix().mapRect(local);
+    if (!device.intersect(SkRect::Make(getDeviceClipBounds()))) {
+      return SkRect::MakeEmpty();
+    }
+    return device;
+  }
+
+  double DeviceArea(const SkRect& local) {
+    const SkRect device = DeviceRect(local);
+    return device.width() * device.height();
+  }
+
+  double ClipArea() {
+    const SkIRect clip = getDeviceClipBounds();
+    return static_cast<double>(clip.width()) * clip.height();
+  }
+
+  double LocalToDeviceAreaScale() {
+    const SkScalar max_scale = getTotalMatrix().getMaxScale();
+    return max_scale > 0 ? max_scale * max_scale : 1.0;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ComplexityCanvas);
+};
+
+}  // namespace
+
+PictureComplexity PictureComplexity::Compute(const SkPicture* picture) {
+  TRACE_EVENT0("flutter", "PictureComplexity::Compute");
+  PictureComplexity complexity;
+  if (picture == nullptr) {
+    return complexity;
+  }
+
+  const SkRect cull_rect = picture->cullRect();
+  if (cull_rect.isEmpty() || !cull_rect.isFinite()) {
+    return complexity;
+  }
+
+  complexity.cull_area =
+      static_cast<double>(cull_rect.width()) * cull_rect.height();
+  ComplexityCanvas canvas(cull_rect.roundOut(), &complexity);
+  picture->playback(&canvas);
+  return complexity;
+}
+
+}  // namespace flutter
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PICTURE_COMPLEXITY_H_
+#define FLUTTER_FLOW_PICTURE_COMPLEXITY_H_
+
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace flutter {
+
+// An estimate of how expensive an SkPicture is to rasterize.
+//
+// Costs are expressed in "fill units": the time it takes the software
+// rasterizer to fill one pixel with an opaque, non-antialiased solid color.
+// The per-op weights below are rough estimates of how the ops compare to
+// each other, not measurements. Only their ratios matter, and only to the
+// extent of telling cheap pictures from expensive ones. The benchmarks in
+// picture_complexity_benchmarks.cc time each kind of op and can be used to
+// derive measured weights.
+struct PictureComplexity {
+  // Fixed setup cost of any draw op, independent of the pixels it touches.
+  static constexpr double kOpCost = 64.0;
+
+  // Per-pixel costs of the basic primitives.
+  static constexpr double kRectCostPerPixel = 1.0;
+  static constexpr double kRRectCostPerPixel = 1.5;
+  static constexpr double kPathCostPerPixel = 1.5;
+  static constexpr double kAntiAliasedPathCostPerPixel = 3.0;
+  static constexpr double kTextCostPerPixel = 2.0;
+  static constexpr double kImageCostPerPixel = 1.5;
+  static constexpr double kFilteredImageCostPerPixel = 3.0;
+  static constexpr double kVerticesCostPerPixel = 2.0;
+  static constexpr double kShadowCostPerPixel = 12.0;
+
+  // Per-item costs of the basic primitives.
+  static constexpr double kPathCostPerVerb = 4.0;
+  static constexpr double kTextCostPerGlyph = 24.0;
+
+  // Additional per-pixel costs contributed by the SkPaint.
+  static constexpr double kShaderCostPerPixel = 1.0;
+  static constexpr double kMaskFilterCostPerPixel = 10.0;
+  static constexpr double kImageFilterCostPerPixel = 12.0;
+
+  // Cost of allocating, clearing and compositing a saveLayer, per pixel of
+  // the layer bounds.
+  static constexpr double kSaveLayerCostPerPixel = 2.0;
+
+  // How much more expensive than blitting a cached image a picture has to be
+  // before it is worth rasterizing into the raster cache.
+  static constexpr double kRasterCacheMinCostRatio = 2.0;
+
+  // Estimated cost of playing back the whole picture once.
+  double raster_cost = 0;
+
+  // Area of the picture's cull rect in local coordinates.
+  double cull_area = 0;
+
+  // Number of draw and saveLayer ops seen while walking the picture,
+  // including the ops of nested pictures.
+  int op_count = 0;
+
+  double CostPerPixel() const {
+    return cull_area > 0 ? raster_cost / cull_area : 0;
+  }
+
+  // The estimated cost of drawing a raster cache entry of this picture.
+  double CachedDrawCost() const {
+    return kOpCost + cull_area * kImageCostPerPixel;
+  }
+
+  // Whether drawing the picture every frame is sufficiently more expensive
+  // than drawing a cached image of it.
+  bool IsWorthRasterCaching() const {
+    return raster_cost >= kRasterCacheMinCostRatio * CachedDrawCost();
+  }
+
+  // Walks the ops of |picture| and accumulates their estimated cost.
+  static PictureComplexity Compute(const SkPicture* picture);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_PICTURE_COMPLEXITY_H_
@@ -0,0 +1,199 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_complexity.h"
+
+#include <functional>
+#include <string>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkMaskFilter.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/effects/SkGradientShader.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
+// These benchmarks time the software rasterization of each kind of op that
+// PictureComplexity assigns a weight to. The reported items per second are
+// pixels per second, so the relative per-pixel cost of an op is the
+// BM_SolidRect rate divided by the rate of that op. The weights in
+// picture_complexity.h are estimates that these rates can replace.
+
+namespace flutter {
+
+namespace {
+
+constexpr int kSurfaceSize = 512;
+constexpr SkRect kBounds = SkRect::MakeWH(kSurfaceSize, kSurfaceSize);
+
+using DrawFunction = std::function<void(SkCanvas*)>;
+
+sk_sp<SkPicture> Record(const DrawFunction& draw) {
+  SkPictureRecorder recorder;
+  draw(recorder.beginRecording(kBounds));
+  return recorder.finishRecordingAsPicture();
+}
+
+SkPath MakeStar() {
+  SkPath path;
+  path.moveTo(kSurfaceSize / 2, 0);
+  path.lineTo(kSurfaceSize, kSurfaceSize);
+  path.lineTo(0, kSurfaceSize / 2);
+  path.lineTo(kSurfaceSize, kSurfaceSize / 2);
+  path.lineTo(0, kSurfaceSize);
+  path.close();
+  return path;
+}
+
+// Rasterizes |draw| into a software surface and reports throughput in pixels
+// of the surface. The estimated cost per pixel is reported as a label so it
+// can be compared against the measured rate.
+void RunRasterBenchmark(benchmark::State& state, const DrawFunction& draw) {
+  auto surface = SkSurface::MakeRasterN32Premul(kSurfaceSize, kSurfaceSize);
+  SkCanvas* canvas = surface->getCanvas();
+  sk_sp<SkPicture> picture = Record(draw);
+
+  while (state.KeepRunning()) {
+    canvas->clear(SK_ColorTRANSPARENT);
+    picture->playback(canvas);
+    surface->flushAndSubmit(true);
+  }
+
+  PictureComplexity complexity = PictureComplexity::Compute(picture.get());
+  state.SetItemsProcessed(state.iterations() * kSurfaceSize * kSurfaceSize);
+  state.SetLabel("estimated cost/pixel: " +
+                 std::to_string(complexity.CostPerPixel()));
+}
+
+}  // namespace
+
+static void BM_SolidRect(benchmark::State& state) {
+  RunRasterBenchmark(state, [](SkCanvas* canvas) {
+    canvas->drawRect(kBounds, SkPaint(SkColors::kRed));
+  });
+}
+BENCHMARK(BM_SolidRect);
+
+static void BM_GradientRect(benchmark::State& state) {
+  RunRasterBenchmark(state, [](SkCanvas* canvas) {
+    const SkPoint points[] = {{0, 0}, {kSurfaceSize, kSurfaceSize}};
+    const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+    SkPaint paint;
+    paint.setShader(SkGradientShader::MakeLinear(points, colors, nullptr, 2,
+                                                 SkTileMode::kClamp));
+    canvas->drawRect(kBounds, paint);
+  });
+}
+BENCHMARK(BM_GradientRect);
+
+static void BM_RRect(benchmark::State& state) {
+  RunRasterBenchmark(state, [](SkCanvas* canvas) {
+    SkPaint paint(SkColors::kRed);
+    paint.setAntiAlias(true);
+    canvas->drawRRect(SkRRect::MakeRectXY(kBounds, 32, 32), paint);
+  });
+}
+BENCHMARK(BM_RRect);
+
+static void BM_Path(benchmark::State& state) {
+  RunRasterBenchmark(state, [](SkCanvas* canvas) {
+    canvas->drawPath(MakeStar(), SkPaint(SkColors::kRed));
+  });
+}
+BENCHMARK(BM_Path);
+
+static void BM_AntiAliasedPath(benchmark::State& state) {
+  RunRasterBenchmark(state, [](SkCanvas* canvas) {
+    SkPaint paint(SkColors::kRed);
+    paint.setAntiAlias(true);
+    canvas->drawPath(MakeStar(), paint);
+  });
+}
+BENCHMARK(BM_AntiAliasedPath);
+
+static void BM_BlurMaskFilter(benchmark::State& state) {
+  RunRasterBenchmark(state, [](SkCanvas* canvas) {
+    SkPaint paint(SkColors::kRed);
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 8));
+    canvas->drawRect(kBounds.makeInset(16, 16), paint);
+  });
+}
+BENCHMARK(BM_BlurMaskFilter);
+
+static void BM_SaveLayer(benchmark::State& state) {
+  RunRasterBenchmark(state, [](SkCanvas* canvas) {
+    canvas->saveLayerAlpha(nullptr, 0x80);
+    canvas->drawRect(kBounds, SkPaint(SkColors::kRed));
+    canvas->restore();
+  });
+}
+BENCHMARK(BM_SaveLayer);
+
+static void BM_SaveLayerWithImageFilter(benchmark::State& state) {
+  RunRasterBenchmark(state, [](SkCanvas* canvas) {
+    SkPaint layer_paint;
+    layer_paint.setImageFilter(SkImageFilters::Blur(8, 8, nullptr));
+    canvas->saveLayer(nullptr, &layer_paint);
+    canvas->drawRect(kBounds, SkPaint(SkColors::kRed));
+    canvas->restore();
+  });
+}
+BENCHMARK(BM_SaveLayerWithImageFilter);
+
+static void BM_Text(benchmark::State& state) {
+  RunRasterBenchmark(state, [](SkCanvas* canvas) {
+    SkFont font;
+    font.setSize(14);
+    auto blob = SkTextBlob::MakeFromString(
+        "The quick brown fox jumps over the lazy dog", font);
+    SkPaint paint(SkColors::kBlack);
+    for (int y = 16; y < kSurfaceSize; y += 16) {
+      canvas->drawTextBlob(blob, 0, y, paint);
+    }
+  });
+}
+BENCHMARK(BM_Text);
+
+static void BM_Image(benchmark::State& state) {
+  auto source = SkSurface::MakeRasterN32Premul(kSurfaceSize, kSurfaceSize);
+  source->getCanvas()->clear(SK_ColorBLUE);
+  sk_sp<SkImage> image = source->makeImageSnapshot();
+  RunRasterBenchmark(state, [image](SkCanvas* canvas) {
+    canvas->drawImage(image, 0, 0);
+  });
+}
+BENCHMARK(BM_Image);
+
+static void BM_FilteredImage(benchmark::State& state) {
+  auto source = SkSurface::MakeRasterN32Premul(kSurfaceSize, kSurfaceSize);
+  source->getCanvas()->clear(SK_ColorBLUE);
+  sk_sp<SkImage> image = source->makeImageSnapshot();
+  RunRasterBenchmark(state, [image](SkCanvas* canvas) {
+    canvas->drawImageRect(image, kBounds.makeInset(0.5, 0.5), kBounds,
+                          SkSamplingOptions(SkFilterMode::kLinear), nullptr,
+                          SkCanvas::kFast_SrcRectConstraint);
+  });
+}
+BENCHMARK(BM_FilteredImage);
+
+static void BM_ComputeComplexity(benchmark::State& state) {
+  sk_sp<SkPicture> picture = Record([](SkCanvas* canvas) {
+    SkPaint paint(SkColors::kRed);
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 100; i++) {
+      canvas->drawRect(SkRect::MakeXYWH(i, i, 10, 10), paint);
+      canvas->drawPath(MakeStar(), paint);
+    }
+  });
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(PictureComplexity::Compute(picture.get()));
+  }
+}
+BENCHMARK(BM_ComputeComplexity);
+
+}  // namespace flutter
@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_complexity.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkMaskFilter.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+template <typename F>
+sk_sp<SkPicture> RecordPicture(const SkRect& bounds, F draw) {
+  SkPictureRecorder recorder;
+  draw(recorder.beginRecording(bounds));
+  return recorder.finishRecordingAsPicture();
+}
+
+SkPath MakeStar(const SkRect& bounds) {
+  SkPath path;
+  path.moveTo(bounds.centerX(), bounds.top());
+  path.lineTo(bounds.right(), bounds.bottom());
+  path.lineTo(bounds.left(), bounds.centerY());
+  path.lineTo(bounds.right(), bounds.centerY());
+  path.lineTo(bounds.left(), bounds.bottom());
+  path.close();
+  return path;
+}
+
+}  // namespace
+
+TEST(PictureComplexity, NullAndEmptyPicturesHaveNoCost) {
+  PictureComplexity null_complexity = PictureComplexity::Compute(nullptr);
+  EXPECT_EQ(null_complexity.raster_cost, 0);
+  EXPECT_EQ(null_complexity.op_count, 0);
+
+  auto placeholder = SkPicture::MakePlaceholder(SkRect::MakeWH(100, 100));
+  PictureComplexity placeholder_complexity =
+      PictureComplexity::Compute(placeholder.get());
+  EXPECT_EQ(placeholder_complexity.raster_cost, 0);
+  EXPECT_EQ(placeholder_complexity.op_count, 0);
+  EXPECT_FALSE(placeholder_complexity.IsWorthRasterCaching());
+}
+
+TEST(PictureComplexity, SolidRectIsNotWorthCaching) {
+  auto picture = RecordPicture(SkRect::MakeWH(100, 100), [](SkCanvas* canvas) {
+    canvas->drawRect(SkRect::MakeWH(100, 100), SkPaint());
+  });
+  PictureComplexity complexity = PictureComplexity::Compute(picture.get());
+  EXPECT_EQ(complexity.op_count, 1);
+  EXPECT_DOUBLE_EQ(complexity.cull_area, 100 * 100);
+  EXPECT_DOUBLE_EQ(complexity.raster_cost,
+                   PictureComplexity::kOpCost +
+                       100 * 100 * PictureComplexity::kRectCostPerPixel);
+  EXPECT_FALSE(complexity.IsWorthRasterCaching());
+}
+
+TEST(PictureComplexity, ManyCheapOpsAreNotWorthCaching) {
+  auto picture = RecordPicture(SkRect::MakeWH(100, 100), [](SkCanvas* canvas) {
+    for (int i = 0; i < 10; i++) {
+      canvas->drawRect(SkRect::MakeXYWH(i * 10, 0, 10, 10), SkPaint());
+    }
+  });
+  PictureComplexity complexity = PictureComplexity::Compute(picture.get());
+  EXPECT_EQ(complexity.op_count, 10);
+  EXPECT_FALSE(complexity.IsWorthRasterCaching());
+}
+
+TEST(PictureComplexity, SingleBlurIsWorthCaching) {
+  auto picture = RecordPicture(SkRect::MakeWH(100, 100), [](SkCanvas* canvas) {
+    SkPaint paint;
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 5));
+    canvas->drawRect(SkRect::MakeXYWH(10, 10, 80, 80), paint);
+  });
+  PictureComplexity complexity = PictureComplexity::Compute(picture.get());
+  EXPECT_EQ(complexity.op_count, 1);
+  EXPECT_TRUE(complexity.IsWorthRasterCaching());
+}
+
+TEST(PictureComplexity, SaveLayerWithImageFilterIsWorthCaching) {
+  auto picture = RecordPicture(SkRect::MakeWH(100, 100), [](SkCanvas* canvas) {
+    SkPaint layer_paint;
+    layer_paint.setImageFilter(SkImageFilters::Blur(5, 5, nullptr));
+    canvas->saveLayer(nullptr, &layer_paint);
+    canvas->drawRect(SkRect::MakeWH(100, 100), SkPaint());
+    canvas->restore();
+  });
+  PictureComplexity complexity = PictureComplexity::Compute(picture.get());
+  EXPECT_EQ(complexity.op_count, 2);
+  EXPECT_TRUE(complexity.IsWorthRasterCaching());
+}
+
+TEST(PictureComplexity, AntiAliasedPathsCostMoreThanAliasedPaths) {
+  const SkRect bounds = SkRect::MakeWH(100, 100);
+  auto picture_for = [&bounds](bool anti_alias) {
+    return RecordPicture(bounds, [&bounds, anti_alias](SkCanvas* canvas) {
+      SkPaint paint;
+      paint.setAntiAlias(anti_alias);
+      canvas->drawPath(MakeStar(bounds), paint);
+    });
+  };
+  PictureComplexity aliased =
+      PictureComplexity::Compute(picture_for(false).get());
+  PictureComplexity anti_aliased =
+      PictureComplexity::Compute(picture_for(true).get());
+  EXPECT_GT(anti_aliased.raster_cost, aliased.raster_cost);
+  EXPECT_GT(anti_aliased.CostPerPixel(), aliased.CostPerPixel());
+}
+
+TEST(PictureComplexity, ClippedOutOpsOnlyPayTheOpCost) {
+  auto picture = RecordPicture(SkRect::MakeWH(100, 100), [](SkCanvas* canvas) {
+    canvas->clipRect(SkRect::MakeWH(10, 10));
+    SkPaint paint;
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 5));
+    canvas->drawRect(SkRect::MakeXYWH(50, 50, 40, 40), paint);
+  });
+  PictureComplexity complexity = PictureComplexity::Compute(picture.get());
+  EXPECT_EQ(complexity.op_count, 1);
+  EXPECT_DOUBLE_EQ(complexity.raster_cost, PictureComplexity::kOpCost);
+}
+
+TEST(PictureComplexity, TransformScalesCost) {
+  auto draw_scaled = [](SkScalar scale) {
+    return RecordPicture(SkRect::MakeWH(100, 100), [scale](SkCanvas* canvas) {
+      canvas->scale(scale, scale);
+      canvas->drawRect(SkRect::MakeWH(10, 10), SkPaint());
+    });
+  };
+  PictureComplexity small = PictureComplexity::Compute(draw_scaled(1).get());
+  PictureComplexity large = PictureComplexity::Compute(draw_scaled(4).get());
+  EXPECT_DOUBLE_EQ(small.raster_cost - PictureComplexity::kOpCost, 10 * 10);
+  EXPECT_DOUBLE_EQ(large.raster_cost - PictureComplexity::kOpCost, 40 * 40);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_fingerprint.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace flutter {
+
+namespace {
+
+// An SkWStream that hashes the bytes written to it with MurmurHash64A instead
+// of storing them, so that fingerprinting a picture doesn't allocate a buffer
+// for its serialization.
+class HashingStream : public SkWStream {
+ public:
+  bool write(const void* buffer, size_t size) override {
+    const uint8_t* bytes = static_cast<const uint8_t*>(buffer);
+    bytes_written_ += size;
+
+    if (pending_length_ > 0) {
+      const size_t count = std::min(size, sizeof(pending_) - pending_length_);
+      memcpy(pending_ + pending_length_, bytes, count);
+      pending_length_ += count;
+      bytes += count;
+      size -= count;
+      if (pending_length_ < sizeof(pending_)) {
+        return true;
+      }
+      MixWord(pending_);
+      pending_length_ = 0;
+    }
+
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+      MixWord(bytes);
+      bytes += sizeof(uint64_t);
+    }
+
+    memcpy(pending_, bytes, size);
+    pending_length_ = size;
+    return true;
+  }
+
+  size_t bytesWritten() const override { return bytes_written_; }
+
+  uint64_t Finish() {
+    uint64_t hash = hash_ ^ (bytes_written_ * kMultiplier);
+    if (pending_length_ > 0) {
+      uint8_t tail[sizeof(uint64_t)] = {};
+      memcpy(tail, pending_, pending_length_);
+      uint64_t word;
+      memcpy(&word, tail, sizeof(word));
+      hash ^= word;
+      hash *= kMultiplier;
+    }
+    hash ^= hash >> kShift;
+    hash *= kMultiplier;
+    hash ^= hash >> kShift;
+    return hash;
+  }
+
+ private:
+  static constexpr uint64_t kMultiplier = 0xc6a4a7935bd1e995ull;
+  static constexpr int kShift = 47;
+
+  void MixWord(const uint8_t* bytes) {
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    word *= kMultiplier;
+    word ^= word >> kShift;
+    word *= kMultiplier;
+    hash_ ^= word;
+    hash_ *= kMultiplier;
+  }
+
+  uint64_t hash_ = 0;
+  size_t bytes_written_ = 0;
+  uint8_t pending_[sizeof(uint64_t)];
+  size_t pending_length_ = 0;
+};
+
+sk_sp<SkData> SerializeImageId(SkImage* image, void* context) {
+  const uint32_t id = image->uniqueID();
+  return SkData::MakeWithCopy(&id, sizeof(id));
+}
+
+sk_sp<SkData> SerializeTypefaceId(SkTypeface* typeface, void* context) {
+  const SkTypefaceID id = typeface->uniqueID();
+  return SkData::MakeWithCopy(&id, sizeof(id));
+}
+
+}  // namespace
+
+PictureFingerprint ComputePictureFingerprint(const SkPicture& picture) {
+  TRACE_EVENT0("flutter", "ComputePictureFingerprint");
+  const SkSerialProcs procs = MakePictureFingerprintSerialProcs();
+
+  HashingStream stream;
+  picture.serialize(&stream, &procs);
+  // Unique IDs are 32 bits, so setting the top bit keeps fingerprints apart
+  // from them.
+  return stream.Finish() | (uint64_t{1} << 63);
+}
+
+SkSerialProcs MakePictureFingerprintSerialProcs() {
+  SkSerialProcs procs;
+  procs.fImageProc = SerializeImageId;
+  procs.fTypefaceProc = SerializeTypefaceId;
+  return procs;
+}
+
+}  // namespace flutter
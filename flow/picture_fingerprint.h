@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PICTURE_FINGERPRINT_H_
+#define FLUTTER_FLOW_PICTURE_FINGERPRINT_H_
+
+#include <cstdint>
+
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+
+namespace flutter {
+
+// A fingerprint that identifies pictures by what they draw rather than by
+// which recording produced them. The raster cache keys pictures that have one
+// by it, so that a picture which is re-recorded with identical content hits
+// the entry of its predecessor.
+//
+// The fingerprint is a hash of the serialized ops of the picture. Images and
+// typefaces are hashed by their unique ID rather than by their pixels or font
+// data, which keeps computing it cheap and is exact because Skia never reuses
+// those IDs for different content.
+using PictureFingerprint = uint64_t;
+
+// The fingerprint of pictures that don't have one. Such pictures are cached
+// by their |SkPicture::uniqueID|.
+constexpr PictureFingerprint kNoPictureFingerprint = 0;
+
+// Computes the fingerprint of |picture|. The result is never
+// |kNoPictureFingerprint| and never equal to the unique ID of any picture.
+PictureFingerprint ComputePictureFingerprint(const SkPicture& picture);
+
+// The procs that |ComputePictureFingerprint| serializes pictures with, which
+// write images and typefaces as their unique IDs. Anything else that tells
+// pictures apart by their serialization should use these too, so that it
+// agrees with the fingerprint on which pictures draw the same.
+SkSerialProcs MakePictureFingerprintSerialProcs();
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_PICTURE_FINGERPRINT_H_
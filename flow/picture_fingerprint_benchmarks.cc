@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_fingerprint.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+// Compares the cost of fingerprinting a picture with the cost of recording
+// it, which is what PictureRecorder.endRecording adds the fingerprint to.
+
+namespace flutter {
+
+namespace {
+
+// Records |op_count| ops that are typical of framework pictures: rects,
+// rounded rects and short runs of text.
+sk_sp<SkPicture> RecordPicture(int64_t op_count) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(1000, 1000));
+  SkPaint paint;
+  SkFont font;
+  sk_sp<SkTextBlob> blob = SkTextBlob::MakeFromString("Hello world", font);
+  for (int64_t i = 0; i < op_count; i++) {
+    paint.setColor(SkColorSetARGB(255, i % 256, 0, 0));
+    SkRect rect = SkRect::MakeXYWH(i % 100 * 10, i / 100 % 100 * 10, 10, 10);
+    switch (i % 3) {
+      case 0:
+        canvas->drawRect(rect, paint);
+        break;
+      case 1:
+        canvas->drawRRect(SkRRect::MakeRectXY(rect, 2, 2), paint);
+        break;
+      case 2:
+        canvas->drawTextBlob(blob, rect.x(), rect.y(), paint);
+        break;
+    }
+  }
+  return recorder.finishRecordingAsPicture();
+}
+
+void BM_RecordPicture(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(RecordPicture(state.range(0)));
+  }
+}
+
+void BM_ComputePictureFingerprint(benchmark::State& state) {
+  sk_sp<SkPicture> picture = RecordPicture(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(ComputePictureFingerprint(*picture));
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_RecordPicture)->Range(1, 1 << 12);
+BENCHMARK(BM_ComputePictureFingerprint)->Range(1, 1 << 12);
+
+}  // namespace flutter
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_fingerprint.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+template <typename F>
+sk_sp<SkPicture> RecordPicture(F draw) {
+  SkPictureRecorder recorder;
+  draw(recorder.beginRecording(SkRect::MakeWH(100, 100)));
+  return recorder.finishRecordingAsPicture();
+}
+
+sk_sp<SkPicture> RecordRect(SkColor color) {
+  return RecordPicture([color](SkCanvas* canvas) {
+    SkPaint paint;
+    paint.setColor(color);
+    canvas->drawRect(SkRect::MakeXYWH(10, 10, 80, 80), paint);
+  });
+}
+
+sk_sp<SkImage> MakeImage(SkColor color) {
+  auto surface = SkSurface::MakeRasterN32Premul(10, 10);
+  surface->getCanvas()->clear(color);
+  return surface->makeImageSnapshot();
+}
+
+}  // namespace
+
+TEST(PictureFingerprint, IdenticalRecordingsHaveTheSameFingerprint) {
+  auto first = RecordRect(SK_ColorRED);
+  auto second = RecordRect(SK_ColorRED);
+  ASSERT_NE(first->uniqueID(), second->uniqueID());
+  EXPECT_EQ(ComputePictureFingerprint(*first),
+            ComputePictureFingerprint(*second));
+}
+
+TEST(PictureFingerprint, DifferentContentHasDifferentFingerprints) {
+  EXPECT_NE(ComputePictureFingerprint(*RecordRect(SK_ColorRED)),
+            ComputePictureFingerprint(*RecordRect(SK_ColorBLUE)));
+
+  auto translated = RecordPicture([](SkCanvas* canvas) {
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeXYWH(11, 10, 80, 80), paint);
+  });
+  EXPECT_NE(ComputePictureFingerprint(*RecordRect(SK_ColorRED)),
+            ComputePictureFingerprint(*translated));
+}
+
+TEST(PictureFingerprint, ImagesAreIdentifiedByUniqueId) {
+  sk_sp<SkImage> image = MakeImage(SK_ColorRED);
+  auto draw_image = [](const sk_sp<SkImage>& image) {
+    return RecordPicture(
+        [&image](SkCanvas* canvas) { canvas->drawImage(image, 0, 0); });
+  };
+
+  EXPECT_EQ(ComputePictureFingerprint(*draw_image(image)),
+            ComputePictureFingerprint(*draw_image(image)));
+  // Same pixels, but a different image.
+  EXPECT_NE(ComputePictureFingerprint(*draw_image(image)),
+            ComputePictureFingerprint(*draw_image(MakeImage(SK_ColorRED))));
+}
+
+TEST(PictureFingerprint, NeverMatchesAUniqueId) {
+  auto picture = RecordPicture([](SkCanvas* canvas) {});
+  PictureFingerprint fingerprint = ComputePictureFingerprint(*picture);
+  EXPECT_NE(fingerprint, kNoPictureFingerprint);
+  EXPECT_GT(fingerprint, UINT32_MAX);
+}
+
+}  // namespace testing
+}  // namespace flutter
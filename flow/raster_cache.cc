@@ -4,6 +4,9 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 #include "flutter/common/constants.h"
@@ -35,12 +38,155 @@ void RasterCacheResult::draw(SkCanvas& canvas, const SkPaint* paint) const {
   canvas.drawImage(image_, bounds.fLeft, bounds.fTop, paint);
 }
 
+void RasterCacheResult::drawScaled(SkCanvas& canvas,
+                                   const SkMatrix& raster_matrix,
+                                   const SkPaint* paint) const {
+  TRACE_EVENT0("flutter", "RasterCacheResult::drawScaled");
+  SkMatrix inverse;
+  if (!raster_matrix.invert(&inverse)) {
+    return;
+  }
+  // The image covers the device bounds of the logical rect when it was
+  // rasterized, which are rounded out, so map those back rather than drawing
+  // the image into the logical rect itself.
+  SkRect image_rect =
+      SkRect::Make(RasterCache::GetDeviceBounds(logical_rect_, raster_matrix));
+  inverse.mapRect(&image_rect);
+  canvas.drawImageRect(image_, SkRect::Make(image_->bounds()), image_rect,
+                       SkSamplingOptions(SkFilterMode::kLinear), paint,
+                       SkCanvas::kFast_SrcRectConstraint);
+}
+
+namespace {
+
+// The result of rasterizing into a region of a |RasterCacheAtlas| page.
+class AtlasRasterCacheResult : public RasterCacheResult {
+ public:
+  AtlasRasterCacheResult(std::unique_ptr<RasterCacheAtlas::Region> region,
+                         const SkRect& logical_rect)
+      : RasterCacheResult(nullptr, logical_rect),
+        region_(std::move(region)),
+        logical_rect_(logical_rect) {}
+
+  void draw(SkCanvas& canvas, const SkPaint* paint) const override {
+    TRACE_EVENT0("flutter", "RasterCacheResult::draw");
+    SkAutoCanvasRestore auto_restore(&canvas, true);
+    SkIRect bounds =
+        RasterCache::GetDeviceBounds(logical_rect_, canvas.getTotalMatrix());
+    const SkIRect& rect = region_->rect();
+    FML_DCHECK(std::abs(bounds.size().width() - rect.width()) <= 1 &&
+               std::abs(bounds.size().height() - rect.height()) <= 1);
+    canvas.resetMatrix();
+    canvas.drawImageRect(region_->GetPageImage(), SkRect::Make(rect),
+                         SkRect::MakeXYWH(bounds.fLeft, bounds.fTop,
+                                          rect.width(), rect.height()),
+                         SkSamplingOptions(), paint,
+                         SkCanvas::kFast_SrcRectConstraint);
+  }
+
+  void drawScaled(SkCanvas& canvas,
+                  const SkMatrix& raster_matrix,
+                  const SkPaint* paint) const override {
+    TRACE_EVENT0("flutter", "RasterCacheResult::drawScaled");
+    SkMatrix inverse;
+    if (!raster_matrix.invert(&inverse)) {
+      return;
+    }
+    SkRect image_rect = SkRect::Make(
+        RasterCache::GetDeviceBounds(logical_rect_, raster_matrix));
+    inverse.mapRect(&image_rect);
+    canvas.drawImageRect(region_->GetPageImage(),
+                         SkRect::Make(region_->rect()), image_rect,
+                         SkSamplingOptions(SkFilterMode::kLinear), paint,
+                         SkCanvas::kStrict_SrcRectConstraint);
+  }
+
+  SkISize image_dimensions() const override { return region_->rect().size(); }
+
+  int64_t image_bytes() const override {
+    return SkImageInfo::MakeN32Premul(image_dimensions()).computeMinByteSize();
+  }
+
+ private:
+  std::unique_ptr<RasterCacheAtlas::Region> region_;
+  SkRect logical_rect_;
+};
+
+}  // namespace
+
 RasterCache::RasterCache(size_t access_threshold,
                          size_t picture_cache_limit_per_frame)
     : access_threshold_(access_threshold),
       picture_cache_limit_per_frame_(picture_cache_limit_per_frame),
       checkerboard_images_(false) {}
 
+void RasterCache::SetAtlasEnabled(bool enabled) {
+  atlas_enabled_ = enabled;
+}
+
+void RasterCache::SetScaleTolerance(float tolerance) {
+  max_scale_distance_ = tolerance > 0 ? std::log1p(tolerance) : 0;
+}
+
+// Returns how far apart the scales of two matrices are: the larger of the
+// absolute log ratios of the scales of the two axes, or infinity if either
+// matrix isn't a scale or the scales have different signs.
+static float GetScaleDistance(const SkMatrix& a, const SkMatrix& b) {
+  if (!a.isScaleTranslate() || !b.isScaleTranslate()) {
+    return std::numeric_limits<float>::infinity();
+  }
+  const float x_ratio = a.getScaleX() / b.getScaleX();
+  const float y_ratio = a.getScaleY() / b.getScaleY();
+  if (!(x_ratio > 0 && y_ratio > 0)) {
+    return std::numeric_limits<float>::infinity();
+  }
+  return std::max(std::abs(std::log(x_ratio)), std::abs(std::log(y_ratio)));
+}
+
+template <class Cache>
+typename Cache::value_type* RasterCache::FindScaledEntry(
+    Cache& cache,
+    const typename Cache::key_type& key,
+    const SkPicture* picture) const {
+  if (max_scale_distance_ <= 0 || cache.empty()) {
+    return nullptr;
+  }
+  typename Cache::value_type* nearest = nullptr;
+  float nearest_distance = max_scale_distance_;
+  // The hash of a key only depends on its ID, so all the entries of the ID
+  // are in the bucket of |key|.
+  const size_t bucket = cache.bucket(key);
+  for (auto it = cache.begin(bucket); it != cache.end(bucket); ++it) {
+    if (it->first.id() != key.id() || !it->second.image ||
+        !IsEntryOf(it->second, picture)) {
+      continue;
+    }
+    const float distance = GetScaleDistance(key.matrix(), it->first.matrix());
+    if (distance <= nearest_distance) {
+      nearest = &*it;
+      nearest_distance = distance;
+    }
+  }
+  return nearest;
+}
+
+template <class Cache>
+bool RasterCache::HasScaledEntry(Cache& cache,
+                                 const typename Cache::key_type& key,
+                                 const SkPicture* picture) {
+  if (cache.empty()) {
+    return false;
+  }
+  const size_t bucket = cache.bucket(key);
+  for (auto it = cache.begin(bucket); it != cache.end(bucket); ++it) {
+    if (it->first.id() == key.id() && it->second.image &&
+        IsEntryOf(it->second, picture)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static bool CanRasterizePicture(SkPicture* picture) {
   if (picture == nullptr) {
     return false;
@@ -61,9 +207,10 @@ static bool CanRasterizePicture(SkPicture* picture) {
   return true;
 }
 
-static bool IsPictureWorthRasterizing(SkPicture* picture,
-                                      bool will_change,
-                                      bool is_complex) {
+bool RasterCache::IsPictureWorthRasterizing(SkPicture* picture,
+                                            PictureFingerprint fingerprint,
+                                            bool will_change,
+                                            bool is_complex) {
   if (will_change) {
     // If the picture is going to change in the future, there is no point in
     // doing to extra work to rasterize.
@@ -82,9 +229,10 @@ static bool IsPictureWorthRasterizing(SkPicture* picture,
     return true;
   }
 
-  // TODO(abarth): We should find a better heuristic here that lets us avoid
-  // wasting memory on trivial layers that are easy to re-rasterize every frame.
-  return picture->approximateOpCount() > 5;
+  // Cheap pictures are easy to re-rasterize every frame and would only waste
+  // memory, while pictures with a few expensive ops (blurs, saveLayers,
+  // antialiased paths) are worth caching regardless of their op count.
+  return GetPictureComplexity(picture, fingerprint).IsWorthRasterCaching();
 }
 
 /// @note Procedure doesn't copy all closures.
@@ -124,12 +272,53 @@ static std::unique_ptr<RasterCacheResult> Rasterize(
                                              logical_rect);
 }
 
+static std::unique_ptr<RasterCacheResult> RasterizeIntoAtlas(
+    RasterCacheAtlas& atlas,
+    GrDirectContext* context,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space,
+    bool checkerboard,
+    const SkRect& logical_rect,
+    const std::function<void(SkCanvas*)>& draw_function) {
+  SkIRect cache_rect = RasterCache::GetDeviceBounds(logical_rect, ctm);
+  std::unique_ptr<RasterCacheAtlas::Region> region =
+      atlas.Allocate(context, dst_color_space, cache_rect.size());
+  if (!region) {
+    return nullptr;
+  }
+
+  TRACE_EVENT0("flutter", "RasterCachePopulate");
+  region->Draw([&](SkCanvas* canvas) {
+    canvas->translate(-cache_rect.left(), -cache_rect.top());
+    canvas->concat(ctm);
+    draw_function(canvas);
+
+    if (checkerboard) {
+      DrawCheckerboard(canvas, logical_rect);
+    }
+  });
+
+  return std::make_unique<AtlasRasterCacheResult>(std::move(region),
+                                                  logical_rect);
+}
+
 std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
     SkPicture* picture,
     GrDirectContext* context,
     const SkMatrix& ctm,
     SkColorSpace* dst_color_space,
     bool checkerboard) const {
+  // Layers aren't packed into the atlas: rasterizing one can draw pictures
+  // from the atlas, and drawing a page into itself would copy the page.
+  if (atlas_enabled_) {
+    auto result = RasterizeIntoAtlas(
+        atlas_, context, ctm, dst_color_space, checkerboard,
+        picture->cullRect(),
+        [=](SkCanvas* canvas) { canvas->drawPicture(picture); });
+    if (result) {
+      return result;
+    }
+  }
   return Rasterize(context, ctm, dst_color_space, checkerboard,
                    picture->cullRect(),
                    [=](SkCanvas* canvas) { canvas->drawPicture(picture); });
@@ -138,11 +327,22 @@ std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
 void RasterCache::Prepare(PrerollContext* context,
                           Layer* layer,
                           const SkMatrix& ctm) {
+  if (context->deferred_prepares) {
+    context->deferred_prepares->push_back(
+        {nullptr, layer, ctm, false, false, kNoPictureFingerprint});
+    return;
+  }
+  RecordPrepare({nullptr, layer, ctm, false, false, kNoPictureFingerprint});
   LayerRasterCacheKey cache_key(layer->unique_id(), ctm);
   Entry& entry = layer_cache_[cache_key];
   entry.access_count++;
   entry.used_this_frame = true;
   if (!entry.image) {
+    if (entry.access_count < access_threshold_ &&
+        FindScaledEntry(layer_cache_, cache_key)) {
+      // |Draw| draws the entry of the nearest scale until this one is warm.
+      return;
+    }
     entry.image = RasterizeLayer(context, layer, ctm, checkerboard_images_);
   }
 }
@@ -183,35 +383,55 @@ bool RasterCache::Prepare(GrDirectContext* context,
                           const SkMatrix& transformation_matrix,
                           SkColorSpace* dst_color_space,
                           bool is_complex,
-                          bool will_change) {
+                          bool will_change,
+                          PictureFingerprint fingerprint) {
   // Disabling caching when access_threshold is zero is historic behavior.
   if (access_threshold_ == 0) {
     return false;
   }
-  if (picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
+  if (!IsPictureWorthRasterizing(picture, fingerprint, will_change,
+                                 is_complex)) {
+    // We only deal with pictures that are worthy of rasterization.
     return false;
   }
-  if (!IsPictureWorthRasterizing(picture, will_change, is_complex)) {
-    // We only deal with pictures that are worthy of rasterization.
+  // Pictures that aren't worth rasterizing never will be, so they are left
+  // out of recordings. Everything below depends on the state of the cache.
+  RecordPrepare({picture, nullptr, transformation_matrix, is_complex,
+                 will_change, fingerprint});
+  if (picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
     return false;
   }
 
-  // Decompose the matrix (once) for all subsequent operations. We want to make
-  // sure to avoid volumetric distortions while accounting for scaling.
-  const MatrixDecomposition matrix(transformation_matrix);
-
-  if (!matrix.IsValid()) {
+  if (!MatrixDecomposition::IsDecomposable(transformation_matrix)) {
     // The matrix was singular. No point in going further.
     return false;
   }
 
-  PictureRasterCacheKey cache_key(picture->uniqueID(), transformation_matrix);
+  PictureRasterCacheKey cache_key(GetPictureCacheId(*picture, fingerprint),
+                                  transformation_matrix);
 
   // Creates an entry, if not present prior.
   Entry& entry = picture_cache_[cache_key];
-  if (entry.access_count < access_threshold_) {
-    // Frame threshold has not yet been reached.
-    return false;
+  if (!IsEntryOf(entry, picture)) {
+    // The entry is new, or belongs to a picture whose fingerprint collides
+    // with the one of |picture|. Either way it starts over for |picture|.
+    entry = Entry();
+    entry.picture_cull_rect = picture->cullRect();
+    entry.picture_op_count = picture->approximateOpCount();
+  }
+  if (!entry.image && entry.access_count < access_threshold_) {
+    if (max_scale_distance_ <= 0 ||
+        !HasScaledEntry(picture_cache_, cache_key, picture)) {
+      // Frame threshold has not yet been reached.
+      return false;
+    }
+    if (FindScaledEntry(picture_cache_, cache_key, picture)) {
+      // |Draw| draws the entry of the nearest scale until this one is warm.
+      return true;
+    }
+    // The picture is being scaled past the tolerance of all its entries,
+    // e.g. by a long zoom. It was warm at the other scales, so rasterize it
+    // now so that the following frames can draw this entry scaled.
   }
 
   if (!entry.image) {
@@ -222,19 +442,70 @@ bool RasterCache::Prepare(GrDirectContext* context,
   return true;
 }
 
-bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
-  PictureRasterCacheKey cache_key(picture.uniqueID(), canvas.getTotalMatrix());
-  auto it = picture_cache_.find(cache_key);
-  if (it == picture_cache_.end()) {
-    return false;
+bool RasterCache::IsEntryOf(const Entry& entry, const SkPicture* picture) {
+  return !picture || (entry.picture_cull_rect == picture->cullRect() &&
+                      entry.picture_op_count == picture->approximateOpCount());
+}
+
+void RasterCache::RecordPrepare(const PrepareCall& call) {
+  if (!prepare_recordings_.empty()) {
+    prepare_recordings_.back().push_back(call);
   }
+}
 
-  Entry& entry = it->second;
-  entry.access_count++;
-  entry.used_this_frame = true;
+void RasterCache::BeginRecordingPrepares() {
+  prepare_recordings_.emplace_back();
+}
+
+RasterCache::PrepareRecording RasterCache::EndRecordingPrepares() {
+  FML_DCHECK(!prepare_recordings_.empty());
+  PrepareRecording recording = std::move(prepare_recordings_.back());
+  prepare_recordings_.pop_back();
+  if (!prepare_recordings_.empty()) {
+    PrepareRecording& parent = prepare_recordings_.back();
+    parent.insert(parent.end(), recording.begin(), recording.end());
+  }
+  return recording;
+}
+
+void RasterCache::ReplayPrepares(PrerollContext* context,
+                                 const PrepareRecording& recording) {
+  if (context->deferred_prepares) {
+    context->deferred_prepares->insert(context->deferred_prepares->end(),
+                                       recording.begin(), recording.end());
+    return;
+  }
+  for (const PrepareCall& call : recording) {
+    if (call.picture) {
+      Prepare(context->gr_context, call.picture, call.matrix,
+              context->dst_color_space, call.is_complex, call.will_change,
+              call.fingerprint);
+    } else {
+      Prepare(context, call.layer, call.matrix);
+    }
+  }
+}
 
-  if (entry.image) {
-    entry.image->draw(canvas, nullptr);
+bool RasterCache::Draw(const SkPicture& picture,
+                       SkCanvas& canvas,
+                       PictureFingerprint fingerprint) const {
+  PictureRasterCacheKey cache_key(GetPictureCacheId(picture, fingerprint),
+                                  canvas.getTotalMatrix());
+  auto it = picture_cache_.find(cache_key);
+  if (it != picture_cache_.end() && IsEntryOf(it->second, &picture)) {
+    Entry& entry = it->second;
+    entry.access_count++;
+    entry.used_this_frame = true;
+
+    if (entry.image) {
+      entry.image->draw(canvas, nullptr);
+      return true;
+    }
+  }
+
+  if (auto* scaled = FindScaledEntry(picture_cache_, cache_key, &picture)) {
+    scaled->second.used_this_frame = true;
+    scaled->second.image->drawScaled(canvas, scaled->first.matrix(), nullptr);
     return true;
   }
 
@@ -246,25 +517,44 @@ bool RasterCache::Draw(const Layer* layer,
                        SkPaint* paint) const {
   LayerRasterCacheKey cache_key(layer->unique_id(), canvas.getTotalMatrix());
   auto it = layer_cache_.find(cache_key);
-  if (it == layer_cache_.end()) {
-    return false;
+  if (it != layer_cache_.end()) {
+    Entry& entry = it->second;
+    entry.access_count++;
+    entry.used_this_frame = true;
+
+    if (entry.image) {
+      entry.image->draw(canvas, paint);
+      return true;
+    }
   }
 
-  Entry& entry = it->second;
-  entry.access_count++;
-  entry.used_this_frame = true;
-
-  if (entry.image) {
-    entry.image->draw(canvas, paint);
+  if (auto* scaled = FindScaledEntry(layer_cache_, cache_key)) {
+    scaled->second.used_this_frame = true;
+    scaled->second.image->drawScaled(canvas, scaled->first.matrix(), paint);
     return true;
   }
 
   return false;
 }
 
+const PictureComplexity& RasterCache::GetPictureComplexity(
+    SkPicture* picture,
+    PictureFingerprint fingerprint) {
+  auto [it, inserted] = picture_complexity_.try_emplace(
+      GetPictureCacheId(*picture, fingerprint));
+  ComplexityEntry& entry = it->second;
+  if (inserted) {
+    entry.complexity = PictureComplexity::Compute(picture);
+  }
+  entry.used_this_frame = true;
+  return entry.complexity;
+}
+
 void RasterCache::SweepAfterFrame() {
   SweepOneCacheAfterFrame(picture_cache_);
   SweepOneCacheAfterFrame(layer_cache_);
+  SweepOneCacheAfterFrame(picture_complexity_);
+  atlas_.Compact();
   picture_cached_this_frame_ = 0;
   TraceStatsToTimeline();
 }
@@ -272,6 +562,8 @@ void RasterCache::SweepAfterFrame() {
 void RasterCache::Clear() {
   picture_cache_.clear();
   layer_cache_.clear();
+  picture_complexity_.clear();
+  atlas_.Clear();
 }
 
 size_t RasterCache::GetCachedEntriesCount() const {
@@ -305,6 +597,12 @@ void RasterCache::TraceStatsToTimeline() const {
                     EstimateLayerCacheByteSize() / kMegaByteSizeInBytes,
                     "PictureCount", picture_cache_.size(), "PictureMBytes",
                     EstimatePictureCacheByteSize() / kMegaByteSizeInBytes);
+  FML_TRACE_COUNTER("flutter", "RasterCacheAtlas",
+                    reinterpret_cast<int64_t>(this), "PageCount",
+                    atlas_.GetPageCount(), "MBytes",
+                    EstimateAtlasByteSize() / kMegaByteSizeInBytes,
+                    "OccupancyPercent",
+                    static_cast<int64_t>(atlas_.GetOccupancy() * 100));
 
 #endif  // !FLUTTER_RELEASE
 }
@@ -329,4 +627,16 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
+size_t RasterCache::GetAtlasPageCount() const {
+  return atlas_.GetPageCount();
+}
+
+size_t RasterCache::EstimateAtlasByteSize() const {
+  return atlas_.EstimateByteSize();
+}
+
+double RasterCache::GetAtlasOccupancy() const {
+  return atlas_.GetOccupancy();
+}
+
 }  // namespace flutter
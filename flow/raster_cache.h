@@ -7,7 +7,11 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
+#include "flutter/flow/picture_complexity.h"
+#include "flutter/flow/picture_fingerprint.h"
+#include "flutter/flow/raster_cache_atlas.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -24,6 +28,12 @@ class RasterCacheResult {
 
   virtual void draw(SkCanvas& canvas, const SkPaint* paint) const;
 
+  // Draws the image, which was rasterized with |raster_matrix|, at the scale
+  // of the current matrix of |canvas| instead, with linear filtering.
+  virtual void drawScaled(SkCanvas& canvas,
+                          const SkMatrix& raster_matrix,
+                          const SkPaint* paint) const;
+
   virtual SkISize image_dimensions() const {
     return image_ ? image_->dimensions() : SkISize::Make(0, 0);
   };
@@ -41,6 +51,20 @@ struct PrerollContext;
 
 class RasterCache {
  public:
+  // A call to one of the |Prepare| methods, recorded so that it can be
+  // replayed on a later frame. |picture| is null for calls that prepare a
+  // layer.
+  struct PrepareCall {
+    SkPicture* picture;
+    Layer* layer;
+    SkMatrix matrix;
+    bool is_complex;
+    bool will_change;
+    PictureFingerprint fingerprint;
+  };
+
+  using PrepareRecording = std::vector<PrepareCall>;
+
   // The default max number of picture raster caches to be generated per frame.
   // Generating too many caches in one frame may cause jank on that frame. This
   // limit allows us to throttle the cache and distribute the work across
@@ -53,6 +77,23 @@ class RasterCache {
 
   virtual ~RasterCache() = default;
 
+  // Lets entries rasterized at a scale within a factor of 1 + |tolerance| of
+  // the one they are drawn at be drawn scaled, with filtering, when there is
+  // no entry for the exact matrix. During a pinch-zoom or a scale animation
+  // the matrix changes on every frame, so without this the cache misses
+  // until the animation ends. The exact matrix is rasterized once it has been
+  // used for as many frames as it takes to warm up any entry, i.e. once the
+  // animation settles, or right away when the scale has moved past the
+  // tolerance of every entry of the picture or layer.
+  //
+  // Zero, the default, turns this off.
+  void SetScaleTolerance(float tolerance);
+
+  // Rasterizes pictures that are at most |RasterCacheAtlas::kMaxEntrySize|
+  // pixels wide and high into the pages of an atlas instead of images of
+  // their own. Only affects the entries rasterized afterwards.
+  void SetAtlasEnabled(bool enabled);
+
   /**
    * @brief Rasterize a picture object and produce a RasterCacheResult
    * to be stored in the cache.
@@ -124,27 +165,62 @@ class RasterCache {
     return result;
   }
 
+  // Returns the ID that |picture| is cached under: |fingerprint| if the
+  // picture has one, so that pictures with identical content share entries,
+  // or else the unique ID of the picture. Picture entries are only used for
+  // pictures with the cull rect and approximate op count of the picture they
+  // were created for, so two pictures whose fingerprints collide don't draw
+  // each other. They may still share their |PictureComplexity|.
+  static uint64_t GetPictureCacheId(const SkPicture& picture,
+                                    PictureFingerprint fingerprint) {
+    return fingerprint != kNoPictureFingerprint ? fingerprint
+                                                : picture.uniqueID();
+  }
+
   // Return true if the cache is generated.
   //
   // We may return false and not generate the cache if
-  // 1. The picture is not worth rasterizing
+  // 1. The picture is not worth rasterizing (see |PictureComplexity|)
   // 2. The matrix is singular
   // 3. The picture is accessed too few times
   // 4. There are too many pictures to be cached in the current frame.
   //    (See also kDefaultPictureCacheLimitPerFrame.)
+  //
+  // With a scale tolerance (see |SetScaleTolerance|), we also return true
+  // without generating the cache if an entry of another scale will be drawn
+  // instead.
   bool Prepare(GrDirectContext* context,
                SkPicture* picture,
                const SkMatrix& transformation_matrix,
                SkColorSpace* dst_color_space,
                bool is_complex,
-               bool will_change);
+               bool will_change,
+               PictureFingerprint fingerprint = kNoPictureFingerprint);
 
+  // Only appends the call to |context->deferred_prepares|, if set.
   void Prepare(PrerollContext* context, Layer* layer, const SkMatrix& ctm);
 
+  // Starts recording the |Prepare| calls made while prerolling a retained
+  // layer subtree. Recordings nest: the calls recorded between a Begin and its
+  // matching End are also added to the enclosing recording, if any.
+  void BeginRecordingPrepares();
+
+  PrepareRecording EndRecordingPrepares();
+
+  // Repeats the |Prepare| calls of |recording| so that the entries used by a
+  // retained subtree are kept alive and can still be generated when the
+  // subtree itself isn't prerolled. Only appends the calls to
+  // |context->deferred_prepares|, if set.
+  void ReplayPrepares(PrerollContext* context,
+                      const PrepareRecording& recording);
+
   // Find the raster cache for the picture and draw it to the canvas.
+  // |fingerprint| must be the one the picture was prepared with.
   //
   // Return true if it's found and drawn.
-  bool Draw(const SkPicture& picture, SkCanvas& canvas) const;
+  bool Draw(const SkPicture& picture,
+            SkCanvas& canvas,
+            PictureFingerprint fingerprint = kNoPictureFingerprint) const;
 
   // Find the raster cache for the layer and draw it to the canvas.
   //
@@ -156,6 +232,13 @@ class RasterCache {
             SkCanvas& canvas,
             SkPaint* paint = nullptr) const;
 
+  // Returns the estimated rasterization cost of the picture. The estimate is
+  // computed on first use and kept for as long as the picture is prepared at
+  // least once per frame, and shared by pictures with the same fingerprint.
+  const PictureComplexity& GetPictureComplexity(
+      SkPicture* picture,
+      PictureFingerprint fingerprint = kNoPictureFingerprint);
+
   void SweepAfterFrame();
 
   void Clear();
@@ -188,19 +271,67 @@ class RasterCache {
    */
   size_t EstimateLayerCacheByteSize() const;
 
+  // The number of atlas pages (see |SetAtlasEnabled|).
+  size_t GetAtlasPageCount() const;
+
+  // Estimate how much memory is used by the pages of the atlas in bytes.
+  // Picture entries in the atlas are also counted by
+  // |EstimatePictureCacheByteSize|, by the size of their region.
+  size_t EstimateAtlasByteSize() const;
+
+  // The fraction of the area of the atlas pages that entries occupy.
+  double GetAtlasOccupancy() const;
+
  private:
   struct Entry {
     bool used_this_frame = false;
     size_t access_count = 0;
     std::unique_ptr<RasterCacheResult> image;
+    // The cull rect and approximate op count of the picture that a picture
+    // entry was created for (see |GetPictureCacheId|).
+    SkRect picture_cull_rect = SkRect::MakeEmpty();
+    int picture_op_count = 0;
+  };
+
+  struct ComplexityEntry {
+    bool used_this_frame = false;
+    PictureComplexity complexity;
   };
 
+  bool IsPictureWorthRasterizing(SkPicture* picture,
+                                 PictureFingerprint fingerprint,
+                                 bool will_change,
+                                 bool is_complex);
+
+  void RecordPrepare(const PrepareCall& call);
+
+  // Returns whether |entry| was created for a picture with the cull rect and
+  // approximate op count of |picture|. Always true if |picture| is null.
+  static bool IsEntryOf(const Entry& entry, const SkPicture* picture);
+
+  // Returns the entry of the same ID as |key| that has an image rasterized at
+  // the scale nearest to the one of |key|, if the two scales are within the
+  // scale tolerance, or null. For picture entries, |picture| is the picture
+  // being drawn.
+  template <class Cache>
+  typename Cache::value_type* FindScaledEntry(
+      Cache& cache,
+      const typename Cache::key_type& key,
+      const SkPicture* picture = nullptr) const;
+
+  // Returns whether |cache| has an entry of the same ID as |key| with an
+  // image, rasterized at any scale.
+  template <class Cache>
+  static bool HasScaledEntry(Cache& cache,
+                             const typename Cache::key_type& key,
+                             const SkPicture* picture = nullptr);
+
   template <class Cache>
   static void SweepOneCacheAfterFrame(Cache& cache) {
     std::vector<typename Cache::iterator> dead;
 
     for (auto it = cache.begin(); it != cache.end(); ++it) {
-      Entry& entry = it->second;
+      auto& entry = it->second;
       if (!entry.used_this_frame) {
         dead.push_back(it);
       }
@@ -213,11 +344,18 @@ class RasterCache {
   }
 
   const size_t access_threshold_;
+  // The log of 1 + the scale tolerance.
+  float max_scale_distance_ = 0;
   const size_t picture_cache_limit_per_frame_;
   size_t picture_cached_this_frame_ = 0;
   mutable PictureRasterCacheKey::Map<Entry> picture_cache_;
   mutable LayerRasterCacheKey::Map<Entry> layer_cache_;
+  // Keyed by |GetPictureCacheId|.
+  std::unordered_map<uint64_t, ComplexityEntry> picture_complexity_;
+  std::vector<PrepareRecording> prepare_recordings_;
   bool checkerboard_images_;
+  bool atlas_enabled_ = false;
+  mutable RasterCacheAtlas atlas_;
 
   void TraceStatsToTimeline() const;
 
@@ -0,0 +1,220 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_atlas.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "flutter/flow/rectangle_packer.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+// The transparent border around each region, so that drawing a region with
+// filtering doesn't sample its neighbours.
+static constexpr int kRegionPadding = 1;
+
+struct RasterCacheAtlas::Page {
+  Page(sk_sp<SkSurface> surface,
+       GrDirectContext* context,
+       sk_sp<SkColorSpace> color_space)
+      : surface(std::move(surface)),
+        context(context),
+        color_space(std::move(color_space)),
+        packer(kPageSize, kPageSize) {}
+
+  sk_sp<SkImage> GetImage() {
+    if (!image) {
+      image = surface->makeImageSnapshot();
+    }
+    return image;
+  }
+
+  SkCanvas* BeginWriting() {
+    // Dropping the snapshot first spares the surface from copying itself
+    // before it is written to.
+    image = nullptr;
+    return surface->getCanvas();
+  }
+
+  sk_sp<SkSurface> surface;
+  GrDirectContext* context;
+  sk_sp<SkColorSpace> color_space;
+  RectanglePacker packer;
+  // Set once an allocation didn't fit.
+  bool full = false;
+  std::unordered_set<Region*> regions;
+  int64_t region_area = 0;
+  // A snapshot of |surface|, taken on the first draw after it was written.
+  sk_sp<SkImage> image;
+};
+
+RasterCacheAtlas::Region::Region(std::shared_ptr<Page> page,
+                                 const SkIRect& rect)
+    : page_(std::move(page)), rect_(rect) {
+  page_->regions.insert(this);
+  page_->region_area += rect_.width() * rect_.height();
+}
+
+RasterCacheAtlas::Region::~Region() {
+  page_->regions.erase(this);
+  page_->region_area -= rect_.width() * rect_.height();
+}
+
+sk_sp<SkImage> RasterCacheAtlas::Region::GetPageImage() const {
+  return page_->GetImage();
+}
+
+void RasterCacheAtlas::Region::Draw(
+    const std::function<void(SkCanvas*)>& draw_function) {
+  SkCanvas* canvas = page_->BeginWriting();
+  SkAutoCanvasRestore auto_restore(canvas, true);
+  canvas->clipRect(SkRect::Make(rect_.makeOutset(kRegionPadding,
+                                                 kRegionPadding)));
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->clipRect(SkRect::Make(rect_));
+  canvas->translate(rect_.x(), rect_.y());
+  draw_function(canvas);
+}
+
+RasterCacheAtlas::RasterCacheAtlas() = default;
+
+RasterCacheAtlas::~RasterCacheAtlas() = default;
+
+std::unique_ptr<RasterCacheAtlas::Region> RasterCacheAtlas::Allocate(
+    GrDirectContext* context,
+    SkColorSpace* color_space,
+    SkISize size) {
+  if (size.isEmpty() || size.width() > kMaxEntrySize ||
+      size.height() > kMaxEntrySize) {
+    return nullptr;
+  }
+
+  const int width = size.width() + 2 * kRegionPadding;
+  const int height = size.height() + 2 * kRegionPadding;
+  SkIPoint location;
+  std::shared_ptr<Page> page;
+  for (const std::shared_ptr<Page>& candidate : pages_) {
+    if (candidate->context != context ||
+        !SkColorSpace::Equals(candidate->color_space.get(), color_space)) {
+      continue;
+    }
+    if (candidate->packer.Allocate(width, height, &location)) {
+      page = candidate;
+      break;
+    }
+    candidate->full = true;
+  }
+
+  if (!page) {
+    page = AddPage(context, color_space);
+    if (!page || !page->packer.Allocate(width, height, &location)) {
+      return nullptr;
+    }
+  }
+
+  SkIRect rect = SkIRect::MakeXYWH(location.x() + kRegionPadding,
+                                   location.y() + kRegionPadding,
+                                   size.width(), size.height());
+  return std::unique_ptr<Region>(new Region(std::move(page), rect));
+}
+
+std::shared_ptr<RasterCacheAtlas::Page> RasterCacheAtlas::AddPage(
+    GrDirectContext* context,
+    SkColorSpace* color_space) {
+  const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+      kPageSize, kPageSize, sk_ref_sp(color_space));
+  sk_sp<SkSurface> surface =
+      context
+          ? SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, image_info)
+          : SkSurface::MakeRaster(image_info);
+  if (!surface) {
+    return nullptr;
+  }
+  surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+
+  pages_.push_back(std::make_shared<Page>(std::move(surface), context,
+                                          sk_ref_sp(color_space)));
+  return pages_.back();
+}
+
+void RasterCacheAtlas::Compact() {
+  std::vector<std::shared_ptr<Page>> sparse_pages;
+  auto it = std::remove_if(
+      pages_.begin(), pages_.end(), [&](const std::shared_ptr<Page>& page) {
+        if (page->regions.empty()) {
+          return true;
+        }
+        if (page->full && page->region_area * 2 < kPageSize * kPageSize) {
+          sparse_pages.push_back(page);
+          return true;
+        }
+        return false;
+      });
+  pages_.erase(it, pages_.end());
+  if (sparse_pages.empty()) {
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "RasterCacheAtlas::Compact");
+  for (const std::shared_ptr<Page>& page : sparse_pages) {
+    // Packing the tallest regions first keeps the skyline flat.
+    std::vector<Region*> regions(page->regions.begin(), page->regions.end());
+    std::sort(regions.begin(), regions.end(), [](Region* a, Region* b) {
+      return a->rect().height() > b->rect().height();
+    });
+
+    sk_sp<SkImage> image = page->GetImage();
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    for (Region* region : regions) {
+      std::unique_ptr<Region> moved = Allocate(
+          page->context, page->color_space.get(), region->rect().size());
+      if (!moved) {
+        // The region stays where it is, which keeps its page alive.
+        continue;
+      }
+      moved->page_->BeginWriting()->drawImageRect(
+          image, SkRect::Make(region->rect()), SkRect::Make(moved->rect()),
+          SkSamplingOptions(), &paint, SkCanvas::kStrict_SrcRectConstraint);
+      std::swap(region->page_, moved->page_);
+      std::swap(region->rect_, moved->rect_);
+      // |moved| now refers to the old rectangle of |region|, and frees it.
+      region->page_->regions.insert(region);
+      region->page_->regions.erase(moved.get());
+      moved->page_->regions.insert(moved.get());
+      moved->page_->regions.erase(region);
+    }
+  }
+}
+
+void RasterCacheAtlas::Clear() {
+  pages_.clear();
+}
+
+size_t RasterCacheAtlas::EstimateByteSize() const {
+  size_t bytes = 0;
+  for (const std::shared_ptr<Page>& page : pages_) {
+    bytes += page->surface->imageInfo().computeMinByteSize();
+  }
+  return bytes;
+}
+
+double RasterCacheAtlas::GetOccupancy() const {
+  if (pages_.empty()) {
+    return 0;
+  }
+  int64_t region_area = 0;
+  for (const std::shared_ptr<Page>& page : pages_) {
+    region_area += page->region_area;
+  }
+  return static_cast<double>(region_area) /
+         (static_cast<double>(kPageSize) * kPageSize * pages_.size());
+}
+
+}  // namespace flutter
@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
+#define FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+// Packs the images of small raster cache entries into shared surfaces, the
+// pages of the atlas, instead of giving each entry a surface of its own. This
+// saves the overhead of an allocation per entry, and lets consecutive draws
+// of entries from the same page be batched.
+//
+// Each entry owns a |Region| of a page. Pages are packed without freeing the
+// rectangles of destroyed regions, so |Compact| moves the regions of pages
+// that have run out of room but are mostly unused into new pages.
+class RasterCacheAtlas {
+ public:
+  // The width and height of the pages.
+  static constexpr int kPageSize = 1024;
+
+  // The largest width and height of an entry that is packed into the atlas.
+  static constexpr int kMaxEntrySize = 256;
+
+  struct Page;
+
+  // A rectangle of a page that holds the image of one cache entry.
+  class Region {
+   public:
+    ~Region();
+
+    // The rectangle of the page that the image of the entry occupies.
+    const SkIRect& rect() const { return rect_; }
+
+    // Returns an image of the whole page, to draw |rect| of.
+    sk_sp<SkImage> GetPageImage() const;
+
+    // Clears the region and calls |draw_function| with a canvas of the page
+    // that is clipped to the region and translated to its top-left corner.
+    void Draw(const std::function<void(SkCanvas*)>& draw_function);
+
+   private:
+    friend class RasterCacheAtlas;
+
+    Region(std::shared_ptr<Page> page, const SkIRect& rect);
+
+    std::shared_ptr<Page> page_;
+    SkIRect rect_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Region);
+  };
+
+  RasterCacheAtlas();
+
+  ~RasterCacheAtlas();
+
+  // Returns a region of |size| in a page for |context| and |color_space|,
+  // adding a page if none has room. Returns null if |size| is larger than
+  // |kMaxEntrySize| or a page can't be created.
+  std::unique_ptr<Region> Allocate(GrDirectContext* context,
+                                   SkColorSpace* color_space,
+                                   SkISize size);
+
+  // Moves the regions of pages that have run out of room and whose regions
+  // take up less than half of them into new pages, and releases the pages
+  // that have no regions left.
+  void Compact();
+
+  // Releases the pages once their regions are destroyed, and stops adding
+  // regions to them.
+  void Clear();
+
+  size_t GetPageCount() const { return pages_.size(); }
+
+  // The memory used by the pages, estimated like
+  // |RasterCache::EstimatePictureCacheByteSize|.
+  size_t EstimateByteSize() const;
+
+  // The fraction of the area of the pages that regions occupy.
+  double GetOccupancy() const;
+
+ private:
+  std::shared_ptr<Page> AddPage(GrDirectContext* context,
+                                SkColorSpace* color_space);
+
+  std::vector<std::shared_ptr<Page>> pages_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheAtlas);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_atlas.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkImage.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+using Region = RasterCacheAtlas::Region;
+
+std::unique_ptr<Region> Allocate(RasterCacheAtlas& atlas,
+                                 int width,
+                                 int height) {
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  return atlas.Allocate(nullptr, srgb.get(), SkISize::Make(width, height));
+}
+
+SkColor ReadPixel(const Region& region, int x, int y) {
+  SkColor color = SK_ColorTRANSPARENT;
+  SkImageInfo info =
+      SkImageInfo::Make(1, 1, kBGRA_8888_SkColorType, kUnpremul_SkAlphaType);
+  region.GetPageImage()->readPixels(info, &color, sizeof(color),
+                                    region.rect().x() + x,
+                                    region.rect().y() + y);
+  return color;
+}
+
+void Fill(Region& region, SkColor color) {
+  region.Draw([color](SkCanvas* canvas) { canvas->drawColor(color); });
+}
+
+}  // namespace
+
+TEST(RasterCacheAtlas, PacksRegionsIntoOnePage) {
+  RasterCacheAtlas atlas;
+  std::vector<std::unique_ptr<Region>> regions;
+  for (int i = 0; i < 100; i++) {
+    regions.push_back(Allocate(atlas, 32, 32));
+    ASSERT_TRUE(regions.back());
+    EXPECT_EQ(regions.back()->rect().size(), SkISize::Make(32, 32));
+    for (size_t j = 0; j + 1 < regions.size(); j++) {
+      EXPECT_FALSE(
+          SkIRect::Intersects(regions.back()->rect(), regions[j]->rect()));
+    }
+  }
+  EXPECT_EQ(atlas.GetPageCount(), 1u);
+  const double page_area =
+      RasterCacheAtlas::kPageSize * RasterCacheAtlas::kPageSize;
+  EXPECT_DOUBLE_EQ(atlas.GetOccupancy(), 100 * 32 * 32 / page_area);
+  EXPECT_EQ(atlas.EstimateByteSize(),
+            static_cast<size_t>(page_area) * sizeof(uint32_t));
+
+  regions.resize(50);
+  EXPECT_DOUBLE_EQ(atlas.GetOccupancy(), 50 * 32 * 32 / page_area);
+}
+
+TEST(RasterCacheAtlas, LargeEntriesAreNotPacked) {
+  RasterCacheAtlas atlas;
+  EXPECT_FALSE(Allocate(atlas, RasterCacheAtlas::kMaxEntrySize + 1, 10));
+  EXPECT_FALSE(Allocate(atlas, 10, RasterCacheAtlas::kMaxEntrySize + 1));
+  EXPECT_FALSE(Allocate(atlas, 0, 10));
+  EXPECT_EQ(atlas.GetPageCount(), 0u);
+}
+
+TEST(RasterCacheAtlas, DrawIsClippedToRegion) {
+  RasterCacheAtlas atlas;
+  auto first = Allocate(atlas, 10, 10);
+  auto second = Allocate(atlas, 10, 10);
+  Fill(*first, SK_ColorRED);
+  Fill(*second, SK_ColorBLUE);
+
+  EXPECT_EQ(ReadPixel(*first, 0, 0), SK_ColorRED);
+  EXPECT_EQ(ReadPixel(*first, 9, 9), SK_ColorRED);
+  EXPECT_EQ(ReadPixel(*first, 10, 0), SK_ColorTRANSPARENT);
+  EXPECT_EQ(ReadPixel(*second, 0, 0), SK_ColorBLUE);
+  EXPECT_EQ(ReadPixel(*second, -1, 0), SK_ColorTRANSPARENT);
+}
+
+TEST(RasterCacheAtlas, CompactReleasesEmptyPages) {
+  RasterCacheAtlas atlas;
+  auto region = Allocate(atlas, 10, 10);
+  ASSERT_EQ(atlas.GetPageCount(), 1u);
+  atlas.Compact();
+  EXPECT_EQ(atlas.GetPageCount(), 1u);
+
+  region.reset();
+  atlas.Compact();
+  EXPECT_EQ(atlas.GetPageCount(), 0u);
+}
+
+TEST(RasterCacheAtlas, CompactMovesRegionsOfSparsePages) {
+  RasterCacheAtlas atlas;
+  // With their padding, 16 regions of this size fill a page.
+  const int size = RasterCacheAtlas::kPageSize / 4 - 2;
+  std::vector<std::unique_ptr<Region>> regions;
+  for (int i = 0; i < 17; i++) {
+    regions.push_back(Allocate(atlas, size, size));
+    ASSERT_TRUE(regions.back());
+  }
+  ASSERT_EQ(atlas.GetPageCount(), 2u);
+
+  // Keep 4 regions of the first page, which is full but only a quarter used.
+  regions.erase(regions.begin() + 4, regions.begin() + 16);
+  const SkColor colors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE,
+                            SK_ColorYELLOW, SK_ColorCYAN};
+  for (size_t i = 0; i < regions.size(); i++) {
+    Fill(*regions[i], colors[i]);
+  }
+
+  atlas.Compact();
+  EXPECT_EQ(atlas.GetPageCount(), 1u);
+  sk_sp<SkImage> page_image = regions[4]->GetPageImage();
+  for (size_t i = 0; i < regions.size(); i++) {
+    EXPECT_EQ(regions[i]->GetPageImage()->uniqueID(), page_image->uniqueID());
+    EXPECT_EQ(ReadPixel(*regions[i], 0, 0), colors[i]);
+    EXPECT_EQ(ReadPixel(*regions[i], size - 1, size - 1), colors[i]);
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
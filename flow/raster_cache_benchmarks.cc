@@ -0,0 +1,106 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache.h"
+
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkMaskFilter.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+// Compares raster cache entries that have images of their own with entries
+// that are packed into an atlas, on software surfaces. The second argument of
+// each benchmark selects the atlas.
+
+namespace flutter {
+
+namespace {
+
+constexpr int kIconSize = 24;
+constexpr int kIconsPerRow = 40;
+
+// Records |count| small pictures like the icons of a list.
+std::vector<sk_sp<SkPicture>> RecordIcons(int64_t count) {
+  std::vector<sk_sp<SkPicture>> icons;
+  for (int64_t i = 0; i < count; i++) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas =
+        recorder.beginRecording(SkRect::MakeWH(kIconSize, kIconSize));
+    SkPaint paint;
+    paint.setColor(SkColorSetARGB(255, i % 256, 128, 0));
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 1));
+    canvas->drawCircle(kIconSize / 2, kIconSize / 2, kIconSize / 3, paint);
+    icons.push_back(recorder.finishRecordingAsPicture());
+  }
+  return icons;
+}
+
+// Prepares and draws |icons| in a grid on |canvas|, like a frame would.
+void DrawFrame(RasterCache& cache,
+               const std::vector<sk_sp<SkPicture>>& icons,
+               SkCanvas* canvas) {
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (size_t i = 0; i < icons.size(); i++) {
+    SkAutoCanvasRestore auto_restore(canvas, true);
+    canvas->translate(i % kIconsPerRow * (kIconSize + 1),
+                      i / kIconsPerRow * (kIconSize + 1));
+    cache.Prepare(nullptr, icons[i].get(), canvas->getTotalMatrix(),
+                  srgb.get(), true, false);
+    if (!cache.Draw(*icons[i], *canvas)) {
+      canvas->drawPicture(icons[i]);
+    }
+  }
+  cache.SweepAfterFrame();
+}
+
+// Returns a cache that rasterizes every entry on its first use.
+std::unique_ptr<RasterCache> MakeCache(const benchmark::State& state) {
+  auto cache = std::make_unique<RasterCache>(1, state.range(0));
+  cache->SetAtlasEnabled(state.range(1));
+  return cache;
+}
+
+void BM_RasterCachePopulate(benchmark::State& state) {
+  std::vector<sk_sp<SkPicture>> icons = RecordIcons(state.range(0));
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(1000, 1000);
+  size_t bytes = 0;
+  while (state.KeepRunning()) {
+    std::unique_ptr<RasterCache> cache = MakeCache(state);
+    DrawFrame(*cache, icons, surface->getCanvas());
+    DrawFrame(*cache, icons, surface->getCanvas());
+    bytes = state.range(1) ? cache->EstimateAtlasByteSize()
+                           : cache->EstimatePictureCacheByteSize();
+  }
+  state.counters["CacheBytes"] = bytes;
+}
+
+void BM_RasterCacheDraw(benchmark::State& state) {
+  std::vector<sk_sp<SkPicture>> icons = RecordIcons(state.range(0));
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(1000, 1000);
+  std::unique_ptr<RasterCache> cache = MakeCache(state);
+  DrawFrame(*cache, icons, surface->getCanvas());
+  DrawFrame(*cache, icons, surface->getCanvas());
+  while (state.KeepRunning()) {
+    DrawFrame(*cache, icons, surface->getCanvas());
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_RasterCachePopulate)
+    ->Args({100, false})
+    ->Args({100, true})
+    ->Args({1000, false})
+    ->Args({1000, true});
+BENCHMARK(BM_RasterCacheDraw)
+    ->Args({100, false})
+    ->Args({100, true})
+    ->Args({1000, false})
+    ->Args({1000, true});
+
+}  // namespace flutter
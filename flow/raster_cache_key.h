@@ -49,8 +49,9 @@ class RasterCacheKey {
   SkMatrix matrix_;
 };
 
-// The ID is the uint32_t picture uniqueID
-using PictureRasterCacheKey = RasterCacheKey<uint32_t>;
+// The ID is the picture's PictureFingerprint, or its uint32_t uniqueID if it
+// doesn't have one (see RasterCache::GetPictureCacheId).
+using PictureRasterCacheKey = RasterCacheKey<uint64_t>;
 
 class Layer;
 
@@ -4,11 +4,16 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <vector>
+
+#include "flutter/flow/layers/layer.h"
 #include "gtest/gtest.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkMaskFilter.h"
 #include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 namespace testing {
@@ -24,6 +29,117 @@ sk_sp<SkPicture> GetSamplePicture() {
   return recorder.finishRecordingAsPicture();
 }
 
+sk_sp<SkPicture> GetBlurredPicture() {
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(150, 100));
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 5));
+  recorder.getRecordingCanvas()->drawRect(SkRect::MakeXYWH(10, 10, 80, 80),
+                                          paint);
+  return recorder.finishRecordingAsPicture();
+}
+
+// A RasterCache that counts the pictures it rasterizes.
+class CountingRasterCache : public RasterCache {
+ public:
+  explicit CountingRasterCache(size_t access_threshold)
+      : RasterCache(access_threshold) {}
+
+  std::unique_ptr<RasterCacheResult> RasterizePicture(
+      SkPicture* picture,
+      GrDirectContext* context,
+      const SkMatrix& ctm,
+      SkColorSpace* dst_color_space,
+      bool checkerboard) const override {
+    rasterized_count_++;
+    return RasterCache::RasterizePicture(picture, context, ctm,
+                                         dst_color_space, checkerboard);
+  }
+
+  int rasterized_count() const { return rasterized_count_; }
+
+ private:
+  mutable int rasterized_count_ = 0;
+};
+
+struct ReplayedFrame {
+  int rasterized_count;
+  bool drawn_from_cache;
+
+  bool operator==(const ReplayedFrame& other) const {
+    return rasterized_count == other.rasterized_count &&
+           drawn_from_cache == other.drawn_from_cache;
+  }
+};
+
+std::ostream& operator<<(std::ostream& os, const ReplayedFrame& frame) {
+  return os << "{rasterized: " << frame.rasterized_count
+            << ", hit: " << frame.drawn_from_cache << "}";
+}
+
+// Prerolls and paints a frame that draws |picture| at |scale|.
+ReplayedFrame ReplayFrame(CountingRasterCache& cache,
+                          SkPicture* picture,
+                          float scale) {
+  SkMatrix matrix = SkMatrix::Scale(scale, scale);
+  SkCanvas canvas;
+  canvas.setMatrix(matrix);
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  const int rasterized_count = cache.rasterized_count();
+  cache.Prepare(NULL, picture, matrix, srgb.get(), true, false);
+  const bool drawn_from_cache = cache.Draw(*picture, canvas);
+  cache.SweepAfterFrame();
+  return {cache.rasterized_count() - rasterized_count, drawn_from_cache};
+}
+
+// Replays a zoom animation that starts once |picture| is cached at 1x and
+// scales it up by 2% per frame for |zoom_frames| frames, then holds the last
+// scale for |settle_frames| frames. Returns what each frame of the animation
+// rasterized and whether it drew |picture| from the cache.
+std::vector<ReplayedFrame> ReplayZoomAnimation(CountingRasterCache& cache,
+                                               SkPicture* picture,
+                                               int zoom_frames,
+                                               int settle_frames) {
+  float scale = 1;
+  while (!ReplayFrame(cache, picture, scale).drawn_from_cache) {
+  }
+
+  std::vector<ReplayedFrame> frames;
+  for (int i = 0; i < zoom_frames; i++) {
+    scale *= 1.02;
+    frames.push_back(ReplayFrame(cache, picture, scale));
+  }
+  for (int i = 0; i < settle_frames; i++) {
+    frames.push_back(ReplayFrame(cache, picture, scale));
+  }
+  return frames;
+}
+
+// Draws |picture| translated by |offset| from a cache that rasterizes entries
+// on their first use, and returns the pixels.
+std::vector<SkColor> DrawFromCache(RasterCache& cache,
+                                   SkPicture* picture,
+                                   SkPoint offset) {
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(200, 200);
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->translate(offset.x(), offset.y());
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (int frame = 0; frame < 2; frame++) {
+    cache.Prepare(NULL, picture, canvas->getTotalMatrix(), srgb.get(), true,
+                  false);
+    EXPECT_EQ(cache.Draw(*picture, *canvas), frame == 1);
+    cache.SweepAfterFrame();
+  }
+
+  std::vector<SkColor> pixels(200 * 200);
+  SkImageInfo info = SkImageInfo::Make(200, 200, kBGRA_8888_SkColorType,
+                                       kUnpremul_SkAlphaType);
+  surface->readPixels(info, pixels.data(), 200 * sizeof(SkColor), 0, 0);
+  return pixels;
+}
+
 }  // namespace
 
 TEST(RasterCache, SimpleInitialization) {
@@ -164,5 +280,279 @@ TEST(RasterCache, DeviceRectRoundOut) {
   ASSERT_TRUE(cache.Draw(*picture, canvas));
 }
 
+TEST(RasterCache, CheapPictureIsNotCachedWithoutComplexHint) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  auto picture = GetSamplePicture();
+  SkCanvas dummy_canvas;
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  for (int i = 0; i < 3; i++) {
+    ASSERT_FALSE(
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), false, false));
+    ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+    cache.SweepAfterFrame();
+  }
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 0u);
+}
+
+TEST(RasterCache, ExpensivePictureWithFewOpsIsCached) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  auto picture = GetBlurredPicture();
+  ASSERT_LT(picture->approximateOpCount(), 5);
+  SkCanvas dummy_canvas;
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), false, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), false, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+}
+
+TEST(RasterCache, PictureComplexityIsComputedOnce) {
+  flutter::RasterCache cache;
+  auto picture = GetBlurredPicture();
+
+  const PictureComplexity* first = &cache.GetPictureComplexity(picture.get());
+  const PictureComplexity* second = &cache.GetPictureComplexity(picture.get());
+  EXPECT_EQ(first, second);
+  EXPECT_TRUE(first->IsWorthRasterCaching());
+}
+
+TEST(RasterCache, PreparesAreRecordedIntoNestedRecordings) {
+  flutter::RasterCache cache;
+  auto picture = GetSamplePicture();
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  const SkMatrix outer_matrix = SkMatrix::Scale(2, 2);
+  const SkMatrix inner_matrix = SkMatrix::Scale(3, 3);
+
+  cache.BeginRecordingPrepares();
+  cache.Prepare(nullptr, picture.get(), outer_matrix, srgb.get(), true, false);
+  // Cheap pictures are never cached, so there is no point in replaying them.
+  cache.Prepare(nullptr, picture.get(), outer_matrix, srgb.get(), false, false);
+  cache.BeginRecordingPrepares();
+  cache.Prepare(nullptr, picture.get(), inner_matrix, srgb.get(), true, false);
+  RasterCache::PrepareRecording inner = cache.EndRecordingPrepares();
+  RasterCache::PrepareRecording outer = cache.EndRecordingPrepares();
+
+  ASSERT_EQ(inner.size(), 1u);
+  EXPECT_EQ(inner[0].picture, picture.get());
+  EXPECT_EQ(inner[0].matrix, inner_matrix);
+  ASSERT_EQ(outer.size(), 2u);
+  EXPECT_EQ(outer[0].matrix, outer_matrix);
+  EXPECT_EQ(outer[1].matrix, inner_matrix);
+}
+
+TEST(RasterCache, ReplayedPreparesGenerateEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  auto picture = GetSamplePicture();
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  SkCanvas dummy_canvas;
+
+  MutatorsStack mutators_stack;
+  Stopwatch raster_time;
+  Stopwatch ui_time;
+  TextureRegistry texture_registry;
+  PrerollContext preroll_context = {
+      &cache,           /* raster_cache */
+      nullptr,          /* gr_context */
+      nullptr,          /* external_view_embedder */
+      mutators_stack,   /* mutators_stack */
+      srgb.get(),       /* color_space */
+      kGiantRect,       /* cull_rect */
+      false,            /* layer reads from surface */
+      raster_time,      /* raster stopwatch */
+      ui_time,          /* frame build stopwatch */
+      texture_registry, /* texture_registry */
+      false,            /* checkerboard_offscreen_layers */
+      1.0f,             /* frame_device_pixel_ratio */
+  };
+
+  cache.BeginRecordingPrepares();
+  ASSERT_FALSE(cache.Prepare(nullptr, picture.get(), SkMatrix::I(),
+                             srgb.get(), true, false));
+  RasterCache::PrepareRecording recording = cache.EndRecordingPrepares();
+  // 1st access.
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+
+  cache.ReplayPrepares(&preroll_context, recording);
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+}
+
+TEST(RasterCache, ReRecordedPictureHitsEntryOfSameFingerprint) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  SkCanvas dummy_canvas;
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  auto picture = GetSamplePicture();
+  PictureFingerprint fingerprint = ComputePictureFingerprint(*picture);
+  ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                             false, fingerprint));
+  // 1st access.
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas, fingerprint));
+  cache.SweepAfterFrame();
+
+  // Every frame re-records the picture, which gets a new unique ID but keeps
+  // its fingerprint.
+  for (int i = 0; i < 3; i++) {
+    auto recorded = GetSamplePicture();
+    ASSERT_NE(recorded->uniqueID(), picture->uniqueID());
+    PictureFingerprint recorded_fingerprint =
+        ComputePictureFingerprint(*recorded);
+    ASSERT_EQ(recorded_fingerprint, fingerprint);
+
+    ASSERT_TRUE(cache.Prepare(NULL, recorded.get(), matrix, srgb.get(), true,
+                              false, recorded_fingerprint));
+    ASSERT_TRUE(cache.Draw(*recorded, dummy_canvas, recorded_fingerprint));
+    ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+    cache.SweepAfterFrame();
+    picture = recorded;
+  }
+}
+
+TEST(RasterCache, ReRecordedPictureMissesWithoutFingerprint) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  SkCanvas dummy_canvas;
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  for (int i = 0; i < 3; i++) {
+    auto picture = GetSamplePicture();
+    ASSERT_FALSE(
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+    ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+    cache.SweepAfterFrame();
+  }
+}
+
+TEST(RasterCache, PictureComplexityIsSharedBySameFingerprint) {
+  flutter::RasterCache cache;
+  auto first = GetBlurredPicture();
+  auto second = GetBlurredPicture();
+  PictureFingerprint fingerprint = ComputePictureFingerprint(*first);
+  ASSERT_EQ(ComputePictureFingerprint(*second), fingerprint);
+
+  EXPECT_EQ(&cache.GetPictureComplexity(first.get(), fingerprint),
+            &cache.GetPictureComplexity(second.get(), fingerprint));
+  EXPECT_NE(&cache.GetPictureComplexity(first.get()),
+            &cache.GetPictureComplexity(second.get()));
+}
+
+TEST(RasterCache, CollidingFingerprintDoesNotDrawOtherPicture) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  SkCanvas dummy_canvas;
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  auto picture = GetSamplePicture();
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(100, 100));
+  recorder.getRecordingCanvas()->drawRect(SkRect::MakeWH(50, 50), SkPaint());
+  auto other = recorder.finishRecordingAsPicture();
+  // Pretend that the fingerprints of the two pictures collide.
+  PictureFingerprint fingerprint = ComputePictureFingerprint(*picture);
+
+  ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                             false, fingerprint));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas, fingerprint));
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                            false, fingerprint));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas, fingerprint));
+
+  EXPECT_FALSE(cache.Draw(*other, dummy_canvas, fingerprint));
+  // Preparing the other picture takes the entry over.
+  EXPECT_FALSE(cache.Prepare(NULL, other.get(), matrix, srgb.get(), true,
+                             false, fingerprint));
+  EXPECT_FALSE(cache.Draw(*picture, dummy_canvas, fingerprint));
+  EXPECT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+}
+
+TEST(RasterCache, ZoomMissesCacheWithoutScaleTolerance) {
+  CountingRasterCache cache(3);
+  auto picture = GetSamplePicture();
+
+  std::vector<ReplayedFrame> expected(22, {0, false});
+  // The last scale is warm after three frames.
+  expected.push_back({0, false});
+  expected.push_back({0, false});
+  expected.push_back({1, true});
+  EXPECT_EQ(ReplayZoomAnimation(cache, picture.get(), 22, 3), expected);
+}
+
+TEST(RasterCache, ZoomReusesEntriesWithinScaleTolerance) {
+  CountingRasterCache cache(3);
+  cache.SetScaleTolerance(0.1);
+  auto picture = GetSamplePicture();
+
+  std::vector<ReplayedFrame> expected;
+  // Four 2% steps stay within 10% of the last rasterized scale. The fifth
+  // goes past it and is rasterized right away.
+  for (int i = 0; i < 4; i++) {
+    expected.insert(expected.end(), 4, {0, true});
+    expected.push_back({1, true});
+  }
+  expected.insert(expected.end(), 2, {0, true});
+  // Once the scale settles, it is rasterized sharply when it is warm.
+  expected.push_back({0, true});
+  expected.push_back({0, true});
+  expected.push_back({1, true});
+  EXPECT_EQ(ReplayZoomAnimation(cache, picture.get(), 22, 3), expected);
+  EXPECT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+}
+
+TEST(RasterCache, ScaledEntryIsKeptWhileDrawn) {
+  CountingRasterCache cache(1);
+  cache.SetScaleTolerance(0.25);
+  auto picture = GetSamplePicture();
+
+  ReplayFrame(cache, picture.get(), 1);
+  ASSERT_EQ(ReplayFrame(cache, picture.get(), 1), (ReplayedFrame{1, true}));
+  // The access threshold of 1 is reached on the second frame at a scale, and
+  // the first draws the 1x entry, which the sweep must not remove.
+  EXPECT_EQ(ReplayFrame(cache, picture.get(), 1.2), (ReplayedFrame{0, true}));
+  EXPECT_EQ(ReplayFrame(cache, picture.get(), 1.2), (ReplayedFrame{1, true}));
+  // Past the tolerance of the 1.2x entry.
+  EXPECT_EQ(ReplayFrame(cache, picture.get(), 2), (ReplayedFrame{1, true}));
+  // Entries are never drawn flipped, so this is rasterized too.
+  EXPECT_EQ(ReplayFrame(cache, picture.get(), -2), (ReplayedFrame{1, true}));
+}
+
+TEST(RasterCache, AtlasEntryDrawsLikeImageEntry) {
+  auto picture = GetBlurredPicture();
+  const SkPoint offset = SkPoint::Make(10, 20);
+
+  flutter::RasterCache cache(1);
+  std::vector<SkColor> expected = DrawFromCache(cache, picture.get(), offset);
+  EXPECT_EQ(cache.GetAtlasPageCount(), 0u);
+
+  flutter::RasterCache atlas_cache(1);
+  atlas_cache.SetAtlasEnabled(true);
+  EXPECT_EQ(DrawFromCache(atlas_cache, picture.get(), offset), expected);
+  EXPECT_EQ(atlas_cache.GetAtlasPageCount(), 1u);
+  EXPECT_GT(atlas_cache.GetAtlasOccupancy(), 0);
+
+  atlas_cache.Clear();
+  EXPECT_EQ(atlas_cache.GetAtlasPageCount(), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
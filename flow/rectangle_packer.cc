@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/rectangle_packer.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace flutter {
+
+RectanglePacker::RectanglePacker(int width, int height)
+    : width_(width), height_(height) {
+  Reset();
+}
+
+void RectanglePacker::Reset() {
+  skyline_.clear();
+  skyline_.push_back({0, 0, width_});
+  allocated_area_ = 0;
+}
+
+bool RectanglePacker::Allocate(int width, int height, SkIPoint* location) {
+  if (width <= 0 || height <= 0 || width > width_ || height > height_) {
+    return false;
+  }
+
+  size_t best_index = skyline_.size();
+  int best_y = std::numeric_limits<int>::max();
+  int best_width = std::numeric_limits<int>::max();
+  for (size_t i = 0; i < skyline_.size(); i++) {
+    int y;
+    if (!Fits(i, width, height, &y)) {
+      continue;
+    }
+    // Prefer the lowest spot, and then the narrowest segment, which wastes
+    // the least room.
+    if (y < best_y || (y == best_y && skyline_[i].width < best_width)) {
+      best_index = i;
+      best_y = y;
+      best_width = skyline_[i].width;
+    }
+  }
+  if (best_index == skyline_.size()) {
+    return false;
+  }
+
+  const int x = skyline_[best_index].x;
+  AddLevel(best_index, x, best_y, width, height);
+  allocated_area_ += static_cast<int64_t>(width) * height;
+  location->set(x, best_y);
+  return true;
+}
+
+bool RectanglePacker::Fits(size_t index, int width, int height, int* y) const {
+  if (skyline_[index].x + width > width_) {
+    return false;
+  }
+  int top = skyline_[index].y;
+  for (int width_left = width; width_left > 0; index++) {
+    top = std::max(top, skyline_[index].y);
+    if (top + height > height_) {
+      return false;
+    }
+    width_left -= skyline_[index].width;
+  }
+  *y = top;
+  return true;
+}
+
+void RectanglePacker::AddLevel(size_t index,
+                               int x,
+                               int y,
+                               int width,
+                               int height) {
+  skyline_.insert(skyline_.begin() + index, {x, y + height, width});
+
+  // Trim the segments that are now below the new one.
+  const int right = x + width;
+  for (size_t i = index + 1; i < skyline_.size();) {
+    Segment& segment = skyline_[i];
+    if (segment.x >= right) {
+      break;
+    }
+    const int overlap = right - segment.x;
+    if (overlap < segment.width) {
+      segment.x += overlap;
+      segment.width -= overlap;
+      break;
+    }
+    skyline_.erase(skyline_.begin() + i);
+  }
+
+  // Merge neighbouring segments of the same height.
+  for (size_t i = 0; i + 1 < skyline_.size();) {
+    if (skyline_[i].y == skyline_[i + 1].y) {
+      skyline_[i].width += skyline_[i + 1].width;
+      skyline_.erase(skyline_.begin() + i + 1);
+    } else {
+      i++;
+    }
+  }
+}
+
+}  // namespace flutter
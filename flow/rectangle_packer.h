@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RECTANGLE_PACKER_H_
+#define FLUTTER_FLOW_RECTANGLE_PACKER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "third_party/skia/include/core/SkPoint.h"
+
+namespace flutter {
+
+// Packs rectangles into an area of a fixed size with the skyline bottom-left
+// heuristic: each rectangle goes where its bottom edge is the lowest, on top
+// of the rectangles already packed. Rectangles can't be freed individually,
+// only all at once by |Reset|.
+class RectanglePacker {
+ public:
+  RectanglePacker(int width, int height);
+
+  // Finds room for a |width| x |height| rectangle and sets |location| to its
+  // top-left corner. Returns false if there is no room left for it.
+  bool Allocate(int width, int height, SkIPoint* location);
+
+  // Frees all the rectangles.
+  void Reset();
+
+  int width() const { return width_; }
+
+  int height() const { return height_; }
+
+  // The total area of the rectangles allocated since the last reset.
+  int64_t allocated_area() const { return allocated_area_; }
+
+ private:
+  // A horizontal segment of the skyline: the top edge of the rectangles
+  // packed below it.
+  struct Segment {
+    int x;
+    int y;
+    int width;
+  };
+
+  // Returns whether a |width| x |height| rectangle fits with its left edge at
+  // the start of segment |index|, and sets |y| to where its top edge would be.
+  bool Fits(size_t index, int width, int height, int* y) const;
+
+  void AddLevel(size_t index, int x, int y, int width, int height);
+
+  const int width_;
+  const int height_;
+  int64_t allocated_area_ = 0;
+  // Sorted by x, covering the whole width without overlaps.
+  std::vector<Segment> skyline_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RECTANGLE_PACKER_H_
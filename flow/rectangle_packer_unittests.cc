@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/rectangle_packer.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(RectanglePacker, PacksRectanglesWithoutOverlaps) {
+  RectanglePacker packer(100, 100);
+  std::vector<SkIRect> rects;
+  // Mixed sizes that fill about half of the area.
+  for (int i = 0; i < 40; i++) {
+    const int width = 5 + (i * 7) % 11;
+    const int height = 5 + (i * 5) % 13;
+    SkIPoint location;
+    ASSERT_TRUE(packer.Allocate(width, height, &location)) << i;
+    SkIRect rect = SkIRect::MakeXYWH(location.x(), location.y(), width, height);
+    EXPECT_TRUE(SkIRect::MakeWH(100, 100).contains(rect));
+    for (const SkIRect& other : rects) {
+      EXPECT_FALSE(SkIRect::Intersects(rect, other));
+    }
+    rects.push_back(rect);
+  }
+}
+
+TEST(RectanglePacker, FillsAreaWithEqualRectangles) {
+  RectanglePacker packer(100, 100);
+  SkIPoint location;
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(packer.Allocate(10, 10, &location)) << i;
+  }
+  EXPECT_EQ(packer.allocated_area(), 100 * 100);
+  EXPECT_FALSE(packer.Allocate(1, 1, &location));
+}
+
+TEST(RectanglePacker, RejectsRectanglesThatDontFit) {
+  RectanglePacker packer(100, 50);
+  SkIPoint location;
+  EXPECT_FALSE(packer.Allocate(101, 10, &location));
+  EXPECT_FALSE(packer.Allocate(10, 51, &location));
+  EXPECT_FALSE(packer.Allocate(0, 10, &location));
+  EXPECT_TRUE(packer.Allocate(100, 50, &location));
+  EXPECT_EQ(location, SkIPoint::Make(0, 0));
+}
+
+TEST(RectanglePacker, ResetFreesAllRectangles) {
+  RectanglePacker packer(100, 100);
+  SkIPoint location;
+  ASSERT_TRUE(packer.Allocate(100, 60, &location));
+  ASSERT_FALSE(packer.Allocate(100, 60, &location));
+
+  packer.Reset();
+  EXPECT_EQ(packer.allocated_area(), 0);
+  ASSERT_TRUE(packer.Allocate(100, 60, &location));
+  EXPECT_EQ(location, SkIPoint::Make(0, 0));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -6,6 +6,7 @@
 
 #include <list>
 
+#include "flutter/flow/geometry_kernels.h"
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkBBHFactory.h"
 
@@ -18,6 +19,8 @@ void RTree::insert(const SkRect boundsArray[],
                    int N) {
   FML_DCHECK(0 == all_ops_count_);
   bbh_->insert(boundsArray, metadata, N);
+  bounds_.setEmpty();
+  JoinRects(boundsArray, N, &bounds_);
   for (int i = 0; i < N; i++) {
     if (metadata != nullptr && metadata[i].isDraw) {
       draw_op_[i] = boundsArray[i];
@@ -36,6 +39,9 @@ void RTree::search(const SkRect& query, std::vector<int>* results) const {
 
 std::list<SkRect> RTree::searchNonOverlappingDrawnRects(
     const SkRect& query) const {
+  if (!SkRect::Intersects(query, bounds_)) {
+    return {};
+  }
   // Get the indexes for the operations that intersect with the query rect.
   std::vector<int> intermediary_results;
   search(query, &intermediary_results);
@@ -44,6 +44,8 @@ class RTree : public SkBBoxHierarchy {
   // A map containing the draw operation rects keyed off the operation index
   // in the insert call.
   std::map<int, SkRect> draw_op_;
+  // The union of the rects of all the operations in the tree.
+  SkRect bounds_ = SkRect::MakeEmpty();
   sk_sp<SkBBoxHierarchy> bbh_;
   int all_ops_count_;
 };
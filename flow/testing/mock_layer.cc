@@ -23,6 +23,7 @@ void MockLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   parent_matrix_ = matrix;
   parent_cull_rect_ = context->cull_rect;
   parent_has_platform_view_ = context->has_platform_view;
+  preroll_count_++;
 
   context->has_platform_view = fake_has_platform_view_;
   set_paint_bounds(fake_paint_path_.getBounds());
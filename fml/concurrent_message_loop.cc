@@ -12,17 +12,21 @@
 namespace fml {
 
 std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
-    size_t worker_count) {
+    size_t worker_count,
+    uint64_t cpu_affinity_mask) {
   return std::shared_ptr<ConcurrentMessageLoop>{
-      new ConcurrentMessageLoop(worker_count)};
+      new ConcurrentMessageLoop(worker_count, cpu_affinity_mask)};
 }
 
-ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
+ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count,
+                                             uint64_t cpu_affinity_mask)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
   for (size_t i = 0; i < worker_count_; ++i) {
-    workers_.emplace_back([i, this]() {
-      fml::Thread::SetCurrentThreadName(
-          std::string{"io.flutter.worker." + std::to_string(i + 1)});
+    workers_.emplace_back([i, cpu_affinity_mask, this]() {
+      fml::Thread::ThreadConfig config;
+      config.name = "io.flutter.worker." + std::to_string(i + 1);
+      config.cpu_affinity_mask = cpu_affinity_mask;
+      fml::Thread::SetCurrentThreadConfig(config);
       WorkerMain();
     });
   }
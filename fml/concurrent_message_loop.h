@@ -21,8 +21,12 @@ class ConcurrentTaskRunner;
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
+  // The workers may only run on the CPUs in |cpu_affinity_mask|, one bit per
+  // CPU, so that they can be kept off the cores of latency sensitive threads.
+  // Zero allows all CPUs.
   static std::shared_ptr<ConcurrentMessageLoop> Create(
-      size_t worker_count = std::thread::hardware_concurrency());
+      size_t worker_count = std::thread::hardware_concurrency(),
+      uint64_t cpu_affinity_mask = 0);
 
   ~ConcurrentMessageLoop();
 
@@ -46,7 +50,7 @@ class ConcurrentMessageLoop
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
   bool shutdown_ = false;
 
-  ConcurrentMessageLoop(size_t worker_count);
+  ConcurrentMessageLoop(size_t worker_count, uint64_t cpu_affinity_mask);
 
   void WorkerMain();
 
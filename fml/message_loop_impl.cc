@@ -117,7 +117,7 @@ void MessageLoopImpl::DoTerminate() {
   Terminate();
 }
 
-void MessageLoopImpl::FlushTasks(FlushType type) {
+void MessageLoopImpl::FlushTasks(FlushType type, fml::TimePoint deadline) {
   TRACE_EVENT0("fml", "MessageLoop::FlushTasks");
 
   const auto now = fml::TimePoint::Now();
@@ -136,6 +136,10 @@ void MessageLoopImpl::FlushTasks(FlushType type) {
     if (type == FlushType::kSingle) {
       break;
     }
+    if (deadline != fml::TimePoint::Max() &&
+        fml::TimePoint::Now() >= deadline) {
+      break;
+    }
   } while (invocation);
 }
 
@@ -147,6 +151,10 @@ void MessageLoopImpl::RunSingleExpiredTaskNow() {
   FlushTasks(FlushType::kSingle);
 }
 
+void MessageLoopImpl::RunExpiredTasksUntil(fml::TimePoint deadline) {
+  FlushTasks(FlushType::kAll, deadline);
+}
+
 TaskQueueId MessageLoopImpl::GetTaskQueueId() const {
   return queue_id_;
 }
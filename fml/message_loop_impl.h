@@ -55,6 +55,10 @@ class MessageLoopImpl : public Wakeable,
 
   void RunSingleExpiredTaskNow();
 
+  // Like |RunExpiredTasksNow|, but stops running tasks at |deadline|, leaving
+  // the remaining expired tasks for the next wakeup.
+  void RunExpiredTasksUntil(fml::TimePoint deadline);
+
  protected:
   MessageLoopImpl();
 
@@ -64,7 +68,8 @@ class MessageLoopImpl : public Wakeable,
 
   std::atomic_bool terminated_;
 
-  void FlushTasks(FlushType type);
+  void FlushTasks(FlushType type,
+                  fml::TimePoint deadline = fml::TimePoint::Max());
 
   FML_DISALLOW_COPY_AND_ASSIGN(MessageLoopImpl);
 };
@@ -6,6 +6,7 @@
 
 #include "flutter/fml/message_loop.h"
 
+#include <atomic>
 #include <iostream>
 #include <thread>
 
@@ -16,6 +17,10 @@
 #include "flutter/fml/task_runner.h"
 #include "gtest/gtest.h"
 
+#if defined(OS_LINUX)
+#include <sched.h>
+#endif
+
 #define TIMESENSITIVE(x) TimeSensitiveTest_##x
 #if OS_WIN
 #define PLATFORM_SPECIFIC_CAPTURE(...) [ __VA_ARGS__, count ]
@@ -297,6 +302,33 @@ TEST(MessageLoop, CanCreateAndShutdownConcurrentMessageLoopsOverAndOver) {
   }
 }
 
+#if defined(OS_LINUX)
+TEST(MessageLoop, ConcurrentMessageLoopWorkersApplyCPUAffinity) {
+  cpu_set_t allowed_set;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed_set), &allowed_set), 0);
+  size_t first_cpu = 0;
+  while (!CPU_ISSET(first_cpu, &allowed_set)) {
+    first_cpu++;
+  }
+  ASSERT_LT(first_cpu, 64u);
+
+  auto loop =
+      fml::ConcurrentMessageLoop::Create(2u, uint64_t{1} << first_cpu);
+  fml::CountDownLatch latch(loop->GetWorkerCount());
+  std::atomic_size_t pinned_workers = 0;
+  loop->PostTaskToAllWorkers([&]() {
+    cpu_set_t worker_set;
+    sched_getaffinity(0, sizeof(worker_set), &worker_set);
+    if (CPU_COUNT(&worker_set) == 1 && CPU_ISSET(first_cpu, &worker_set)) {
+      pinned_workers++;
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  EXPECT_EQ(pinned_workers, loop->GetWorkerCount());
+}
+#endif  // defined(OS_LINUX)
+
 TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   auto loop = fml::ConcurrentMessageLoop::Create();
   auto task_runner = loop->GetTaskRunner();
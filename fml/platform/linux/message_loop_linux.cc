@@ -14,10 +14,20 @@ namespace fml {
 
 static constexpr int kClockType = CLOCK_MONOTONIC;
 
+// The longest the loop runs expired tasks before it goes back to waiting,
+// where it notices that it was terminated.
+static constexpr fml::TimeDelta kTaskRunBudget =
+    fml::TimeDelta::FromMilliseconds(8);
+
+// The loop that is running on the current thread.
+static thread_local MessageLoopLinux* tls_running_loop = nullptr;
+
 MessageLoopLinux::MessageLoopLinux()
     : epoll_fd_(FML_HANDLE_EINTR(::epoll_create(1 /* unused */))),
       timer_fd_(::timerfd_create(kClockType, TFD_NONBLOCK | TFD_CLOEXEC)),
-      running_(false) {
+      running_(false),
+      timer_wake_time_(fml::TimePoint::Max()),
+      timer_rearm_count_(0) {
   FML_CHECK(epoll_fd_.is_valid());
   FML_CHECK(timer_fd_.is_valid());
   bool added_source = AddOrRemoveTimerSource(true);
@@ -29,6 +39,10 @@ MessageLoopLinux::~MessageLoopLinux() {
   FML_CHECK(removed_source);
 }
 
+MessageLoopLinux* MessageLoopLinux::GetCurrent() {
+  return tls_running_loop;
+}
+
 bool MessageLoopLinux::AddOrRemoveTimerSource(bool add) {
   struct epoll_event event = {};
 
@@ -43,9 +57,14 @@ bool MessageLoopLinux::AddOrRemoveTimerSource(bool add) {
   return ctl_result == 0;
 }
 
+size_t MessageLoopLinux::GetTimerRearmCount() const {
+  return timer_rearm_count_.load(std::memory_order_relaxed);
+}
+
 // |fml::MessageLoopImpl|
 void MessageLoopLinux::Run() {
   running_ = true;
+  tls_running_loop = this;
 
   while (running_) {
     struct epoll_event event = {};
@@ -70,6 +89,8 @@ void MessageLoopLinux::Run() {
       OnEventFired();
     }
   }
+
+  tls_running_loop = nullptr;
 }
 
 // |fml::MessageLoopImpl|
@@ -80,13 +101,49 @@ void MessageLoopLinux::Terminate() {
 
 // |fml::MessageLoopImpl|
 void MessageLoopLinux::WakeUp(fml::TimePoint time_point) {
+  std::scoped_lock lock(timer_mutex_);
+  if (running_tasks_) {
+    // The task queues request a wakeup for their next task after every task
+    // they hand out. Rearming the timer once when the tasks are done spares
+    // a syscall per task.
+    deferred_wake_time_ = time_point;
+    return;
+  }
+  RearmTimerLocked(time_point);
+}
+
+void MessageLoopLinux::RearmTimerLocked(fml::TimePoint time_point) {
+  if (timer_wake_time_ <= time_point) {
+    // The timer fires no later than requested. The tasks it runs request the
+    // wakeup for the tasks that are left, so this one can be skipped.
+    return;
+  }
   bool result = TimerRearm(timer_fd_.get(), time_point);
   FML_DCHECK(result);
+  timer_wake_time_ = time_point;
+  timer_rearm_count_.fetch_add(1, std::memory_order_relaxed);
 }
 
 void MessageLoopLinux::OnEventFired() {
-  if (TimerDrain(timer_fd_.get())) {
-    RunExpiredTasksNow();
+  if (!TimerDrain(timer_fd_.get())) {
+    return;
+  }
+
+  {
+    std::scoped_lock lock(timer_mutex_);
+    timer_wake_time_ = fml::TimePoint::Max();
+    running_tasks_ = true;
+  }
+
+  // Expired tasks that don't fit in the budget run on the next wakeup, which
+  // they request right away.
+  RunExpiredTasksUntil(fml::TimePoint::Now() + kTaskRunBudget);
+
+  std::scoped_lock lock(timer_mutex_);
+  running_tasks_ = false;
+  if (deferred_wake_time_.has_value()) {
+    RearmTimerLocked(deferred_wake_time_.value());
+    deferred_wake_time_.reset();
   }
 }
 
@@ -6,6 +6,8 @@
 #define FLUTTER_FML_PLATFORM_LINUX_MESSAGE_LOOP_LINUX_H_
 
 #include <atomic>
+#include <mutex>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/message_loop_impl.h"
@@ -14,10 +16,28 @@
 namespace fml {
 
 class MessageLoopLinux : public MessageLoopImpl {
+ public:
+  // Returns the loop that is running on the current thread, or null if there
+  // is none.
+  static MessageLoopLinux* GetCurrent();
+
+  // The number of times the timer has been rearmed, for benchmarks.
+  size_t GetTimerRearmCount() const;
+
  private:
   fml::UniqueFD epoll_fd_;
   fml::UniqueFD timer_fd_;
-  bool running_;
+  std::atomic_bool running_;
+
+  // Guards the state of the timer below. |WakeUp| is called from any thread.
+  std::mutex timer_mutex_;
+  // When the timer will fire, or |fml::TimePoint::Max()| if it has fired.
+  fml::TimePoint timer_wake_time_;
+  // Set while running tasks, which request wakeups after each task. Only the
+  // last request of the run is applied.
+  bool running_tasks_ = false;
+  std::optional<fml::TimePoint> deferred_wake_time_;
+  std::atomic<size_t> timer_rearm_count_;
 
   MessageLoopLinux();
 
@@ -34,6 +54,8 @@ class MessageLoopLinux : public MessageLoopImpl {
 
   void OnEventFired();
 
+  void RearmTimerLocked(fml::TimePoint time_point);
+
   bool AddOrRemoveTimerSource(bool add);
 
   FML_FRIEND_MAKE_REF_COUNTED(MessageLoopLinux);
@@ -0,0 +1,65 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/platform/linux/message_loop_linux.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+
+namespace fml {
+namespace benchmarking {
+
+static MessageLoopLinux* GetLoop(fml::Thread& thread) {
+  MessageLoopLinux* loop = nullptr;
+  fml::AutoResetWaitableEvent done;
+  thread.GetTaskRunner()->PostTask([&loop, &done]() {
+    loop = MessageLoopLinux::GetCurrent();
+    done.Signal();
+  });
+  done.Wait();
+  return loop;
+}
+
+// Posts bursts of tasks from another thread, like a platform thread sending
+// messages to the UI thread. Reports how often the loop rearms its timer per
+// task, which is one syscall each.
+static void BM_PostTaskBurst(benchmark::State& state) {  // NOLINT
+  fml::Thread thread("burst");
+  MessageLoopLinux* loop = GetLoop(thread);
+  auto task_runner = thread.GetTaskRunner();
+  const int64_t burst_size = state.range(0);
+
+  const size_t rearm_count = loop->GetTimerRearmCount();
+  while (state.KeepRunning()) {
+    fml::CountDownLatch done(burst_size);
+    for (int64_t i = 0; i < burst_size; i++) {
+      task_runner->PostTask([&done]() { done.CountDown(); });
+    }
+    done.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * burst_size);
+  state.counters["TimerRearmsPerTask"] =
+      static_cast<double>(loop->GetTimerRearmCount() - rearm_count) /
+      (state.iterations() * burst_size);
+}
+
+// Measures the latency of a task posted to an idle loop.
+static void BM_PostTaskRoundTrip(benchmark::State& state) {  // NOLINT
+  fml::Thread thread("round_trip");
+  auto task_runner = thread.GetTaskRunner();
+  fml::AutoResetWaitableEvent done;
+  while (state.KeepRunning()) {
+    task_runner->PostTask([&done]() { done.Signal(); });
+    done.Wait();
+  }
+}
+
+BENCHMARK(BM_PostTaskBurst)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_PostTaskRoundTrip);
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/platform/linux/message_loop_linux.h"
+
+#include <functional>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+namespace {
+
+// Runs |task| on the thread of |thread| and waits for it.
+void RunOnThread(fml::Thread& thread, const std::function<void()>& task) {
+  fml::AutoResetWaitableEvent done;
+  thread.GetTaskRunner()->PostTask([&task, &done]() {
+    task();
+    done.Signal();
+  });
+  done.Wait();
+}
+
+}  // namespace
+
+TEST(MessageLoopLinux, TasksPostedWhileRunningTasksDontRearmTimer) {
+  fml::Thread thread("rearm");
+  MessageLoopLinux* loop = nullptr;
+  RunOnThread(thread, [&]() { loop = MessageLoopLinux::GetCurrent(); });
+
+  // Block the loop in a task while posting a burst of tasks to it.
+  const size_t kTaskCount = 1000;
+  fml::AutoResetWaitableEvent blocking;
+  fml::AutoResetWaitableEvent release;
+  fml::CountDownLatch done(kTaskCount);
+  thread.GetTaskRunner()->PostTask([&]() {
+    blocking.Signal();
+    release.Wait();
+  });
+  blocking.Wait();
+
+  const size_t rearm_count = loop->GetTimerRearmCount();
+  for (size_t i = 0; i < kTaskCount; i++) {
+    thread.GetTaskRunner()->PostTask([&done]() { done.CountDown(); });
+  }
+  release.Signal();
+  done.Wait();
+
+  // Running the burst may take more than one wakeup if it exceeds the time
+  // budget of a wakeup, but never anywhere near one per task.
+  EXPECT_LT(loop->GetTimerRearmCount() - rearm_count, kTaskCount / 10);
+}
+
+}  // namespace testing
+}  // namespace fml
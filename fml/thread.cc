@@ -6,6 +6,7 @@
 
 #include "flutter/fml/thread.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -15,25 +16,97 @@
 
 #if defined(OS_WIN)
 #include <windows.h>
-#elif defined(OS_FUCHSIA)
-#include <lib/zx/thread.h>
 #else
 #include <pthread.h>
 #endif
 
+#if defined(OS_FUCHSIA)
+#include <lib/zx/thread.h>
+#endif
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <sched.h>
+#include <sys/resource.h>
+#endif
+
 namespace fml {
 
-Thread::Thread(const std::string& name) : joined_(false) {
+// Starts a thread with the stack size of a |ThreadConfig|, which std::thread
+// can't set.
+class Thread::ThreadHandle {
+ public:
+  ThreadHandle(size_t stack_size, std::function<void()> function);
+
+  void Join();
+
+ private:
+#if defined(OS_WIN)
+  std::thread thread_;
+#else
+  pthread_t thread_;
+#endif
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadHandle);
+};
+
+#if defined(OS_WIN)
+
+Thread::ThreadHandle::ThreadHandle(size_t stack_size,
+                                   std::function<void()> function)
+    : thread_(std::move(function)) {
+  if (stack_size > 0) {
+    FML_DLOG(INFO) << "Could not set the stack size of the thread on this "
+                      "platform.";
+  }
+}
+
+void Thread::ThreadHandle::Join() {
+  thread_.join();
+}
+
+#else  // defined(OS_WIN)
+
+Thread::ThreadHandle::ThreadHandle(size_t stack_size,
+                                   std::function<void()> function) {
+  pthread_attr_t attributes;
+  pthread_attr_init(&attributes);
+  if (stack_size > 0 &&
+      pthread_attr_setstacksize(&attributes, stack_size) != 0) {
+    FML_LOG(ERROR) << "Could not set the stack size of the thread to "
+                   << stack_size << " bytes.";
+  }
+  auto main = [](void* arg) -> void* {
+    std::unique_ptr<std::function<void()>> function(
+        static_cast<std::function<void()>*>(arg));
+    (*function)();
+    return nullptr;
+  };
+  int result = pthread_create(&thread_, &attributes, main,
+                              new std::function<void()>(std::move(function)));
+  pthread_attr_destroy(&attributes);
+  FML_CHECK(result == 0);
+}
+
+void Thread::ThreadHandle::Join() {
+  pthread_join(thread_, nullptr);
+}
+
+#endif  // defined(OS_WIN)
+
+Thread::Thread(const std::string& name) : Thread(ThreadConfig{name}) {}
+
+Thread::Thread(const ThreadConfig& config) : joined_(false) {
   fml::AutoResetWaitableEvent latch;
   fml::RefPtr<fml::TaskRunner> runner;
-  thread_ = std::make_unique<std::thread>([&latch, &runner, name]() -> void {
-    SetCurrentThreadName(name);
-    fml::MessageLoop::EnsureInitializedForCurrentThread();
-    auto& loop = MessageLoop::GetCurrent();
-    runner = loop.GetTaskRunner();
-    latch.Signal();
-    loop.Run();
-  });
+  thread_ = std::make_unique<ThreadHandle>(
+      config.stack_size, [&latch, &runner, config]() -> void {
+        SetCurrentThreadConfig(config);
+        fml::MessageLoop::EnsureInitializedForCurrentThread();
+        auto& loop = MessageLoop::GetCurrent();
+        runner = loop.GetTaskRunner();
+        latch.Signal();
+        loop.Run();
+      });
   latch.Wait();
   task_runner_ = runner;
 }
@@ -52,7 +125,7 @@ void Thread::Join() {
   }
   joined_ = true;
   task_runner_->PostTask([]() { MessageLoop::GetCurrent().Terminate(); });
-  thread_->join();
+  thread_->Join();
 }
 
 #if defined(OS_WIN)
@@ -94,4 +167,66 @@ void Thread::SetCurrentThreadName(const std::string& name) {
 #endif
 }
 
+static void SetCurrentThreadAffinity(uint64_t cpu_affinity_mask) {
+  if (cpu_affinity_mask == 0) {
+    return;
+  }
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (size_t cpu = 0; cpu < 64; cpu++) {
+    if (cpu_affinity_mask & (uint64_t{1} << cpu)) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    FML_LOG(ERROR) << "Could not set the CPU affinity of the thread.";
+  }
+#elif defined(OS_WIN)
+  if (SetThreadAffinityMask(GetCurrentThread(),
+                            static_cast<DWORD_PTR>(cpu_affinity_mask)) == 0) {
+    FML_LOG(ERROR) << "Could not set the CPU affinity of the thread.";
+  }
+#else
+  FML_DLOG(INFO) << "Could not set the CPU affinity of the thread on this "
+                    "platform.";
+#endif
+}
+
+static void SetCurrentThreadPriority(const Thread::ThreadConfig& config) {
+#if !defined(OS_WIN)
+  if (config.realtime_priority.has_value()) {
+    sched_param param = {};
+    param.sched_priority = config.realtime_priority.value();
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0) {
+      return;
+    }
+    // Most processes may not use real-time policies. Fall back to the nice
+    // value, if any.
+    FML_DLOG(INFO) << "Could not run the thread with SCHED_FIFO.";
+  }
+#endif
+
+  if (!config.nice.has_value()) {
+    return;
+  }
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // On Linux, the nice value is a property of each thread and the process ID
+  // of zero refers to the calling thread.
+  if (setpriority(PRIO_PROCESS, 0, config.nice.value()) != 0) {
+    FML_LOG(ERROR) << "Could not set the nice value of the thread to "
+                   << config.nice.value() << ".";
+  }
+#else
+  FML_DLOG(INFO) << "Could not set the nice value of the thread on this "
+                    "platform.";
+#endif
+}
+
+void Thread::SetCurrentThreadConfig(const ThreadConfig& config) {
+  SetCurrentThreadName(config.name);
+  SetCurrentThreadAffinity(config.cpu_affinity_mask);
+  SetCurrentThreadPriority(config);
+}
+
 }  // namespace fml
@@ -7,6 +7,8 @@
 
 #include <atomic>
 #include <memory>
+#include <optional>
+#include <string>
 #include <thread>
 
 #include "flutter/fml/macros.h"
@@ -16,8 +18,33 @@ namespace fml {
 
 class Thread {
  public:
+  // How a thread is named and scheduled. Settings that the platform does not
+  // support, or that the process is not permitted to apply, are logged and
+  // ignored.
+  struct ThreadConfig {
+    std::string name;
+
+    // The nice value of the thread, from -20 to 19. Lower values get more CPU
+    // time, and usually need a privilege to set.
+    std::optional<int> nice;
+
+    // Runs the thread with the SCHED_FIFO policy at this priority, from 1 to
+    // 99, when permitted. Takes precedence over |nice| if it is applied.
+    std::optional<int> realtime_priority;
+
+    // The CPUs the thread may run on, one bit per CPU. Zero allows all of
+    // them.
+    uint64_t cpu_affinity_mask = 0;
+
+    // The size of the stack of the thread in bytes, or zero for the default
+    // of the platform. Has no effect on the calling thread.
+    size_t stack_size = 0;
+  };
+
   explicit Thread(const std::string& name = "");
 
+  explicit Thread(const ThreadConfig& config);
+
   ~Thread();
 
   fml::RefPtr<fml::TaskRunner> GetTaskRunner() const;
@@ -26,8 +53,13 @@ class Thread {
 
   static void SetCurrentThreadName(const std::string& name);
 
+  // Applies everything but the stack size of |config| to the calling thread.
+  static void SetCurrentThreadConfig(const ThreadConfig& config);
+
  private:
-  std::unique_ptr<std::thread> thread_;
+  class ThreadHandle;
+
+  std::unique_ptr<ThreadHandle> thread_;
   fml::RefPtr<fml::TaskRunner> task_runner_;
   std::atomic_bool joined_;
 
@@ -4,8 +4,15 @@
 
 #include "flutter/fml/thread.h"
 
+#include "flutter/fml/build_config.h"
 #include "gtest/gtest.h"
 
+#if defined(OS_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#endif
+
 TEST(Thread, CanStartAndEnd) {
   fml::Thread thread;
   ASSERT_TRUE(thread.GetTaskRunner());
@@ -24,3 +31,74 @@ TEST(Thread, HasARunningMessageLoop) {
   thread.Join();
   ASSERT_TRUE(done);
 }
+
+#if defined(OS_LINUX)
+
+static uint64_t GetCurrentThreadAffinityMask() {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  EXPECT_EQ(sched_getaffinity(0, sizeof(cpu_set), &cpu_set), 0);
+  uint64_t mask = 0;
+  for (size_t cpu = 0; cpu < 64; cpu++) {
+    if (CPU_ISSET(cpu, &cpu_set)) {
+      mask |= uint64_t{1} << cpu;
+    }
+  }
+  return mask;
+}
+
+TEST(Thread, AppliesCPUAffinity) {
+  const uint64_t allowed_mask = GetCurrentThreadAffinityMask();
+  ASSERT_NE(allowed_mask, 0u);
+  // Just the lowest CPU the test may run on.
+  const uint64_t cpu_mask = allowed_mask & (~allowed_mask + 1);
+
+  fml::Thread::ThreadConfig config;
+  config.name = "affinity";
+  config.cpu_affinity_mask = cpu_mask;
+  fml::Thread thread(config);
+  uint64_t thread_mask = 0;
+  thread.GetTaskRunner()->PostTask(
+      [&thread_mask]() { thread_mask = GetCurrentThreadAffinityMask(); });
+  thread.Join();
+
+  EXPECT_EQ(thread_mask, cpu_mask);
+  EXPECT_EQ(GetCurrentThreadAffinityMask(), allowed_mask);
+}
+
+TEST(Thread, AppliesNiceValue) {
+  // Lowering the priority of a thread needs no privilege.
+  fml::Thread::ThreadConfig config;
+  config.name = "nice";
+  config.nice = 19;
+  fml::Thread thread(config);
+  int thread_nice = 0;
+  thread.GetTaskRunner()->PostTask(
+      [&thread_nice]() { thread_nice = getpriority(PRIO_PROCESS, 0); });
+  thread.Join();
+
+  EXPECT_EQ(thread_nice, 19);
+  EXPECT_NE(getpriority(PRIO_PROCESS, 0), 19);
+}
+
+TEST(Thread, AppliesStackSize) {
+  const size_t stack_size = 512 * 1024;
+  fml::Thread::ThreadConfig config;
+  config.name = "stack";
+  config.stack_size = stack_size;
+  fml::Thread thread(config);
+  size_t thread_stack_size = 0;
+  thread.GetTaskRunner()->PostTask([&thread_stack_size]() {
+    pthread_attr_t attributes;
+    ASSERT_EQ(pthread_getattr_np(pthread_self(), &attributes), 0);
+    pthread_attr_getstacksize(&attributes, &thread_stack_size);
+    pthread_attr_destroy(&attributes);
+  });
+  thread.Join();
+
+  // The stack may be rounded up to a whole number of pages.
+  EXPECT_GE(thread_stack_size, stack_size);
+  EXPECT_LT(thread_stack_size, 2 * stack_size);
+}
+
+#endif  // defined(OS_LINUX)
@@ -57,6 +57,9 @@ Scene::Scene(std::shared_ptr<flutter::Layer> rootLayer,
   layer_tree_->set_checkerboard_raster_cache_images(
       checkerboardRasterCacheImages);
   layer_tree_->set_checkerboard_offscreen_layers(checkerboardOffscreenLayers);
+  if (UIDartState::Current()->enable_compiled_layer_trees()) {
+    layer_tree_->Compile();
+  }
 }
 
 Scene::~Scene() {}
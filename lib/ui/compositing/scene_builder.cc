@@ -84,7 +84,7 @@ void SceneBuilder::RegisterNatives(tonic::DartLibraryNatives* natives) {
 SceneBuilder::SceneBuilder() {
   // Add a ContainerLayer as the root layer, so that AddLayer operations are
   // always valid.
-  PushLayer(std::make_shared<flutter::ContainerLayer>());
+  PushLayer(arena_->MakeLayer<flutter::ContainerLayer>());
 }
 
 SceneBuilder::~SceneBuilder() = default;
@@ -204,6 +204,7 @@ void SceneBuilder::pushPhysicalShape(Dart_Handle layer_handle,
 }
 
 void SceneBuilder::addRetained(fml::RefPtr<EngineLayer> retainedLayer) {
+  retainedLayer->Layer()->set_retained();
   AddLayer(retainedLayer->Layer());
 }
 
@@ -218,9 +219,9 @@ void SceneBuilder::addPicture(double dx,
   SkPoint offset = SkPoint::Make(dx, dy);
   SkRect pictureRect = picture->picture()->cullRect();
   pictureRect.offset(offset.x(), offset.y());
-  auto layer = std::make_unique<flutter::PictureLayer>(
+  auto layer = arena_->MakeLayer<flutter::PictureLayer>(
       offset, UIDartState::CreateGPUObject(picture->picture()), !!(hints & 1),
-      !!(hints & 2));
+      !!(hints & 2), picture->fingerprint());
   AddLayer(std::move(layer));
 }
 
@@ -231,7 +232,7 @@ void SceneBuilder::addTexture(double dx,
                               int64_t textureId,
                               bool freeze,
                               int filterQuality) {
-  auto layer = std::make_unique<flutter::TextureLayer>(
+  auto layer = arena_->MakeLayer<flutter::TextureLayer>(
       SkPoint::Make(dx, dy), SkSize::Make(width, height), textureId, freeze,
       static_cast<SkFilterQuality>(filterQuality));
   AddLayer(std::move(layer));
@@ -242,7 +243,7 @@ void SceneBuilder::addPlatformView(double dx,
                                    double width,
                                    double height,
                                    int64_t viewId) {
-  auto layer = std::make_unique<flutter::PlatformViewLayer>(
+  auto layer = arena_->MakeLayer<flutter::PlatformViewLayer>(
       SkPoint::Make(dx, dy), SkSize::Make(width, height), viewId);
   AddLayer(std::move(layer));
 }
@@ -254,7 +255,7 @@ void SceneBuilder::addChildScene(double dx,
                                  double height,
                                  SceneHost* sceneHost,
                                  bool hitTestable) {
-  auto layer = std::make_unique<flutter::ChildSceneLayer>(
+  auto layer = arena_->MakeLayer<flutter::ChildSceneLayer>(
       sceneHost->id(), SkPoint::Make(dx, dy), SkSize::Make(width, height),
       hitTestable);
   AddLayer(std::move(layer));
@@ -268,7 +269,7 @@ void SceneBuilder::addPerformanceOverlay(uint64_t enabledOptions,
                                          double bottom) {
   SkRect rect = SkRect::MakeLTRB(left, top, right, bottom);
   auto layer =
-      std::make_unique<flutter::PerformanceOverlayLayer>(enabledOptions);
+      arena_->MakeLayer<flutter::PerformanceOverlayLayer>(enabledOptions);
   layer->set_paint_bounds(rect);
   AddLayer(std::move(layer));
 }
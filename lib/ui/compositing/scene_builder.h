@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_arena.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/color_filter.h"
@@ -124,6 +125,10 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
   void PushLayer(std::shared_ptr<ContainerLayer> layer);
   void PopLayer();
 
+  // The layers of the scene that Dart can't retain are allocated together,
+  // see |LayerArena|. Pushed layers can be retained through an EngineLayer
+  // and outlive the frame, so they are allocated on the heap.
+  std::shared_ptr<LayerArena> arena_ = LayerArena::Create();
   std::vector<std::shared_ptr<ContainerLayer>> layer_stack_;
   int rasterizer_tracing_threshold_ = 0;
   bool checkerboard_raster_cache_images_ = false;
@@ -49,6 +49,55 @@ void createPath() {
 }
 void _validatePath(Path path) native 'ValidatePath';
 
+@pragma('vm:entry-point')
+void createPathWithPolygons() {
+  final Path path = Path()
+    ..addPolygons(<List<Offset>>[
+      <Offset>[Offset.zero, const Offset(10, 0), const Offset(10, 10)],
+      <Offset>[const Offset(20, 20), const Offset(30, 40)],
+      <Offset>[],
+    ], true);
+  _validatePath(path);
+}
+
+@pragma('vm:entry-point')
+void drawBatch() {
+  final DrawBatch batch = DrawBatch()
+    ..addRect(const Rect.fromLTRB(0, 0, 10, 10))
+    ..addOval(const Rect.fromLTRB(10, 10, 20, 30))
+    ..addCircle(const Offset(50, 50), 10, color: const Color(0xFF00FF00))
+    ..addLine(Offset.zero, const Offset(100, 100));
+  // Grows the storage of the batch.
+  for (int i = 0; i < 100; i++) {
+    final Rect rect = Rect.fromLTWH(i.toDouble(), 0, 1, 1);
+    batch.addRect(rect, color: Color(0xFF000000 + i));
+  }
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  canvas.drawBatch(batch, Paint());
+  _validatePicture(recorder.endRecording());
+}
+void _validatePicture(Picture picture) native 'ValidatePicture';
+
+@pragma('vm:entry-point')
+void recordRects(bool batched) {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  final Paint paint = Paint();
+  if (batched) {
+    final DrawBatch batch = DrawBatch();
+    for (int i = 0; i < 10000; i++) {
+      batch.addRect(Rect.fromLTWH(i.toDouble(), 0, 1, 1));
+    }
+    canvas.drawBatch(batch, paint);
+  } else {
+    for (int i = 0; i < 10000; i++) {
+      canvas.drawRect(Rect.fromLTWH(i.toDouble(), 0, 1, 1), paint);
+    }
+  }
+  recorder.endRecording().dispose();
+}
+
 @pragma('vm:entry-point')
 void frameCallback(FrameInfo info) {
   print('called back');
@@ -2413,6 +2413,33 @@ class Path extends NativeFieldWrapperClass2 {
   }
   void _addPolygon(Float32List points, bool close) native 'Path_addPolygon';
 
+  /// Adds a new sub-path for each of the given lists of points, as if
+  /// [addPolygon] was called with each of them in turn.
+  ///
+  /// This is faster than calling [addPolygon] many times, as the points of all
+  /// of the polygons are passed to the engine in one call.
+  void addPolygons(List<List<Offset>> polygons, bool close) {
+    assert(polygons != null); // ignore: unnecessary_null_comparison
+    int pointCount = 0;
+    for (final List<Offset> polygon in polygons) {
+      pointCount += polygon.length;
+    }
+    final Float32List points = Float32List(pointCount * 2);
+    final Int32List pointCounts = Int32List(polygons.length);
+    int index = 0;
+    for (int i = 0; i < polygons.length; ++i) {
+      final List<Offset> polygon = polygons[i];
+      pointCounts[i] = polygon.length;
+      for (final Offset point in polygon) {
+        assert(_offsetIsValid(point));
+        points[index++] = point.dx;
+        points[index++] = point.dy;
+      }
+    }
+    _addPolygons(points, pointCounts, close);
+  }
+  void _addPolygons(Float32List points, Int32List pointCounts, bool close) native 'Path_addPolygons';
+
   /// Adds a new sub-path that consists of the straight lines and
   /// curves needed to form the rounded rectangle described by the
   /// argument.
@@ -3807,6 +3834,104 @@ enum ClipOp {
   intersect,
 }
 
+/// A list of rectangles, ovals, circles and lines that can be drawn by a
+/// single call to [Canvas.drawBatch].
+///
+/// Drawing many simple shapes this way, e.g. the points of a chart, is much
+/// faster than calling [Canvas.drawRect] and the like for each of them, as the
+/// shapes are passed to the engine all at once.
+///
+/// Each shape is drawn with the [Paint] given to [Canvas.drawBatch], with its
+/// color replaced by the shape's `color` if there is one.
+///
+/// A batch can be drawn any number of times, and reused by calling [clear].
+class DrawBatch {
+  /// Creates an empty batch.
+  DrawBatch();
+
+  // The shapes, which must be kept in sync with canvas.cc.
+  static const int _kRect = 0;
+  static const int _kOval = 1;
+  static const int _kCircle = 2;
+  static const int _kLine = 3;
+  static const int _kHasColor = 0x80;
+
+  Uint8List _shapes = Uint8List(16);
+  Int32List _colors = Int32List(16);
+  Float32List _coordinates = Float32List(64);
+  int _shapeCount = 0;
+  int _coordinateCount = 0;
+
+  /// The number of shapes in the batch.
+  int get length => _shapeCount;
+
+  /// Adds a rectangle.
+  void addRect(Rect rect, { Color? color }) {
+    assert(_rectIsValid(rect));
+    _addShape(_kRect, color, 4);
+    _addCoordinates(rect.left, rect.top, rect.right, rect.bottom);
+  }
+
+  /// Adds an axis-aligned oval that fills the given axis-aligned rectangle.
+  void addOval(Rect rect, { Color? color }) {
+    assert(_rectIsValid(rect));
+    _addShape(_kOval, color, 4);
+    _addCoordinates(rect.left, rect.top, rect.right, rect.bottom);
+  }
+
+  /// Adds a circle centered at the point given by the first argument and that
+  /// has the radius given by the second argument.
+  void addCircle(Offset c, double radius, { Color? color }) {
+    assert(_offsetIsValid(c));
+    _addShape(_kCircle, color, 3);
+    _coordinates[_coordinateCount++] = c.dx;
+    _coordinates[_coordinateCount++] = c.dy;
+    _coordinates[_coordinateCount++] = radius;
+  }
+
+  /// Adds a line between the given points. The line is stroked, the value of
+  /// the [Paint.style] is ignored.
+  void addLine(Offset p1, Offset p2, { Color? color }) {
+    assert(_offsetIsValid(p1));
+    assert(_offsetIsValid(p2));
+    _addShape(_kLine, color, 4);
+    _addCoordinates(p1.dx, p1.dy, p2.dx, p2.dy);
+  }
+
+  /// Removes all of the shapes, keeping the storage of the batch.
+  void clear() {
+    _shapeCount = 0;
+    _coordinateCount = 0;
+  }
+
+  void _addShape(int shape, Color? color, int coordinateCount) {
+    if (_shapeCount == _shapes.length) {
+      _shapes = Uint8List(_shapes.length * 2)
+        ..setRange(0, _shapeCount, _shapes);
+      _colors = Int32List(_colors.length * 2)
+        ..setRange(0, _shapeCount, _colors);
+    }
+    if (_coordinateCount + coordinateCount > _coordinates.length) {
+      _coordinates = Float32List(_coordinates.length * 2)
+        ..setRange(0, _coordinateCount, _coordinates);
+    }
+    if (color != null) {
+      _shapes[_shapeCount] = shape | _kHasColor;
+      _colors[_shapeCount] = color.value;
+    } else {
+      _shapes[_shapeCount] = shape;
+    }
+    _shapeCount += 1;
+  }
+
+  void _addCoordinates(double a, double b, double c, double d) {
+    _coordinates[_coordinateCount++] = a;
+    _coordinates[_coordinateCount++] = b;
+    _coordinates[_coordinateCount++] = c;
+    _coordinates[_coordinateCount++] = d;
+  }
+}
+
 /// An interface for recording graphical operations.
 ///
 /// [Canvas] objects are used in creating [Picture] objects, which can
@@ -4423,6 +4548,31 @@ class Canvas extends NativeFieldWrapperClass2 {
                    int pointMode,
                    Float32List points) native 'Canvas_drawPoints';
 
+  /// Draws the shapes of the given [DrawBatch] with the given [Paint], in the
+  /// order in which they were added to the batch.
+  ///
+  /// This is equivalent to calling [drawRect], [drawOval], [drawCircle] or
+  /// [drawLine] for each of the shapes, but much faster for large batches.
+  void drawBatch(DrawBatch batch, Paint paint) {
+    assert(batch != null); // ignore: unnecessary_null_comparison
+    assert(paint != null); // ignore: unnecessary_null_comparison
+    if (batch._shapeCount == 0)
+      return;
+    _drawBatch(
+      paint._objects,
+      paint._data,
+      Uint8List.sublistView(batch._shapes, 0, batch._shapeCount),
+      Float32List.sublistView(batch._coordinates, 0, batch._coordinateCount),
+      Int32List.sublistView(batch._colors, 0, batch._shapeCount),
+    );
+  }
+
+  void _drawBatch(List<dynamic>? paintObjects,
+                  ByteData paintData,
+                  Uint8List shapes,
+                  Float32List coordinates,
+                  Int32List colors) native 'Canvas_drawBatch';
+
   /// Draws the set of [Vertices] onto the canvas.
   ///
   /// All parameters must not be null.
@@ -7,6 +7,7 @@
 #include <cmath>
 
 #include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/lib/ui/painting/draw_batch.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/painting/matrix.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -62,6 +63,7 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
   V(Canvas, drawPoints)             \
   V(Canvas, drawVertices)           \
   V(Canvas, drawAtlas)              \
+  V(Canvas, drawBatch)              \
   V(Canvas, drawShadow)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
@@ -457,6 +459,29 @@ void Canvas::drawAtlas(const Paint& paint,
       paint.paint());
 }
 
+void Canvas::drawBatch(const Paint& paint,
+                       const PaintData& paint_data,
+                       const tonic::Uint8List& shapes,
+                       const tonic::Float32List& coordinates,
+                       const tonic::Int32List& colors) {
+  if (!canvas_) {
+    return;
+  }
+
+  DrawBatchData batch = {
+      shapes.data(),
+      static_cast<size_t>(shapes.num_elements()),
+      coordinates.data(),
+      static_cast<size_t>(coordinates.num_elements()),
+      colors.data(),
+      static_cast<size_t>(colors.num_elements()),
+  };
+  if (!DrawBatchShapes(canvas_, *paint.paint(), batch)) {
+    Dart_ThrowException(
+        ToDart("Canvas.drawBatch called with an invalid batch."));
+  }
+}
+
 void Canvas::drawShadow(const CanvasPath* path,
                         SkColor color,
                         double elevation,
@@ -159,6 +159,15 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
                  SkBlendMode blend_mode,
                  const tonic::Float32List& cull_rect);
 
+  // Draws the rects, ovals, circles and lines encoded by a DrawBatch in Dart.
+  // Each shape in |shapes| takes its coordinates from |coordinates| in order,
+  // and the color at its own index in |colors| if it has one.
+  void drawBatch(const Paint& paint,
+                 const PaintData& paint_data,
+                 const tonic::Uint8List& shapes,
+                 const tonic::Float32List& coordinates,
+                 const tonic::Int32List& colors);
+
   void drawShadow(const CanvasPath* path,
                   SkColor color,
                   double elevation,
@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/draw_batch.h"
+
+namespace flutter {
+
+namespace {
+
+// Returns the number of coordinates of |shape|, or 0 if it isn't a shape.
+size_t GetShapeCoordinateCount(uint8_t shape) {
+  switch (shape) {
+    case kDrawBatchRect:
+    case kDrawBatchOval:
+    case kDrawBatchLine:
+      return 4;
+    case kDrawBatchCircle:
+      return 3;
+    default:
+      return 0;
+  }
+}
+
+bool IsValidBatch(const DrawBatchData& batch) {
+  size_t coordinate_count = 0;
+  for (size_t i = 0; i < batch.shape_count; i++) {
+    const uint8_t shape = batch.shapes[i] & ~kDrawBatchShapeHasColor;
+    const size_t shape_coordinate_count = GetShapeCoordinateCount(shape);
+    if (shape_coordinate_count == 0) {
+      return false;
+    }
+    if ((batch.shapes[i] & kDrawBatchShapeHasColor) && i >= batch.color_count) {
+      return false;
+    }
+    coordinate_count += shape_coordinate_count;
+  }
+  return coordinate_count == batch.coordinate_count;
+}
+
+}  // namespace
+
+bool DrawBatchShapes(SkCanvas* canvas,
+                     const SkPaint& paint,
+                     const DrawBatchData& batch) {
+  if (!IsValidBatch(batch)) {
+    return false;
+  }
+
+  // The colored paint is only updated when a shape's color differs from the
+  // previous one.
+  SkPaint colored_paint = paint;
+  const float* c = batch.coordinates;
+  for (size_t i = 0; i < batch.shape_count; i++) {
+    const SkPaint* shape_paint = &paint;
+    if (batch.shapes[i] & kDrawBatchShapeHasColor) {
+      const SkColor color = static_cast<SkColor>(batch.colors[i]);
+      if (colored_paint.getColor() != color) {
+        colored_paint.setColor(color);
+      }
+      shape_paint = &colored_paint;
+    }
+
+    const uint8_t shape = batch.shapes[i] & ~kDrawBatchShapeHasColor;
+    switch (shape) {
+      case kDrawBatchRect:
+        canvas->drawRect(SkRect::MakeLTRB(c[0], c[1], c[2], c[3]),
+                         *shape_paint);
+        break;
+      case kDrawBatchOval:
+        canvas->drawOval(SkRect::MakeLTRB(c[0], c[1], c[2], c[3]),
+                         *shape_paint);
+        break;
+      case kDrawBatchCircle:
+        canvas->drawCircle(c[0], c[1], c[2], *shape_paint);
+        break;
+      case kDrawBatchLine:
+        canvas->drawLine(c[0], c[1], c[2], c[3], *shape_paint);
+        break;
+    }
+    c += GetShapeCoordinateCount(shape);
+  }
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DRAW_BATCH_H_
+#define FLUTTER_LIB_UI_PAINTING_DRAW_BATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPaint.h"
+
+namespace flutter {
+
+// The shapes of a DrawBatch. Must be kept in sync with painting.dart.
+enum DrawBatchShape : uint8_t {
+  kDrawBatchRect = 0,
+  kDrawBatchOval = 1,
+  kDrawBatchCircle = 2,
+  kDrawBatchLine = 3,
+};
+
+// Set on shapes that are drawn with their own color.
+constexpr uint8_t kDrawBatchShapeHasColor = 0x80;
+
+// The shapes of a DrawBatch as encoded by painting.dart. Every shape takes a
+// fixed number of |coordinates|, and the shapes that have their own color
+// take it from |colors| at the index of the shape.
+struct DrawBatchData {
+  const uint8_t* shapes;
+  size_t shape_count;
+  const float* coordinates;
+  size_t coordinate_count;
+  const int32_t* colors;
+  size_t color_count;
+};
+
+// Draws the shapes of |batch| into |canvas| with |paint|. The whole batch is
+// checked first, so a malformed batch draws nothing and returns false.
+bool DrawBatchShapes(SkCanvas* canvas,
+                     const SkPaint& paint,
+                     const DrawBatchData& batch);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DRAW_BATCH_H_
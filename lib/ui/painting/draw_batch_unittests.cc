@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/draw_batch.h"
+
+#include <vector>
+
+#include "flutter/testing/mock_canvas.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+DrawBatchData MakeBatch(const std::vector<uint8_t>& shapes,
+                        const std::vector<float>& coordinates,
+                        const std::vector<int32_t>& colors) {
+  return {
+      shapes.data(),      shapes.size(), coordinates.data(),
+      coordinates.size(), colors.data(), colors.size(),
+  };
+}
+
+}  // namespace
+
+TEST(DrawBatchTest, DrawsEveryShape) {
+  const std::vector<uint8_t> shapes = {
+      kDrawBatchRect,
+      kDrawBatchOval,
+      kDrawBatchCircle | kDrawBatchShapeHasColor,
+      kDrawBatchLine,
+  };
+  const std::vector<float> coordinates = {
+      0, 0, 10, 10,    // Rect.
+      10, 10, 20, 30,  // Oval.
+      50, 50, 10,      // Circle.
+      0, 0, 100, 100,  // Line.
+  };
+  const std::vector<int32_t> colors = {0, 0, static_cast<int32_t>(0xFF00FF00),
+                                       0};
+
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+  EXPECT_TRUE(DrawBatchShapes(canvas, SkPaint(),
+                              MakeBatch(shapes, coordinates, colors)));
+  EXPECT_EQ(recorder.finishRecordingAsPicture()->approximateOpCount(), 4);
+}
+
+TEST(DrawBatchTest, ShapesWithColorsUseTheirOwnColor) {
+  const std::vector<uint8_t> shapes = {
+      kDrawBatchRect | kDrawBatchShapeHasColor,
+      kDrawBatchRect,
+  };
+  const std::vector<float> coordinates = {0, 0, 10, 10, 10, 10, 20, 20};
+  const std::vector<int32_t> colors = {static_cast<int32_t>(SK_ColorRED), 0};
+  SkPaint paint;
+  paint.setColor(SK_ColorBLUE);
+  SkPaint red_paint = paint;
+  red_paint.setColor(SK_ColorRED);
+
+  MockCanvas canvas;
+  EXPECT_TRUE(
+      DrawBatchShapes(&canvas, paint, MakeBatch(shapes, coordinates, colors)));
+  EXPECT_EQ(
+      canvas.draw_calls(),
+      std::vector({
+          MockCanvas::DrawCall{
+              0, MockCanvas::DrawRectData{SkRect::MakeLTRB(0, 0, 10, 10),
+                                          red_paint}},
+          MockCanvas::DrawCall{
+              0, MockCanvas::DrawRectData{SkRect::MakeLTRB(10, 10, 20, 20),
+                                          paint}},
+      }));
+}
+
+TEST(DrawBatchTest, TruncatedCoordinatesDrawNothing) {
+  const std::vector<uint8_t> shapes = {kDrawBatchRect, kDrawBatchRect};
+  const std::vector<float> coordinates = {0, 0, 10, 10, 10, 10, 20};
+  const std::vector<int32_t> colors = {0, 0};
+
+  MockCanvas canvas;
+  EXPECT_FALSE(DrawBatchShapes(&canvas, SkPaint(),
+                               MakeBatch(shapes, coordinates, colors)));
+  EXPECT_TRUE(canvas.draw_calls().empty());
+}
+
+TEST(DrawBatchTest, ExtraCoordinatesDrawNothing) {
+  const std::vector<uint8_t> shapes = {kDrawBatchRect};
+  const std::vector<float> coordinates = {0, 0, 10, 10, 10};
+  const std::vector<int32_t> colors = {0};
+
+  MockCanvas canvas;
+  EXPECT_FALSE(DrawBatchShapes(&canvas, SkPaint(),
+                               MakeBatch(shapes, coordinates, colors)));
+  EXPECT_TRUE(canvas.draw_calls().empty());
+}
+
+TEST(DrawBatchTest, UnknownShapesDrawNothing) {
+  const std::vector<uint8_t> shapes = {kDrawBatchRect, 4};
+  const std::vector<float> coordinates = {0, 0, 10, 10, 10, 10, 20, 20};
+  const std::vector<int32_t> colors = {0, 0};
+
+  MockCanvas canvas;
+  EXPECT_FALSE(DrawBatchShapes(&canvas, SkPaint(),
+                               MakeBatch(shapes, coordinates, colors)));
+  EXPECT_TRUE(canvas.draw_calls().empty());
+}
+
+TEST(DrawBatchTest, MissingColorsDrawNothing) {
+  const std::vector<uint8_t> shapes = {
+      kDrawBatchRect,
+      kDrawBatchRect | kDrawBatchShapeHasColor,
+  };
+  const std::vector<float> coordinates = {0, 0, 10, 10, 10, 10, 20, 20};
+  const std::vector<int32_t> colors = {0};
+
+  MockCanvas canvas;
+  EXPECT_FALSE(DrawBatchShapes(&canvas, SkPaint(),
+                               MakeBatch(shapes, coordinates, colors)));
+  EXPECT_TRUE(canvas.draw_calls().empty());
+}
+
+TEST(DrawBatchTest, EmptyBatchDrawsNothing) {
+  MockCanvas canvas;
+  EXPECT_TRUE(DrawBatchShapes(&canvas, SkPaint(), MakeBatch({}, {}, {})));
+  EXPECT_TRUE(canvas.draw_calls().empty());
+}
+
+}  // namespace testing
+}  // namespace flutter
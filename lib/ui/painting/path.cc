@@ -31,6 +31,7 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Path);
   V(Path, addOval)                   \
   V(Path, addPath)                   \
   V(Path, addPolygon)                \
+  V(Path, addPolygons)               \
   V(Path, addRect)                   \
   V(Path, addRRect)                  \
   V(Path, arcTo)                     \
@@ -240,6 +241,32 @@ void CanvasPath::addPolygon(const tonic::Float32List& points, bool close) {
   resetVolatility();
 }
 
+void CanvasPath::addPolygons(const tonic::Float32List& points,
+                             const tonic::Int32List& point_counts,
+                             bool close) {
+  const intptr_t point_count = points.num_elements() / 2;
+  intptr_t total_point_count = 0;
+  for (intptr_t i = 0; i < point_counts.num_elements(); i++) {
+    const int32_t count = point_counts[i];
+    if (count < 0 || count > point_count - total_point_count) {
+      Dart_ThrowException(
+          ToDart("Path.addPolygons called with invalid point counts."));
+      return;
+    }
+    total_point_count += count;
+  }
+
+  SkPath& path = mutable_path();
+  // Grow the point storage once for all of the polygons.
+  path.incReserve(total_point_count);
+  const SkPoint* polygon = reinterpret_cast<const SkPoint*>(points.data());
+  for (intptr_t i = 0; i < point_counts.num_elements(); i++) {
+    path.addPoly(polygon, point_counts[i], close);
+    polygon += point_counts[i];
+  }
+  resetVolatility();
+}
+
 void CanvasPath::addRRect(const RRect& rrect) {
   mutable_path().addRRect(rrect.sk_rrect);
   resetVolatility();
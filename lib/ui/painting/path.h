@@ -89,6 +89,9 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
               float startAngle,
               float sweepAngle);
   void addPolygon(const tonic::Float32List& points, bool close);
+  void addPolygons(const tonic::Float32List& points,
+                   const tonic::Int32List& point_counts,
+                   bool close);
   void addRRect(const RRect& rrect);
   void addPath(CanvasPath* path, double dx, double dy);
   void addPathWithMatrix(CanvasPath* path,
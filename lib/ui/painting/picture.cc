@@ -30,15 +30,18 @@ DART_BIND_ALL(Picture, FOR_EACH_BINDING)
 
 fml::RefPtr<Picture> Picture::Create(
     Dart_Handle dart_handle,
-    flutter::SkiaGPUObject<SkPicture> picture) {
-  auto canvas_picture = fml::MakeRefCounted<Picture>(std::move(picture));
+    flutter::SkiaGPUObject<SkPicture> picture,
+    PictureFingerprint fingerprint) {
+  auto canvas_picture =
+      fml::MakeRefCounted<Picture>(std::move(picture), fingerprint);
 
   canvas_picture->AssociateWithDartWrapper(dart_handle);
   return canvas_picture;
 }
 
-Picture::Picture(flutter::SkiaGPUObject<SkPicture> picture)
-    : picture_(std::move(picture)) {}
+Picture::Picture(flutter::SkiaGPUObject<SkPicture> picture,
+                 PictureFingerprint fingerprint)
+    : picture_(std::move(picture)), fingerprint_(fingerprint) {}
 
 Picture::~Picture() = default;
 
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 #define FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 
+#include "flutter/flow/picture_fingerprint.h"
 #include "flutter/flow/skia_gpu_object.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/image.h"
@@ -24,11 +25,16 @@ class Picture : public RefCountedDartWrappable<Picture> {
 
  public:
   ~Picture() override;
-  static fml::RefPtr<Picture> Create(Dart_Handle dart_handle,
-                                     flutter::SkiaGPUObject<SkPicture> picture);
+  static fml::RefPtr<Picture> Create(
+      Dart_Handle dart_handle,
+      flutter::SkiaGPUObject<SkPicture> picture,
+      PictureFingerprint fingerprint = kNoPictureFingerprint);
 
   sk_sp<SkPicture> picture() const { return picture_.get(); }
 
+  // Identifies the content of the picture for the raster cache.
+  PictureFingerprint fingerprint() const { return fingerprint_; }
+
   Dart_Handle toImage(uint32_t width,
                       uint32_t height,
                       Dart_Handle raw_image_callback);
@@ -45,9 +51,11 @@ class Picture : public RefCountedDartWrappable<Picture> {
                                       Dart_Handle raw_image_callback);
 
  private:
-  Picture(flutter::SkiaGPUObject<SkPicture> picture);
+  Picture(flutter::SkiaGPUObject<SkPicture> picture,
+          PictureFingerprint fingerprint);
 
   flutter::SkiaGPUObject<SkPicture> picture_;
+  PictureFingerprint fingerprint_;
 };
 
 }  // namespace flutter
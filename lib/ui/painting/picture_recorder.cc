@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/picture_recorder.h"
 
+#include "flutter/flow/picture_fingerprint.h"
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/picture.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -47,9 +48,17 @@ fml::RefPtr<Picture> PictureRecorder::endRecording(Dart_Handle dart_picture) {
     return nullptr;
   }
 
+  sk_sp<SkPicture> sk_picture = picture_recorder_.finishRecordingAsPicture();
+  // The fingerprint lets the raster cache reuse the entries of earlier
+  // recordings with identical content. Computing it serializes the picture,
+  // so it is only done when enabled.
+  const PictureFingerprint fingerprint =
+      sk_picture && UIDartState::Current()->enable_picture_fingerprints()
+          ? ComputePictureFingerprint(*sk_picture)
+          : kNoPictureFingerprint;
   fml::RefPtr<Picture> picture = Picture::Create(
-      dart_picture, UIDartState::CreateGPUObject(
-                        picture_recorder_.finishRecordingAsPicture()));
+      dart_picture, UIDartState::CreateGPUObject(std::move(sk_picture)),
+      fingerprint);
 
   canvas_->Invalidate();
   canvas_ = nullptr;
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/vertices.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -15,15 +16,19 @@ namespace flutter {
 namespace {
 
 void DecodePoints(const tonic::Float32List& coords, SkPoint* points) {
-  for (int i = 0; i < coords.num_elements(); i += 2) {
-    points[i / 2] = SkPoint::Make(coords[i], coords[i + 1]);
-  }
+  static_assert(sizeof(SkPoint) == sizeof(float) * 2,
+                "SkPoint doesn't use floats.");
+  // The coordinates are laid out like an array of points.
+  std::memcpy(points, coords.data(),
+              coords.num_elements() / 2 * sizeof(SkPoint));
 }
 
 template <typename T>
 void DecodeInts(const tonic::Int32List& ints, T* out) {
-  for (int i = 0; i < ints.num_elements(); i++) {
-    out[i] = ints[i];
+  if constexpr (sizeof(T) == sizeof(int32_t)) {
+    std::memcpy(out, ints.data(), ints.num_elements() * sizeof(int32_t));
+  } else {
+    std::copy(ints.begin(), ints.end(), out);
   }
 }
 
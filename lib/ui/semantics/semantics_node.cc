@@ -4,7 +4,11 @@
 
 #include "flutter/lib/ui/semantics/semantics_node.h"
 
+#include <cmath>
 #include <cstring>
+#include <string_view>
+
+#include "flutter/fml/hash_combine.h"
 
 namespace flutter {
 
@@ -14,8 +18,74 @@ SemanticsNode::SemanticsNode() = default;
 
 SemanticsNode::SemanticsNode(const SemanticsNode& other) = default;
 
+SemanticsNode::SemanticsNode(SemanticsNode&& other) = default;
+
 SemanticsNode::~SemanticsNode() = default;
 
+SemanticsNode& SemanticsNode::operator=(const SemanticsNode& other) = default;
+
+SemanticsNode& SemanticsNode::operator=(SemanticsNode&& other) = default;
+
+static void HashCombineList(std::size_t& seed,
+                            const std::vector<int32_t>& list) {
+  fml::HashCombineSeed(seed, list.size());
+  for (int32_t item : list) {
+    fml::HashCombineSeed(seed, item);
+  }
+}
+
+std::size_t SemanticsNode::Hash() const {
+  std::size_t seed = fml::HashCombine();
+  fml::HashCombineSeed(seed, id, flags, actions, maxValueLength,
+                       currentValueLength, textSelectionBase,
+                       textSelectionExtent, platformViewId, scrollChildren,
+                       scrollIndex, scrollPosition, scrollExtentMax,
+                       scrollExtentMin, elevation, thickness, textDirection);
+  for (const std::string* string :
+       {&label, &hint, &value, &increasedValue, &decreasedValue}) {
+    fml::HashCombineSeed(seed, std::string_view(*string));
+  }
+  fml::HashCombineSeed(seed, rect.fLeft, rect.fTop, rect.fRight,
+                       rect.fBottom);
+  float matrix[16];
+  transform.getColMajor(matrix);
+  for (float element : matrix) {
+    fml::HashCombineSeed(seed, element);
+  }
+  HashCombineList(seed, childrenInTraversalOrder);
+  HashCombineList(seed, childrenInHitTestOrder);
+  HashCombineList(seed, customAccessibilityActions);
+  return seed;
+}
+
+static bool SameDouble(double a, double b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+bool SemanticsNode::Equals(const SemanticsNode& other) const {
+  return id == other.id && flags == other.flags && actions == other.actions &&
+         maxValueLength == other.maxValueLength &&
+         currentValueLength == other.currentValueLength &&
+         textSelectionBase == other.textSelectionBase &&
+         textSelectionExtent == other.textSelectionExtent &&
+         platformViewId == other.platformViewId &&
+         scrollChildren == other.scrollChildren &&
+         scrollIndex == other.scrollIndex &&
+         SameDouble(scrollPosition, other.scrollPosition) &&
+         SameDouble(scrollExtentMax, other.scrollExtentMax) &&
+         SameDouble(scrollExtentMin, other.scrollExtentMin) &&
+         SameDouble(elevation, other.elevation) &&
+         SameDouble(thickness, other.thickness) && label == other.label &&
+         hint == other.hint && value == other.value &&
+         increasedValue == other.increasedValue &&
+         decreasedValue == other.decreasedValue &&
+         textDirection == other.textDirection && rect == other.rect &&
+         transform == other.transform &&
+         childrenInTraversalOrder == other.childrenInTraversalOrder &&
+         childrenInHitTestOrder == other.childrenInHitTestOrder &&
+         customAccessibilityActions == other.customAccessibilityActions;
+}
+
 bool SemanticsNode::HasAction(SemanticsAction action) const {
   return (actions & static_cast<int32_t>(action)) != 0;
 }
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_NODE_H_
 #define FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_NODE_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <unordered_map>
@@ -89,8 +90,22 @@ struct SemanticsNode {
 
   SemanticsNode(const SemanticsNode& other);
 
+  SemanticsNode(SemanticsNode&& other);
+
   ~SemanticsNode();
 
+  SemanticsNode& operator=(const SemanticsNode& other);
+
+  SemanticsNode& operator=(SemanticsNode&& other);
+
+  // A hash of all the fields of the node. Nodes with the same hash are the
+  // same with all but negligible probability.
+  std::size_t Hash() const;
+
+  // Whether all the fields of the nodes are the same. Unlike with operator==
+  // on doubles, a NaN is the same as another NaN.
+  bool Equals(const SemanticsNode& other) const;
+
   bool HasAction(SemanticsAction action) const;
   bool HasFlag(SemanticsFlags flag) const;
 
@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/semantics_update_filter.h"
+
+namespace flutter {
+
+SemanticsUpdateFilter::SemanticsUpdateFilter() = default;
+
+SemanticsUpdateFilter::~SemanticsUpdateFilter() = default;
+
+void SemanticsUpdateFilter::Filter(SemanticsNodeUpdates& update) {
+  // The previous children of the changed nodes, some of which may have been
+  // removed from the tree, and the current children of the changed nodes.
+  std::unordered_set<int32_t> detached;
+  std::unordered_set<int32_t> attached;
+
+  for (auto it = update.begin(); it != update.end();) {
+    const SemanticsNode& node = it->second;
+    const std::size_t hash = node.Hash();
+    auto found = nodes_.find(node.id);
+    if (found != nodes_.end()) {
+      if (found->second.hash == hash && found->second.node.Equals(node)) {
+        it = update.erase(it);
+        continue;
+      }
+      const std::vector<int32_t>& children =
+          found->second.node.childrenInTraversalOrder;
+      detached.insert(children.begin(), children.end());
+    }
+    attached.insert(node.childrenInTraversalOrder.begin(),
+                    node.childrenInTraversalOrder.end());
+    nodes_[node.id] = {hash, node};
+    ++it;
+  }
+
+  // A node that moved to another parent is a child of that parent, which
+  // changed too.
+  for (int32_t id : detached) {
+    if (attached.count(id) == 0) {
+      RemoveSubtree(id, attached);
+    }
+  }
+}
+
+void SemanticsUpdateFilter::Reset() {
+  nodes_.clear();
+}
+
+size_t SemanticsUpdateFilter::GetNodeCount() const {
+  return nodes_.size();
+}
+
+void SemanticsUpdateFilter::RemoveSubtree(
+    int32_t id,
+    const std::unordered_set<int32_t>& kept) {
+  std::vector<int32_t> stack = {id};
+  while (!stack.empty()) {
+    auto found = nodes_.find(stack.back());
+    stack.pop_back();
+    if (found == nodes_.end()) {
+      continue;
+    }
+    for (int32_t child : found->second.node.childrenInTraversalOrder) {
+      if (kept.count(child) == 0) {
+        stack.push_back(child);
+      }
+    }
+    nodes_.erase(found);
+  }
+}
+
+}  // namespace flutter
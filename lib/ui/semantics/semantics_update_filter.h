@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_UPDATE_FILTER_H_
+#define FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_UPDATE_FILTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/semantics/semantics_node.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Remembers the semantics nodes that have been sent to the platform, and
+/// drops the nodes from later updates that are the same as when they were last
+/// sent. The framework sends every node of a dirty semantics subtree, so most
+/// nodes of an update usually haven't changed.
+///
+/// A copy of each sent node is kept along with its hash. Nodes are compared
+/// field by field when their hashes match, so that a hash collision can't
+/// drop a change. Nodes that are removed from the tree, because their parents
+/// no longer list them as children, are forgotten so that they are sent again
+/// if they come back.
+///
+class SemanticsUpdateFilter {
+ public:
+  SemanticsUpdateFilter();
+
+  ~SemanticsUpdateFilter();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the nodes of |update| that haven't changed since they
+  ///             were last sent and remembers the others, which the caller
+  ///             must send to the platform.
+  ///
+  void Filter(SemanticsNodeUpdates& update);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets all nodes, so that the next update is sent in full.
+  ///             Must be called whenever the platform drops its semantics
+  ///             tree, e.g. when semantics are disabled.
+  ///
+  void Reset();
+
+  size_t GetNodeCount() const;
+
+ private:
+  struct Entry {
+    std::size_t hash;
+    SemanticsNode node;
+  };
+
+  std::unordered_map<int32_t, Entry> nodes_;
+
+  // Forgets the node |id| and its descendants, except for those in |kept|.
+  void RemoveSubtree(int32_t id, const std::unordered_set<int32_t>& kept);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SemanticsUpdateFilter);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_UPDATE_FILTER_H_
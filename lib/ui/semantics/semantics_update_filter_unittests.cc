@@ -0,0 +1,147 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/semantics_update_filter.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+SemanticsNode MakeNode(int32_t id,
+                       std::string label,
+                       std::vector<int32_t> children = {}) {
+  SemanticsNode node;
+  node.id = id;
+  node.label = std::move(label);
+  node.childrenInTraversalOrder = children;
+  node.childrenInHitTestOrder = std::move(children);
+  return node;
+}
+
+void AddNode(SemanticsNodeUpdates& update, SemanticsNode node) {
+  int32_t id = node.id;
+  update[id] = std::move(node);
+}
+
+// A root with the children 1 and 2, where 2 has the child 3.
+SemanticsNodeUpdates MakeTree() {
+  SemanticsNodeUpdates update;
+  AddNode(update, MakeNode(0, "root", {1, 2}));
+  AddNode(update, MakeNode(1, "one"));
+  AddNode(update, MakeNode(2, "two", {3}));
+  AddNode(update, MakeNode(3, "three"));
+  return update;
+}
+
+}  // namespace
+
+TEST(SemanticsNodeTest, HashCoversFields) {
+  SemanticsNode node = MakeNode(1, "label", {2, 3});
+  SemanticsNode copy = node;
+  EXPECT_EQ(node.Hash(), copy.Hash());
+
+  copy.label = "labe";
+  copy.hint = "l";
+  EXPECT_NE(node.Hash(), copy.Hash());
+
+  copy = node;
+  copy.childrenInTraversalOrder = {3, 2};
+  EXPECT_NE(node.Hash(), copy.Hash());
+
+  copy = node;
+  copy.transform.setRC(0, 3, 10);
+  EXPECT_NE(node.Hash(), copy.Hash());
+}
+
+TEST(SemanticsNodeTest, EqualsComparesFields) {
+  SemanticsNode node = MakeNode(1, "label", {2, 3});
+  SemanticsNode copy = node;
+  // The scroll fields default to NaN.
+  EXPECT_TRUE(node.Equals(copy));
+
+  copy.scrollPosition = 1.0;
+  EXPECT_FALSE(node.Equals(copy));
+
+  copy = node;
+  copy.hint = "hint";
+  EXPECT_FALSE(node.Equals(copy));
+
+  copy = node;
+  copy.customAccessibilityActions = {4};
+  EXPECT_FALSE(node.Equals(copy));
+}
+
+TEST(SemanticsUpdateFilterTest, DropsUnchangedNodes) {
+  SemanticsUpdateFilter filter;
+  SemanticsNodeUpdates update = MakeTree();
+  filter.Filter(update);
+  EXPECT_EQ(update.size(), 4u);
+  EXPECT_EQ(filter.GetNodeCount(), 4u);
+
+  update = MakeTree();
+  filter.Filter(update);
+  EXPECT_TRUE(update.empty());
+
+  update = MakeTree();
+  update[3].label = "changed";
+  filter.Filter(update);
+  ASSERT_EQ(update.size(), 1u);
+  EXPECT_EQ(update.begin()->first, 3);
+}
+
+TEST(SemanticsUpdateFilterTest, SendsRemovedNodesAgainWhenTheyComeBack) {
+  SemanticsUpdateFilter filter;
+  SemanticsNodeUpdates update = MakeTree();
+  filter.Filter(update);
+
+  // Removing 2 also removes its child 3.
+  update.clear();
+  AddNode(update, MakeNode(0, "root", {1}));
+  filter.Filter(update);
+  EXPECT_EQ(update.size(), 1u);
+  EXPECT_EQ(filter.GetNodeCount(), 2u);
+
+  update = MakeTree();
+  filter.Filter(update);
+  EXPECT_EQ(update.size(), 3u);
+  EXPECT_EQ(update.count(1), 0u);
+  EXPECT_EQ(filter.GetNodeCount(), 4u);
+}
+
+TEST(SemanticsUpdateFilterTest, KeepsReparentedNodes) {
+  SemanticsUpdateFilter filter;
+  SemanticsNodeUpdates update = MakeTree();
+  filter.Filter(update);
+
+  // Move 3 from 2 to 1.
+  update.clear();
+  AddNode(update, MakeNode(1, "one", {3}));
+  AddNode(update, MakeNode(2, "two"));
+  AddNode(update, MakeNode(3, "three"));
+  filter.Filter(update);
+  EXPECT_EQ(update.size(), 2u);
+  EXPECT_EQ(update.count(3), 0u);
+  EXPECT_EQ(filter.GetNodeCount(), 4u);
+}
+
+TEST(SemanticsUpdateFilterTest, ResetSendsEverythingAgain) {
+  SemanticsUpdateFilter filter;
+  SemanticsNodeUpdates update = MakeTree();
+  filter.Filter(update);
+
+  filter.Reset();
+  EXPECT_EQ(filter.GetNodeCount(), 0u);
+  update = MakeTree();
+  filter.Filter(update);
+  EXPECT_EQ(update.size(), 4u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -1926,6 +1926,17 @@ class Paragraph extends NativeFieldWrapperClass2 {
   void layout(ParagraphConstraints constraints) => _layout(constraints.width);
   void _layout(double width) native 'Paragraph_layout';
 
+  /// Replaces the styles of this laid out paragraph with those of `styled`
+  /// while keeping its layout, and returns whether that succeeded.
+  ///
+  /// This is much cheaper than laying out `styled`, e.g. to animate the color
+  /// of some text. It only succeeds if both paragraphs have the same text,
+  /// placeholders and [ParagraphStyle], and their [TextStyle]s only differ in
+  /// colors, foregrounds, backgrounds, decorations and shadows. Otherwise this
+  /// paragraph is left unchanged and `styled` has to be laid out instead.
+  /// Some implementations never succeed.
+  bool updatePaintStyles(Paragraph styled) native 'Paragraph_updatePaintStyles';
+
   List<TextBox> _decodeTextBoxes(Float32List encoded) {
     final int count = encoded.length ~/ 5;
     final List<TextBox> boxes = <TextBox>[];
@@ -29,6 +29,7 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
   V(Paragraph, ideographicBaseline)     \
   V(Paragraph, didExceedMaxLines)       \
   V(Paragraph, layout)                  \
+  V(Paragraph, updatePaintStyles)       \
   V(Paragraph, paint)                   \
   V(Paragraph, getWordBoundary)         \
   V(Paragraph, getLineBoundary)         \
@@ -87,6 +88,13 @@ void Paragraph::layout(double width) {
   m_paragraph->Layout(width);
 }
 
+bool Paragraph::updatePaintStyles(Paragraph* styled) {
+  if (!styled) {
+    return false;
+  }
+  return m_paragraph->UpdatePaintStyles(*styled->m_paragraph);
+}
+
 void Paragraph::paint(Canvas* canvas, double x, double y) {
   SkCanvas* sk_canvas = canvas->canvas();
   if (!sk_canvas) {
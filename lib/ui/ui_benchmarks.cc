@@ -4,14 +4,56 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/common/settings.h"
+#include "flutter/lib/ui/semantics/semantics_update_filter.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/tonic/converter/dart_converter.h"
+#include "third_party/tonic/logging/dart_error.h"
+#include "third_party/tonic/typed_data/typed_list.h"
 
+#include <atomic>
+#include <cstdlib>
 #include <future>
+#include <new>
+#include <numeric>
+
+namespace {
+
+// Allocations are only counted on threads that are inside of a
+// |ScopedAllocationCounting|.
+thread_local bool count_allocations = false;
+std::atomic<size_t> allocation_count = 0;
+
+class ScopedAllocationCounting {
+ public:
+  ScopedAllocationCounting() { count_allocations = true; }
+  ~ScopedAllocationCounting() { count_allocations = false; }
+};
+
+}  // namespace
+
+void* operator new(size_t size) {
+  if (count_allocations) {
+    allocation_count++;
+  }
+  if (void* allocation = std::malloc(size == 0 ? 1 : size)) {
+    return allocation;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* allocation) noexcept {
+  std::free(allocation);
+}
+
+void operator delete(void* allocation, size_t size) noexcept {
+  std::free(allocation);
+}
 
 namespace flutter {
 
@@ -67,6 +109,113 @@ static void BM_PlatformMessageResponseDartComplete(benchmark::State& state) {
   }
 }
 
+// Records 10000 rects into a picture from Dart, with a native call for each
+// rect or, when the argument is true, with a single DrawBatch.
+static void BM_CanvasDrawBatch(benchmark::State& state) {
+  ThreadHost thread_host("test",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetFixturesPath(), {});
+
+  const bool batched = state.range(0);
+  while (state.KeepRunning()) {
+    bool successful = isolate->RunInIsolateScope([&]() -> bool {
+      Dart_Handle args[] = {Dart_NewBoolean(batched)};
+      return !tonic::LogIfError(Dart_Invoke(
+          Dart_RootLibrary(), tonic::ToDart("recordRects"), 1, args));
+    });
+    FML_CHECK(successful);
+  }
+  state.SetItemsProcessed(state.iterations() * 10000);
+}
+
+// Converts a Dart list of ints to a std::vector<int32_t>. The first argument is
+// the length of the list, the second whether it is an Int32List rather than a
+// List<int>.
+static void BM_DartConverterVectorFromDart(benchmark::State& state) {
+  ThreadHost thread_host("test",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetFixturesPath(), {});
+
+  const int64_t length = state.range(0);
+  const bool typed = state.range(1);
+  bool successful = isolate->RunInIsolateScope([&]() -> bool {
+    std::vector<int32_t> values(length);
+    std::iota(values.begin(), values.end(), 0);
+    Dart_Handle list;
+    if (typed) {
+      list = Dart_NewTypedData(Dart_TypedData_kInt32, length);
+      tonic::Int32List typed_list(list);
+      std::copy(values.begin(), values.end(), &typed_list[0]);
+    } else {
+      list = tonic::DartConverter<std::vector<int32_t>>::ToDart(values);
+    }
+
+    while (state.KeepRunning()) {
+      benchmark::DoNotOptimize(
+          tonic::DartConverter<std::vector<int32_t>>::FromDart(list));
+    }
+    return true;
+  });
+  FML_CHECK(successful);
+  state.SetItemsProcessed(state.iterations() * length);
+}
+
+// Borrows the elements of a Float32List, as the arguments of drawPoints and
+// drawAtlas are, and reads them as points.
+static void BM_Float32ListAsPoints(benchmark::State& state) {
+  ThreadHost thread_host("test",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetFixturesPath(), {});
+
+  const int64_t point_count = state.range(0);
+  bool successful = isolate->RunInIsolateScope([&]() -> bool {
+    Dart_Handle list = Dart_NewTypedData(Dart_TypedData_kFloat32,
+                                         point_count * 2);
+    while (state.KeepRunning()) {
+      tonic::Float32List points(list);
+      SkRect bounds;
+      bounds.setBounds(reinterpret_cast<const SkPoint*>(points.data()),
+                       points.num_elements() / 2);
+      benchmark::DoNotOptimize(bounds);
+    }
+    return true;
+  });
+  FML_CHECK(successful);
+  state.SetItemsProcessed(state.iterations() * point_count);
+}
+
+// Reports the number of allocations made by the tracker for each frame in which
+// 1000 paths are created and most of them are collected.
 static void BM_PathVolatilityTracker(benchmark::State& state) {
   ThreadHost thread_host("test",
                          ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
@@ -78,6 +227,7 @@ static void BM_PathVolatilityTracker(benchmark::State& state) {
 
   VolatilePathTracker tracker(task_runners.GetUITaskRunner(), true);
 
+  const size_t start_allocation_count = allocation_count;
   while (state.KeepRunning()) {
     std::vector<std::shared_ptr<VolatilePathTracker::TrackedPath>> paths;
     constexpr int path_count = 1000;
@@ -90,6 +240,7 @@ static void BM_PathVolatilityTracker(benchmark::State& state) {
 
     fml::AutoResetWaitableEvent latch;
     task_runners.GetUITaskRunner()->PostTask([&]() {
+      ScopedAllocationCounting counting;
       for (auto path : paths) {
         tracker.Insert(path);
       }
@@ -98,23 +249,107 @@ static void BM_PathVolatilityTracker(benchmark::State& state) {
 
     latch.Wait();
 
-    task_runners.GetUITaskRunner()->PostTask([&]() { tracker.OnFrame(); });
+    task_runners.GetUITaskRunner()->PostTask([&]() {
+      ScopedAllocationCounting counting;
+      tracker.OnFrame();
+    });
 
-    for (int i = 0; i < path_count - 10; ++i) {
-      tracker.Erase(paths[i]);
+    {
+      ScopedAllocationCounting counting;
+      for (int i = 0; i < path_count - 10; ++i) {
+        tracker.Erase(paths[i]);
+      }
     }
 
-    task_runners.GetUITaskRunner()->PostTask([&]() { tracker.OnFrame(); });
+    task_runners.GetUITaskRunner()->PostTask([&]() {
+      ScopedAllocationCounting counting;
+      tracker.OnFrame();
+    });
 
     latch.Reset();
     task_runners.GetUITaskRunner()->PostTask([&]() { latch.Signal(); });
     latch.Wait();
   }
+
+  // Each iteration runs two frames.
+  state.counters["AllocationsPerFrame"] =
+      static_cast<double>(allocation_count - start_allocation_count) /
+      (state.iterations() * 2);
+}
+
+// Sends a semantics tree of 10000 nodes in which only a few labels change
+// between updates, like a list with a ticking clock. The second argument
+// enables the filter. Copying the update stands in for posting it to the
+// platform thread.
+static void BM_SemanticsUpdateFilter(benchmark::State& state) {
+  constexpr int32_t node_count = 10000;
+  constexpr int32_t changed_node_count = 10;
+  SemanticsNodeUpdates tree;
+  for (int32_t id = 0; id < node_count; id++) {
+    SemanticsNode& node = tree[id];
+    node.id = id;
+    node.label = "Item " + std::to_string(id);
+    node.rect = SkRect::MakeXYWH(0, id * 48, 400, 48);
+    if (id == 0) {
+      for (int32_t child = 1; child < node_count; child++) {
+        node.childrenInTraversalOrder.push_back(child);
+      }
+      node.childrenInHitTestOrder = node.childrenInTraversalOrder;
+    }
+  }
+
+  const bool enable_filter = state.range(0);
+  SemanticsUpdateFilter filter;
+  size_t forwarded_nodes = 0;
+  int64_t tick = 0;
+  while (state.KeepRunning()) {
+    SemanticsNodeUpdates update;
+    {
+      ::benchmarking::ScopedPauseTiming pause(state);
+      update = tree;
+      for (int32_t i = 1; i <= changed_node_count; i++) {
+        update[i].value = std::to_string(tick);
+      }
+      tick++;
+    }
+    if (enable_filter) {
+      filter.Filter(update);
+    }
+    SemanticsNodeUpdates forwarded = update;
+    forwarded_nodes += forwarded.size();
+  }
+  state.counters["ForwardedNodes"] = benchmark::Counter(
+      forwarded_nodes, benchmark::Counter::kAvgIterations);
 }
 
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK(BM_CanvasDrawBatch)
+    ->Arg(false)
+    ->Arg(true)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_DartConverterVectorFromDart)
+    ->Args({16, false})
+    ->Args({16, true})
+    ->Args({1024, false})
+    ->Args({1024, true})
+    ->Args({65536, false})
+    ->Args({65536, true})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Float32ListAsPoints)
+    ->Arg(16)
+    ->Arg(1024)
+    ->Arg(65536)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK(BM_PathVolatilityTracker)->Unit(benchmark::kMillisecond);
 
+BENCHMARK(BM_SemanticsUpdateFilter)
+    ->Arg(false)
+    ->Arg(true)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
@@ -29,7 +29,9 @@ UIDartState::UIDartState(
     std::shared_ptr<IsolateNameServer> isolate_name_server,
     bool is_root_isolate,
     std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
-    bool enable_skparagraph)
+    bool enable_skparagraph,
+    bool enable_compiled_layer_trees,
+    bool enable_picture_fingerprints)
     : task_runners_(std::move(task_runners)),
       add_callback_(std::move(add_callback)),
       remove_callback_(std::move(remove_callback)),
@@ -45,7 +47,9 @@ UIDartState::UIDartState(
       is_root_isolate_(is_root_isolate),
       unhandled_exception_callback_(unhandled_exception_callback),
       isolate_name_server_(std::move(isolate_name_server)),
-      enable_skparagraph_(enable_skparagraph) {
+      enable_skparagraph_(enable_skparagraph),
+      enable_compiled_layer_trees_(enable_compiled_layer_trees),
+      enable_picture_fingerprints_(enable_picture_fingerprints) {
   AddOrRemoveTaskObserver(true /* add */);
 }
 
@@ -191,4 +195,12 @@ bool UIDartState::enable_skparagraph() const {
   return enable_skparagraph_;
 }
 
+bool UIDartState::enable_compiled_layer_trees() const {
+  return enable_compiled_layer_trees_;
+}
+
+bool UIDartState::enable_picture_fingerprints() const {
+  return enable_picture_fingerprints_;
+}
+
 }  // namespace flutter
@@ -79,6 +79,10 @@ class UIDartState : public tonic::DartState {
 
   bool enable_skparagraph() const;
 
+  bool enable_compiled_layer_trees() const;
+
+  bool enable_picture_fingerprints() const;
+
   template <class T>
   static flutter::SkiaGPUObject<T> CreateGPUObject(sk_sp<T> object) {
     if (!object) {
@@ -106,7 +110,9 @@ class UIDartState : public tonic::DartState {
               std::shared_ptr<IsolateNameServer> isolate_name_server,
               bool is_root_isolate_,
               std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
-              bool enable_skparagraph);
+              bool enable_skparagraph,
+              bool enable_compiled_layer_trees,
+              bool enable_picture_fingerprints);
 
   ~UIDartState() override;
 
@@ -140,6 +146,8 @@ class UIDartState : public tonic::DartState {
   UnhandledExceptionCallback unhandled_exception_callback_;
   const std::shared_ptr<IsolateNameServer> isolate_name_server_;
   const bool enable_skparagraph_;
+  const bool enable_compiled_layer_trees_;
+  const bool enable_picture_fingerprints_;
 
   void AddOrRemoveTaskObserver(bool add);
 };
@@ -11,6 +11,16 @@ VolatilePathTracker::VolatilePathTracker(
     bool enabled)
     : ui_task_runner_(ui_task_runner), enabled_(enabled) {}
 
+VolatilePathTracker::~VolatilePathTracker() {
+  // Release the list iteratively, as releasing the head would otherwise
+  // recurse through every path.
+  while (head_) {
+    std::shared_ptr<TrackedPath> next = std::move(head_->next);
+    head_->linked = false;
+    head_ = std::move(next);
+  }
+}
+
 void VolatilePathTracker::Insert(std::shared_ptr<TrackedPath> path) {
   FML_DCHECK(ui_task_runner_->RunsTasksOnCurrentThread());
   FML_DCHECK(path);
@@ -19,7 +29,15 @@ void VolatilePathTracker::Insert(std::shared_ptr<TrackedPath> path) {
     path->path.setIsVolatile(false);
     return;
   }
-  paths_.insert(path);
+  FML_DCHECK(!path->linked);
+  path->next = std::move(head_);
+  if (path->next) {
+    path->next->prev = path.get();
+  }
+  path->prev = nullptr;
+  path->linked = true;
+  head_ = std::move(path);
+  count_++;
 }
 
 void VolatilePathTracker::Erase(std::shared_ptr<TrackedPath> path) {
@@ -28,7 +46,9 @@ void VolatilePathTracker::Erase(std::shared_ptr<TrackedPath> path) {
   }
   FML_DCHECK(path);
   if (ui_task_runner_->RunsTasksOnCurrentThread()) {
-    paths_.erase(path);
+    if (path->linked) {
+      Unlink(path.get());
+    }
     return;
   }
 
@@ -42,24 +62,26 @@ void VolatilePathTracker::OnFrame() {
   if (!enabled_) {
     return;
   }
-  std::string total_count = std::to_string(paths_.size());
+  std::string total_count = std::to_string(count_);
   TRACE_EVENT1("flutter", "VolatilePathTracker::OnFrame", "total_count",
                total_count.c_str());
 
   Drain();
 
-  std::set<std::shared_ptr<TrackedPath>> surviving_paths_;
-  for (const std::shared_ptr<TrackedPath>& path : paths_) {
+  TrackedPath* path = head_.get();
+  while (path) {
+    // The next path is owned by this one until it is unlinked, after which it
+    // is owned by the previous path.
+    TrackedPath* next = path->next.get();
     path->frame_count++;
     if (path->frame_count >= kFramesOfVolatility) {
       path->path.setIsVolatile(false);
       path->tracking_volatility = false;
-    } else {
-      surviving_paths_.insert(path);
+      Unlink(path);
     }
+    path = next;
   }
-  paths_.swap(surviving_paths_);
-  std::string post_removal_count = std::to_string(paths_.size());
+  std::string post_removal_count = std::to_string(count_);
   TRACE_EVENT_INSTANT1("flutter", "VolatilePathTracker::OnFrame",
                        "remaining_count", post_removal_count.c_str());
 }
@@ -77,9 +99,26 @@ void VolatilePathTracker::Drain() {
     TRACE_EVENT_INSTANT1("flutter", "VolatilePathTracker::Drain", "count",
                          count.c_str());
     for (auto& path : paths_to_remove) {
-      paths_.erase(path);
+      // The path may have stopped being tracked since it was erased.
+      if (path->linked) {
+        Unlink(path.get());
+      }
     }
   }
 }
 
+void VolatilePathTracker::Unlink(TrackedPath* path) {
+  FML_DCHECK(path->linked);
+  std::shared_ptr<TrackedPath>& owner = path->prev ? path->prev->next : head_;
+  // Keeps the path alive until its links have been updated.
+  std::shared_ptr<TrackedPath> self = std::move(owner);
+  owner = std::move(path->next);
+  if (owner) {
+    owner->prev = path->prev;
+  }
+  path->prev = nullptr;
+  path->linked = false;
+  count_--;
+}
+
 }  // namespace flutter
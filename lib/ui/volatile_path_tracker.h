@@ -6,8 +6,8 @@
 #define FLUTTER_LIB_VOLATILE_PATH_TRACKER_H_
 
 #include <deque>
+#include <memory>
 #include <mutex>
-#include <set>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
@@ -35,11 +35,22 @@ class VolatilePathTracker {
     bool tracking_volatility = false;
     int frame_count = 0;
     SkPath path;
+
+   private:
+    friend class VolatilePathTracker;
+
+    // Links of the tracker's list of paths, which owns the paths through the
+    // |next| links so that tracking a path never allocates.
+    std::shared_ptr<TrackedPath> next;
+    TrackedPath* prev = nullptr;
+    bool linked = false;
   };
 
   VolatilePathTracker(fml::RefPtr<fml::TaskRunner> ui_task_runner,
                       bool enabled);
 
+  ~VolatilePathTracker();
+
   static constexpr int kFramesOfVolatility = 2;
 
   // Starts tracking a path.
@@ -64,16 +75,24 @@ class VolatilePathTracker {
 
   bool enabled() const { return enabled_; }
 
+  // The number of paths currently tracked.
+  //
+  // Must be called from the UI task runner.
+  size_t GetTrackedPathCount() const { return count_; }
+
  private:
   fml::RefPtr<fml::TaskRunner> ui_task_runner_;
   std::atomic_bool needs_drain_ = false;
   std::mutex paths_to_remove_mutex_;
   std::deque<std::shared_ptr<TrackedPath>> paths_to_remove_;
-  std::set<std::shared_ptr<TrackedPath>> paths_;
+  std::shared_ptr<TrackedPath> head_;
+  size_t count_ = 0;
   bool enabled_ = true;
 
   void Drain();
 
+  void Unlink(TrackedPath* path);
+
   FML_DISALLOW_COPY_AND_ASSIGN(VolatilePathTracker);
 };
 
@@ -317,6 +317,13 @@ class CanvasKitCanvas implements ui.Canvas {
     );
   }
 
+  @override
+  void drawBatch(ui.DrawBatch batch, ui.Paint paint) {
+    assert(batch != null); // ignore: unnecessary_null_comparison
+    assert(paint != null); // ignore: unnecessary_null_comparison
+    batch.webOnlyDraw(this, paint);
+  }
+
   @override
   void drawVertices(
       ui.Vertices vertices, ui.BlendMode blendMode, ui.Paint paint) {
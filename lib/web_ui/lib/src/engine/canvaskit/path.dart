@@ -85,6 +85,13 @@ class CkPath extends ManagedSkiaObject<SkPath> implements ui.Path {
     freeFloat32List(encodedPoints);
   }
 
+  @override
+  void addPolygons(List<List<ui.Offset>> polygons, bool close) {
+    for (final List<ui.Offset> polygon in polygons) {
+      addPolygon(polygon, close);
+    }
+  }
+
   @override
   void addRRect(ui.RRect rrect) {
     skiaObject.addRRect(
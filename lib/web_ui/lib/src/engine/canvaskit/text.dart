@@ -562,6 +562,9 @@ class CkParagraph extends ManagedSkiaObject<SkParagraph>
     return ui.TextRange(start: skRange.start, end: skRange.end);
   }
 
+  @override
+  bool updatePaintStyles(ui.Paragraph styled) => false;
+
   @override
   void layout(ui.ParagraphConstraints constraints) {
     _lastLayoutConstraints = constraints;
@@ -985,6 +985,15 @@ class SurfacePath implements ui.Path {
     _debugValidate();
   }
 
+  /// Adds a new subpath for each of the given lists of points, as if
+  /// [addPolygon] was called with each of them in turn.
+  @override
+  void addPolygons(List<List<ui.Offset>> polygons, bool close) {
+    for (final List<ui.Offset> polygon in polygons) {
+      addPolygon(polygon, close);
+    }
+  }
+
   /// Adds a new subpath that consists of the straight lines and
   /// curves needed to form the rounded rectangle described by the
   /// argument.
@@ -70,6 +70,9 @@ class CanvasParagraph implements EngineParagraph {
   late final TextLayoutService _layoutService = TextLayoutService(this);
   late final TextPaintService _paintService = TextPaintService(this);
 
+  @override
+  bool updatePaintStyles(ui.Paragraph styled) => false;
+
   @override
   void layout(ui.ParagraphConstraints constraints) {
     // When constraint width has a decimal place, we floor it to avoid getting
@@ -344,6 +344,9 @@ class DomParagraph implements EngineParagraph {
   /// directly into a canvas without css text alignment styling.
   double _alignOffset = 0.0;
 
+  @override
+  bool updatePaintStyles(ui.Paragraph styled) => false;
+
   @override
   void layout(ui.ParagraphConstraints constraints) {
     // When constraint width has a decimal place, we floor it to avoid getting
@@ -71,6 +71,63 @@ class Vertices {
   }
 }
 
+class DrawBatch {
+  DrawBatch();
+
+  final List<void Function(Canvas canvas, Paint paint)> _shapes =
+      <void Function(Canvas canvas, Paint paint)>[];
+
+  int get length => _shapes.length;
+
+  void addRect(Rect rect, {Color? color}) {
+    _addShape(color, (Canvas canvas, Paint paint) {
+      canvas.drawRect(rect, paint);
+    });
+  }
+
+  void addOval(Rect rect, {Color? color}) {
+    _addShape(color, (Canvas canvas, Paint paint) {
+      canvas.drawOval(rect, paint);
+    });
+  }
+
+  void addCircle(Offset c, double radius, {Color? color}) {
+    _addShape(color, (Canvas canvas, Paint paint) {
+      canvas.drawCircle(c, radius, paint);
+    });
+  }
+
+  void addLine(Offset p1, Offset p2, {Color? color}) {
+    _addShape(color, (Canvas canvas, Paint paint) {
+      canvas.drawLine(p1, p2, paint);
+    });
+  }
+
+  void clear() {
+    _shapes.clear();
+  }
+
+  void _addShape(Color? color, void Function(Canvas canvas, Paint paint) draw) {
+    if (color == null) {
+      _shapes.add(draw);
+      return;
+    }
+    _shapes.add((Canvas canvas, Paint paint) {
+      final Color paintColor = paint.color;
+      paint.color = color;
+      draw(canvas, paint);
+      paint.color = paintColor;
+    });
+  }
+
+  // webOnly
+  void webOnlyDraw(Canvas canvas, Paint paint) {
+    for (final void Function(Canvas canvas, Paint paint) draw in _shapes) {
+      draw(canvas, paint);
+    }
+  }
+}
+
 abstract class PictureRecorder {
   factory PictureRecorder() {
     if (engine.useCanvasKit) {
@@ -120,6 +177,7 @@ abstract class Canvas {
   void drawParagraph(Paragraph paragraph, Offset offset);
   void drawPoints(PointMode pointMode, List<Offset> points, Paint paint);
   void drawRawPoints(PointMode pointMode, Float32List points, Paint paint);
+  void drawBatch(DrawBatch batch, Paint paint);
 
   void drawVertices(Vertices vertices, BlendMode blendMode, Paint paint);
   void drawAtlas(
@@ -51,6 +51,7 @@ abstract class Path {
   void addOval(Rect oval);
   void addArc(Rect oval, double startAngle, double sweepAngle);
   void addPolygon(List<Offset> points, bool close);
+  void addPolygons(List<List<Offset>> polygons, bool close);
   void addRRect(RRect rrect);
   void addPath(Path path, Offset offset, {Float64List? matrix4});
   void extendWithPath(Path path, Offset offset, {Float64List? matrix4});
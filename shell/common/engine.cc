@@ -422,6 +422,9 @@ void Engine::DispatchSemanticsAction(int id,
 }
 
 void Engine::SetSemanticsEnabled(bool enabled) {
+  // The platform rebuilds its semantics tree from scratch when semantics are
+  // enabled again.
+  semantics_update_filter_.Reset();
   runtime_controller_->SetSemanticsEnabled(enabled);
 }
 
@@ -466,6 +469,13 @@ void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
 
 void Engine::UpdateSemantics(SemanticsNodeUpdates update,
                              CustomAccessibilityActionUpdates actions) {
+  if (settings_.enable_semantics_update_filter) {
+    TRACE_EVENT0("flutter", "SemanticsUpdateFilter");
+    semantics_update_filter_.Filter(update);
+    if (update.empty() && actions.empty()) {
+      return;
+    }
+  }
   delegate_.OnEngineUpdateSemantics(std::move(update), std::move(actions));
 }
 
@@ -17,6 +17,7 @@
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
+#include "flutter/lib/ui/semantics/semantics_update_filter.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
@@ -900,6 +901,9 @@ class Engine final : public RuntimeDelegate,
   ImageDecoder image_decoder_;
   TaskRunners task_runners_;
   size_t hint_freed_bytes_since_last_idle_ = 0;
+  // Drops unchanged nodes from semantics updates if
+  // |Settings::enable_semantics_update_filter| is set.
+  SemanticsUpdateFilter semantics_update_filter_;
   fml::WeakPtrFactory<Engine> weak_factory_;
 
   // |RuntimeDelegate|
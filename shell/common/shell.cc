@@ -18,6 +18,7 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/runtime/dart_vm.h"
@@ -31,6 +32,7 @@
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
+#include "txt/font_coverage_cache.h"
 
 namespace flutter {
 
@@ -101,6 +103,16 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
+        RasterCache& raster_cache =
+            rasterizer->compositor_context()->raster_cache();
+        raster_cache.SetScaleTolerance(
+            shell->GetSettings().raster_cache_scale_tolerance);
+        raster_cache.SetAtlasEnabled(
+            shell->GetSettings().enable_raster_cache_atlas);
+        if (shell->GetSettings().enable_parallel_preroll) {
+          rasterizer->compositor_context()->SetPrerollTaskRunner(
+              shell->GetDartVM()->GetConcurrentWorkerTaskRunner());
+        }
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
@@ -269,6 +281,26 @@ static void PerformInitializationTasks(Settings& settings) {
   });
 }
 
+// Reuses the coverage of the fonts that were loaded in earlier runs, which is
+// one of the costs of the first paragraph layout. The cache is shared by every
+// shell in the process, so it is installed once, and writes to it on a thread
+// of its own that is never torn down since they may outlive every shell.
+static void InstallFontCoverageCache() {
+  static std::once_flag gFontCoverageCacheInstallation = {};
+  std::call_once(gFontCoverageCacheInstallation, [] {
+    auto directory =
+        PersistentCache::GetCacheForProcess()->GetFontCoverageCacheDirectory();
+    if (!directory || !directory->is_valid()) {
+      return;
+    }
+    // Leaked on purpose, see above.
+    auto* store_thread = new fml::Thread("io.flutter.font_coverage_cache");
+    minikin::FontFamily::setCoverageCache(
+        std::make_shared<txt::FontCoverageCache>(
+            std::move(directory), store_thread->GetTaskRunner()));
+  });
+}
+
 std::unique_ptr<Shell> Shell::Create(
     TaskRunners task_runners,
     Settings settings,
@@ -636,6 +668,8 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   weak_rasterizer_ = rasterizer_->GetWeakPtr();
   weak_platform_view_ = platform_view_->GetWeakPtr();
 
+  InstallFontCoverageCache();
+
   // Setup the time-consuming default font manager right after engine created.
   fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
                                     [engine = weak_engine_] {
@@ -1638,6 +1672,9 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   response->AddMember<uint64_t>("pictureBytes",
                                 raster_cache.EstimatePictureCacheByteSize(),
                                 response->GetAllocator());
+  response->AddMember<uint64_t>("atlasBytes",
+                                raster_cache.EstimateAtlasByteSize(),
+                                response->GetAllocator());
   return true;
 }
 
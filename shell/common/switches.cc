@@ -381,6 +381,36 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_skparagraph =
       command_line.HasOption(FlagForSwitch(Switch::EnableSkParagraph));
 
+  settings.enable_compiled_layer_trees =
+      command_line.HasOption(FlagForSwitch(Switch::EnableCompiledLayerTrees));
+
+  settings.enable_picture_fingerprints =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePictureFingerprints));
+
+  std::string raster_cache_scale_tolerance;
+  if (command_line.GetOptionValue(
+          FlagForSwitch(Switch::RasterCacheScaleTolerance),
+          &raster_cache_scale_tolerance)) {
+    settings.raster_cache_scale_tolerance =
+        std::stod(raster_cache_scale_tolerance);
+  }
+
+  settings.enable_raster_cache_atlas =
+      command_line.HasOption(FlagForSwitch(Switch::EnableRasterCacheAtlas));
+
+  settings.enable_parallel_preroll =
+      command_line.HasOption(FlagForSwitch(Switch::EnableParallelPreroll));
+
+  std::string worker_cpu_affinity_mask;
+  if (command_line.GetOptionValue(FlagForSwitch(Switch::WorkerCPUAffinityMask),
+                                  &worker_cpu_affinity_mask)) {
+    settings.worker_cpu_affinity_mask =
+        std::stoull(worker_cpu_affinity_mask, nullptr, 0);
+  }
+
+  settings.enable_semantics_update_filter = command_line.HasOption(
+      FlagForSwitch(Switch::EnableSemanticsUpdateFilter));
+
   std::string all_dart_flags;
   if (command_line.GetOptionValue(FlagForSwitch(Switch::DartFlags),
                                   &all_dart_flags)) {
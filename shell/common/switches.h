@@ -205,6 +205,36 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(EnableSkParagraph,
            "enable-skparagraph",
            "Selects the SkParagraph implementation of the text layout engine.")
+DEF_SWITCH(EnableCompiledLayerTrees,
+           "enable-compiled-layer-trees",
+           "Flattens the layer tree of each scene into a contiguous array of "
+           "ops to reduce the cost of prerolling and painting large trees.")
+DEF_SWITCH(EnablePictureFingerprints,
+           "enable-picture-fingerprints",
+           "Fingerprints the content of recorded pictures so that the raster "
+           "cache can reuse entries across pictures that are re-recorded "
+           "with the same content.")
+DEF_SWITCH(RasterCacheScaleTolerance,
+           "raster-cache-scale-tolerance",
+           "Lets the raster cache draw entries rasterized at a scale within "
+           "this relative tolerance of the current one, e.g. 0.25, with "
+           "filtering, so that zoom and scale animations can reuse them.")
+DEF_SWITCH(EnableRasterCacheAtlas,
+           "enable-raster-cache-atlas",
+           "Packs small raster cache entries into shared atlas surfaces "
+           "instead of giving each entry a surface of its own.")
+DEF_SWITCH(EnableParallelPreroll,
+           "enable-parallel-preroll",
+           "Prerolls the independent subtrees of large layer trees in "
+           "parallel on background worker threads.")
+DEF_SWITCH(WorkerCPUAffinityMask,
+           "worker-cpu-affinity-mask",
+           "The CPUs that background worker threads may run on, as a bit "
+           "mask with one bit per CPU, e.g. 0x0f for the first four.")
+DEF_SWITCH(EnableSemanticsUpdateFilter,
+           "enable-semantics-update-filter",
+           "Only sends the semantics nodes that changed since they were last "
+           "sent to the platform.")
 
 DEF_SWITCHES_END
 
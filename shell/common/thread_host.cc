@@ -11,25 +11,39 @@ ThreadHost::ThreadHost() = default;
 ThreadHost::ThreadHost(ThreadHost&&) = default;
 
 ThreadHost::ThreadHost(std::string name_prefix_arg, uint64_t mask)
+    : ThreadHost(std::move(name_prefix_arg), mask, ThreadConfigs{}) {}
+
+static std::unique_ptr<fml::Thread> CreateThread(
+    fml::Thread::ThreadConfig config,
+    std::string name) {
+  config.name = std::move(name);
+  return std::make_unique<fml::Thread>(config);
+}
+
+ThreadHost::ThreadHost(std::string name_prefix_arg,
+                       uint64_t mask,
+                       const ThreadConfigs& configs)
     : name_prefix(name_prefix_arg) {
   if (mask & ThreadHost::Type::Platform) {
-    platform_thread = std::make_unique<fml::Thread>(name_prefix + ".platform");
+    platform_thread =
+        CreateThread(configs.platform, name_prefix + ".platform");
   }
 
   if (mask & ThreadHost::Type::UI) {
-    ui_thread = std::make_unique<fml::Thread>(name_prefix + ".ui");
+    ui_thread = CreateThread(configs.ui, name_prefix + ".ui");
   }
 
   if (mask & ThreadHost::Type::RASTER) {
-    raster_thread = std::make_unique<fml::Thread>(name_prefix + ".raster");
+    raster_thread = CreateThread(configs.raster, name_prefix + ".raster");
   }
 
   if (mask & ThreadHost::Type::IO) {
-    io_thread = std::make_unique<fml::Thread>(name_prefix + ".io");
+    io_thread = CreateThread(configs.io, name_prefix + ".io");
   }
 
   if (mask & ThreadHost::Type::Profiler) {
-    profiler_thread = std::make_unique<fml::Thread>(name_prefix + ".profiler");
+    profiler_thread =
+        CreateThread(configs.profiler, name_prefix + ".profiler");
   }
 }
 
@@ -22,6 +22,16 @@ struct ThreadHost {
     Profiler = 1 << 4,
   };
 
+  /// How each of the threads is scheduled. The names in the configurations
+  /// are ignored since threads are named after the prefix of the host.
+  struct ThreadConfigs {
+    fml::Thread::ThreadConfig platform;
+    fml::Thread::ThreadConfig ui;
+    fml::Thread::ThreadConfig raster;
+    fml::Thread::ThreadConfig io;
+    fml::Thread::ThreadConfig profiler;
+  };
+
   std::string name_prefix;
   std::unique_ptr<fml::Thread> platform_thread;
   std::unique_ptr<fml::Thread> ui_thread;
@@ -37,6 +47,10 @@ struct ThreadHost {
 
   ThreadHost(std::string name_prefix, uint64_t type_mask);
 
+  ThreadHost(std::string name_prefix,
+             uint64_t type_mask,
+             const ThreadConfigs& configs);
+
   ~ThreadHost();
 };
 
@@ -5,6 +5,7 @@
 #include "accessibility_bridge.h"
 
 #include <functional>
+#include <unordered_set>
 #include <utility>
 
 #include "flutter/third_party/accessibility/ax/ax_tree_update.h"
@@ -44,27 +45,14 @@ void AccessibilityBridge::AddFlutterSemanticsCustomActionUpdate(
 
 void AccessibilityBridge::CommitUpdates() {
   ui::AXTreeUpdate update{.tree_data = tree_.data()};
-  // Figure out update order, ui::AXTree only accepts update in tree order,
-  // where parent node must come before the child node in
-  // ui::AXTreeUpdate.nodes. We start with picking a random node and turn the
-  // entire subtree into a list. We pick another node from the remaining update,
-  // and keep doing so until the update map is empty. We then concatenate the
-  // lists in the reversed order, this guarantees parent updates always come
-  // before child updates.
-  std::vector<std::vector<SemanticsNode>> results;
-  while (!pending_semantics_node_updates_.empty()) {
-    auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
-    pending_semantics_node_updates_.erase(begin);
-  }
-
-  for (size_t i = results.size(); i > 0; i--) {
-    for (SemanticsNode node : results[i - 1]) {
-      ConvertFluterUpdate(node, update);
-    }
+  // ui::AXTree only accepts updates in tree order, where a parent node must
+  // come before its children in ui::AXTreeUpdate.nodes. The pending nodes are
+  // converted where they are, so that their strings are moved rather than
+  // copied into the update.
+  std::vector<SemanticsNode*> sorted_nodes = GetPendingNodesInTreeOrder();
+  update.nodes.reserve(sorted_nodes.size());
+  for (SemanticsNode* node : sorted_nodes) {
+    ConvertFluterUpdate(*node, update);
   }
 
   tree_.Unserialize(update);
@@ -155,20 +143,45 @@ void AccessibilityBridge::OnAtomicUpdateFinished(
 }
 
 // Private method.
-void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
-                                         std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
-    auto iter = pending_semantics_node_updates_.find(child);
-    if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
-      pending_semantics_node_updates_.erase(iter);
+std::vector<AccessibilityBridge::SemanticsNode*>
+AccessibilityBridge::GetPendingNodesInTreeOrder() {
+  // The pending nodes whose parents are not pending are the roots of the
+  // changed parts of the tree. Walking the pending nodes below each of them
+  // in pre-order puts every parent before its children.
+  std::unordered_set<int32_t> pending_children;
+  for (const auto& [id, node] : pending_semantics_node_updates_) {
+    for (int32_t child : node.children_in_traversal_order) {
+      if (pending_semantics_node_updates_.count(child) > 0) {
+        pending_children.insert(child);
+      }
+    }
+  }
+
+  std::vector<SemanticsNode*> result;
+  result.reserve(pending_semantics_node_updates_.size());
+  std::vector<SemanticsNode*> stack;
+  for (auto& [id, root] : pending_semantics_node_updates_) {
+    if (pending_children.count(id) > 0) {
+      continue;
+    }
+    stack.push_back(&root);
+    while (!stack.empty()) {
+      SemanticsNode* node = stack.back();
+      stack.pop_back();
+      result.push_back(node);
+      for (int32_t child : node->children_in_traversal_order) {
+        // Each pending child is visited once, even if the update lists it
+        // under more than one parent.
+        if (pending_children.erase(child) > 0) {
+          stack.push_back(&pending_semantics_node_updates_.at(child));
+        }
+      }
     }
   }
+  return result;
 }
 
-void AccessibilityBridge::ConvertFluterUpdate(const SemanticsNode& node,
+void AccessibilityBridge::ConvertFluterUpdate(SemanticsNode& node,
                                               ui::AXTreeUpdate& tree_update) {
   ui::AXNodeData node_data;
   node_data.id = node.id;
@@ -189,11 +202,9 @@ void AccessibilityBridge::ConvertFluterUpdate(const SemanticsNode& node,
       node.transform.skewY, node.transform.scaleY, node.transform.transY, 0,
       node.transform.pers0, node.transform.pers1, node.transform.pers2, 0, 0, 0,
       0, 0);
-  for (auto child : node.children_in_traversal_order) {
-    node_data.child_ids.push_back(child);
-  }
+  node_data.child_ids = std::move(node.children_in_traversal_order);
   SetTreeData(node, tree_update);
-  tree_update.nodes.push_back(node_data);
+  tree_update.nodes.push_back(std::move(node_data));
 }
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -387,13 +398,13 @@ void AccessibilityBridge::SetStringListAttributesFromFlutterUpdate(
 }
 
 void AccessibilityBridge::SetNameFromFlutterUpdate(ui::AXNodeData& node_data,
-                                                   const SemanticsNode& node) {
-  node_data.SetName(node.label);
+                                                   SemanticsNode& node) {
+  node_data.SetName(std::move(node.label));
 }
 
 void AccessibilityBridge::SetValueFromFlutterUpdate(ui::AXNodeData& node_data,
-                                                    const SemanticsNode& node) {
-  node_data.SetValue(node.value);
+                                                    SemanticsNode& node) {
+  node_data.SetValue(std::move(node.value));
 }
 
 void AccessibilityBridge::SetTreeData(const SemanticsNode& node,
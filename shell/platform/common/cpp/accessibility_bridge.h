@@ -201,9 +201,9 @@ class AccessibilityBridge
   std::unique_ptr<AccessibilityBridgeDelegate> delegate_;
 
   void InitAXTree(const ui::AXTreeUpdate& initial_state);
-  void GetSubTreeList(SemanticsNode target, std::vector<SemanticsNode>& result);
-  void ConvertFluterUpdate(const SemanticsNode& node,
-                           ui::AXTreeUpdate& tree_update);
+  std::vector<SemanticsNode*> GetPendingNodesInTreeOrder();
+  // Moves the strings and children of |node| into |tree_update|.
+  void ConvertFluterUpdate(SemanticsNode& node, ui::AXTreeUpdate& tree_update);
   void SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
                                 const SemanticsNode& node);
   void SetStateFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -219,9 +219,9 @@ class AccessibilityBridge
   void SetStringListAttributesFromFlutterUpdate(ui::AXNodeData& node_data,
                                                 const SemanticsNode& node);
   void SetNameFromFlutterUpdate(ui::AXNodeData& node_data,
-                                const SemanticsNode& node);
+                                SemanticsNode& node);
   void SetValueFromFlutterUpdate(ui::AXNodeData& node_data,
-                                 const SemanticsNode& node);
+                                 SemanticsNode& node);
   void SetTreeData(const SemanticsNode& node, ui::AXTreeUpdate& tree_update);
   SemanticsNode FromFlutterSemanticsNode(
       const FlutterSemanticsNode* flutter_node);
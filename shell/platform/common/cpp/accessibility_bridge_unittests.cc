@@ -4,6 +4,9 @@
 
 #include "accessibility_bridge.h"
 
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "test_accessibility_bridge.h"
@@ -200,5 +203,72 @@ TEST(AccessibilityBridgeTest, canHandleSelectionChangeCorrectly) {
             ui::AXEventGenerator::Event::OTHER_ATTRIBUTE_CHANGED);
 }
 
+TEST(AccessibilityBridgeTest, canUpdateOneNodeOfLargeTree) {
+  TestAccessibilityBridgeDelegate* delegate =
+      new TestAccessibilityBridgeDelegate();
+  std::unique_ptr<TestAccessibilityBridgeDelegate> ptr(delegate);
+  std::shared_ptr<AccessibilityBridge> bridge =
+      std::make_shared<AccessibilityBridge>(std::move(ptr));
+
+  // Node i has the children i * fanout + 1 to i * fanout + fanout.
+  const int32_t node_count = 10000;
+  const int32_t fanout = 10;
+  std::vector<std::string> labels(node_count);
+  std::vector<std::vector<int32_t>> children(node_count);
+  for (int32_t id = 0; id < node_count; id++) {
+    labels[id] = "node " + std::to_string(id);
+    for (int32_t child = id * fanout + 1;
+         child <= id * fanout + fanout && child < node_count; child++) {
+      children[id].push_back(child);
+    }
+  }
+  auto add_node = [&](int32_t id) {
+    FlutterSemanticsNode node = {};
+    node.id = id;
+    node.text_selection_base = -1;
+    node.text_selection_extent = -1;
+    node.label = labels[id].c_str();
+    node.hint = "";
+    node.value = "";
+    node.increased_value = "";
+    node.decreased_value = "";
+    node.child_count = children[id].size();
+    node.children_in_traversal_order = children[id].data();
+    bridge->AddFlutterSemanticsNodeUpdate(&node);
+  };
+
+  // Children are added before their parents, so the commit has to reorder
+  // them.
+  for (int32_t id = node_count - 1; id >= 0; id--) {
+    add_node(id);
+  }
+  bridge->CommitUpdates();
+
+  auto root_node = bridge->GetFlutterPlatformNodeDelegateFromID(0).lock();
+  ASSERT_TRUE(root_node);
+  EXPECT_EQ(root_node->GetChildCount(), fanout);
+  std::weak_ptr<FlutterPlatformNodeDelegate> last_node =
+      bridge->GetFlutterPlatformNodeDelegateFromID(node_count - 1);
+  ASSERT_FALSE(last_node.expired());
+  EXPECT_EQ(last_node.lock()->GetName(), "node 9999");
+
+  // Changing the label of one node only updates that node.
+  delegate->accessibilitiy_events.clear();
+  const int32_t changed_id = node_count / 2;
+  labels[changed_id] = "changed";
+  add_node(changed_id);
+  bridge->CommitUpdates();
+
+  auto changed_node =
+      bridge->GetFlutterPlatformNodeDelegateFromID(changed_id).lock();
+  ASSERT_TRUE(changed_node);
+  EXPECT_EQ(changed_node->GetName(), "changed");
+  EXPECT_FALSE(last_node.expired());
+  EXPECT_FALSE(delegate->accessibilitiy_events.empty());
+  for (const auto& event : delegate->accessibilitiy_events) {
+    EXPECT_EQ(event.node->id(), changed_id);
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
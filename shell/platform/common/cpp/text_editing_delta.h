@@ -0,0 +1,36 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_CPP_TEXT_EDITING_DELTA_H_
+#define FLUTTER_SHELL_PLATFORM_CPP_TEXT_EDITING_DELTA_H_
+
+#include <string>
+#include <utility>
+
+#include "flutter/shell/platform/common/cpp/text_range.h"
+
+namespace flutter {
+
+// A change to the text of a |TextInputModel|.
+//
+// |old_text|, the code units in |range|, was replaced with |text|. |range| is
+// in UTF-16 code units of the text as it was before the change.
+struct TextEditingDelta {
+  TextEditingDelta(const TextRange& range,
+                   std::string text,
+                   std::string old_text)
+      : range(range), text(std::move(text)), old_text(std::move(old_text)) {}
+
+  TextRange range;
+
+  // The replacement text, as UTF-8.
+  std::string text;
+
+  // The replaced text, as UTF-8.
+  std::string old_text;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_CPP_TEXT_EDITING_DELTA_H_
@@ -36,7 +36,8 @@ TextInputModel::~TextInputModel() = default;
 void TextInputModel::SetText(const std::string& text) {
   std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
       utf16_converter;
-  text_ = utf16_converter.from_bytes(text);
+  text_ = TextRope(utf16_converter.from_bytes(text));
+  pending_delta_.reset();
   selection_ = TextRange(0);
   composing_range_ = TextRange(0);
 }
@@ -73,7 +74,7 @@ void TextInputModel::UpdateComposingText(const std::u16string& text) {
     return;
   }
   DeleteSelected();
-  text_.replace(composing_range_.start(), composing_range_.length(), text);
+  ReplaceText(composing_range_, text);
   composing_range_.set_end(composing_range_.start() + text.length());
   selection_ = TextRange(composing_range_.end());
 }
@@ -103,7 +104,7 @@ bool TextInputModel::DeleteSelected() {
     return false;
   }
   size_t start = selection_.start();
-  text_.erase(start, selection_.length());
+  ReplaceText(selection_, std::u16string());
   selection_ = TextRange(start);
   if (composing_) {
     // This occurs only immediately after composing has begun with a selection.
@@ -130,12 +131,12 @@ void TextInputModel::AddText(const std::u16string& text) {
   DeleteSelected();
   if (composing_) {
     // Delete the current composing text, set the cursor to composing start.
-    text_.erase(composing_range_.start(), composing_range_.length());
+    ReplaceText(composing_range_, std::u16string());
     selection_ = TextRange(composing_range_.start());
     composing_range_.set_end(composing_range_.start() + text.length());
   }
   size_t position = selection_.position();
-  text_.insert(position, text);
+  ReplaceText(TextRange(position), text);
   selection_ = TextRange(position + text.length());
 }
 
@@ -153,7 +154,7 @@ bool TextInputModel::Backspace() {
   size_t position = selection_.position();
   if (position != editable_range().start()) {
     int count = IsTrailingSurrogate(text_.at(position - 1)) ? 2 : 1;
-    text_.erase(position - count, count);
+    ReplaceText(TextRange(position - count, position), std::u16string());
     selection_ = TextRange(position - count);
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
@@ -171,7 +172,7 @@ bool TextInputModel::Delete() {
   size_t position = selection_.position();
   if (position < editable_range().end()) {
     int count = IsLeadingSurrogate(text_.at(position)) ? 2 : 1;
-    text_.erase(position, count);
+    ReplaceText(TextRange(position, position + count), std::u16string());
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
     }
@@ -209,7 +210,7 @@ bool TextInputModel::DeleteSurrounding(int offset_from_cursor, int count) {
   }
 
   auto deleted_length = end - start;
-  text_.erase(start, deleted_length);
+  ReplaceText(TextRange(start, end), std::u16string());
 
   // Cursor moves only if deleted area is before it.
   selection_ = TextRange(offset_from_cursor <= 0 ? start : selection_.start());
@@ -272,18 +273,71 @@ bool TextInputModel::MoveCursorBack() {
 }
 
 std::string TextInputModel::GetText() const {
-  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-      utf8_converter;
-  return utf8_converter.to_bytes(text_);
+  return text_.ToUtf8();
 }
 
 int TextInputModel::GetCursorOffset() const {
-  // Measure the length of the current text up to the selection extent.
-  // There is probably a much more efficient way of doing this.
-  auto leading_text = text_.substr(0, selection_.extent());
-  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-      utf8_converter;
-  return utf8_converter.to_bytes(leading_text).size();
+  return text_.Utf8Offset(selection_.extent());
+}
+
+std::optional<TextEditingDelta> TextInputModel::TakeEditingDelta() {
+  if (!pending_delta_) {
+    return std::nullopt;
+  }
+  // Widen the region so that it doesn't split a surrogate pair of either the
+  // old or the current text.
+  if (pending_delta_->start > 0 &&
+      IsLeadingSurrogate(text_.at(pending_delta_->start - 1))) {
+    ExtendPendingDelta(pending_delta_->start - 1, pending_delta_->new_end);
+  }
+  if (pending_delta_->new_end < text_.length() &&
+      IsTrailingSurrogate(text_.at(pending_delta_->new_end))) {
+    ExtendPendingDelta(pending_delta_->start, pending_delta_->new_end + 1);
+  }
+  PendingDelta pending = std::move(*pending_delta_);
+  pending_delta_.reset();
+
+  // Encode through the rope, which encodes unpaired surrogates as U+FFFD
+  // instead of throwing like std::wstring_convert.
+  return TextEditingDelta(
+      TextRange(pending.start, pending.old_end),
+      text_.Utf8Substring(pending.start, pending.new_end - pending.start),
+      TextRope::ToUtf8(pending.old_text));
+}
+
+void TextInputModel::ReplaceText(const TextRange& range,
+                                 const std::u16string& text) {
+  if (range.collapsed() && text.empty()) {
+    return;
+  }
+  if (record_editing_deltas_) {
+    ExtendPendingDelta(range.start(), range.end());
+    PendingDelta& pending = *pending_delta_;
+    pending.new_end = pending.new_end - range.length() + text.length();
+  }
+  text_.Replace(range.start(), range.length(), text);
+}
+
+void TextInputModel::ExtendPendingDelta(size_t start, size_t end) {
+  if (!pending_delta_) {
+    pending_delta_ =
+        PendingDelta{start, end, end, text_.Substring(start, end - start)};
+    return;
+  }
+  // Code units before the region are the same in the old and in the current
+  // text, and code units after it are offset by the change in length of the
+  // region, so the old text the region grows over is read from the current
+  // text.
+  PendingDelta& pending = *pending_delta_;
+  if (start < pending.start) {
+    pending.old_text.insert(0, text_.Substring(start, pending.start - start));
+    pending.start = start;
+  }
+  if (end > pending.new_end) {
+    pending.old_text += text_.Substring(pending.new_end, end - pending.new_end);
+    pending.old_end += end - pending.new_end;
+    pending.new_end = end;
+  }
 }
 
 }  // namespace flutter
@@ -6,15 +6,20 @@
 #define FLUTTER_SHELL_PLATFORM_CPP_TEXT_INPUT_MODEL_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
+#include "flutter/shell/platform/common/cpp/text_editing_delta.h"
 #include "flutter/shell/platform/common/cpp/text_range.h"
+#include "flutter/shell/platform/common/cpp/text_rope.h"
 
 namespace flutter {
 
 // Handles underlying text input state, using a simple ASCII model.
 //
-// Ignores special states like "insert mode" for now.
+// The text is stored in a |TextRope|, so edits and cursor offset queries stay
+// cheap for large documents. Ignores special states like "insert mode" for
+// now.
 class TextInputModel {
  public:
   TextInputModel();
@@ -22,7 +27,8 @@ class TextInputModel {
 
   // Sets the text.
   //
-  // Resets the selection base and extent.
+  // Resets the selection base and extent. Discards any recorded editing deltas,
+  // since the new text replaces the state they were relative to.
   void SetText(const std::string& text);
 
   // Attempts to set the text selection.
@@ -173,7 +179,46 @@ class TextInputModel {
   // Whether multi-step input composing mode is active.
   bool composing() const { return composing_; }
 
+  // Sets whether changes to the text are recorded for |TakeEditingDelta|.
+  //
+  // Disabling recording discards the changes that have not been taken yet.
+  void set_record_editing_deltas(bool record) {
+    record_editing_deltas_ = record;
+    if (!record) {
+      pending_delta_.reset();
+    }
+  }
+
+  bool record_editing_deltas() const { return record_editing_deltas_; }
+
+  // Returns a single delta that covers all of the changes made to the text
+  // since the last call, and clears them.
+  //
+  // Returns nullopt if the text didn't change, or if recording has not been
+  // enabled with |set_record_editing_deltas|.
+  std::optional<TextEditingDelta> TakeEditingDelta();
+
  private:
+  // The region of the text that changed since the last |TakeEditingDelta|.
+  struct PendingDelta {
+    // The start of the region.
+    size_t start;
+    // The end of the region in the text before the changes.
+    size_t old_end;
+    // The end of the region in the current text.
+    size_t new_end;
+    // The code units of the region in the text before the changes.
+    std::u16string old_text;
+  };
+
+  // Replaces the text in |range| with |text|, extending the pending delta if
+  // recording is enabled. Every change to the text goes through here.
+  void ReplaceText(const TextRange& range, const std::u16string& text);
+
+  // Grows the pending delta to cover the code units from |start| to |end| of
+  // the current text, starting one if there is none.
+  void ExtendPendingDelta(size_t start, size_t end);
+
   // Deletes the current selection, if any.
   //
   // Returns true if any text is deleted. The selection base and extent are
@@ -191,10 +236,12 @@ class TextInputModel {
   // Returns a range covering the entire text.
   TextRange text_range() const { return TextRange(0, text_.length()); }
 
-  std::u16string text_;
+  TextRope text_;
   TextRange selection_ = TextRange(0);
   TextRange composing_range_ = TextRange(0);
   bool composing_ = false;
+  bool record_editing_deltas_ = false;
+  std::optional<PendingDelta> pending_delta_;
 };
 
 }  // namespace flutter
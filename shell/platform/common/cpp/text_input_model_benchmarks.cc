@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/cpp/text_input_model.h"
+
+#include <string>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+namespace flutter {
+
+namespace {
+
+// Returns a document of roughly |length| UTF-8 bytes with some multi-byte
+// characters in every line.
+std::string MakeDocument(size_t length) {
+  const std::string line = "The quick brown fox jumps over the lazy dög €\n";
+  std::string document;
+  document.reserve(length + line.length());
+  while (document.length() < length) {
+    document += line;
+  }
+  return document;
+}
+
+// Types a character into the middle of the document and queries the cursor
+// offset, as the embeddings do for every key press.
+void BM_TextInputModelTyping(benchmark::State& state) {
+  TextInputModel model;
+  model.SetText(MakeDocument(state.range(0)));
+  model.MoveCursorToEnd();
+  model.SetSelection(TextRange(model.selection().position() / 2));
+  while (state.KeepRunning()) {
+    model.AddCodePoint('a');
+    benchmark::DoNotOptimize(model.GetCursorOffset());
+    model.Backspace();
+  }
+}
+
+// Same as |BM_TextInputModelTyping|, but also builds the full state update
+// that is sent to the framework without the delta model.
+void BM_TextInputModelTypingFullUpdate(benchmark::State& state) {
+  TextInputModel model;
+  model.SetText(MakeDocument(state.range(0)));
+  model.MoveCursorToEnd();
+  model.SetSelection(TextRange(model.selection().position() / 2));
+  while (state.KeepRunning()) {
+    model.AddCodePoint('a');
+    benchmark::DoNotOptimize(model.GetText());
+    model.Backspace();
+    benchmark::DoNotOptimize(model.GetText());
+  }
+}
+
+// Same as |BM_TextInputModelTyping|, but also builds the editing delta that
+// is sent to the framework with the delta model.
+void BM_TextInputModelTypingDeltaUpdate(benchmark::State& state) {
+  TextInputModel model;
+  model.set_record_editing_deltas(true);
+  model.SetText(MakeDocument(state.range(0)));
+  model.MoveCursorToEnd();
+  model.SetSelection(TextRange(model.selection().position() / 2));
+  while (state.KeepRunning()) {
+    model.AddCodePoint('a');
+    benchmark::DoNotOptimize(model.TakeEditingDelta());
+    model.Backspace();
+    benchmark::DoNotOptimize(model.TakeEditingDelta());
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_TextInputModelTyping)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_TextInputModelTypingFullUpdate)
+    ->Arg(1 << 10)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20);
+BENCHMARK(BM_TextInputModelTypingDeltaUpdate)
+    ->Arg(1 << 10)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20);
+
+}  // namespace flutter
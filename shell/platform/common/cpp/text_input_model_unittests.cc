@@ -1486,4 +1486,134 @@ TEST(TextInputModel, GetCursorOffsetReverseSelection) {
   EXPECT_EQ(model->GetCursorOffset(), 1);
 }
 
+TEST(TextInputModel, GetCursorOffsetLargeText) {
+  auto model = std::make_unique<TextInputModel>();
+  // Spans many rope chunks, with a multi-byte character in every line.
+  std::string line = "Line of text ¢\n";
+  std::string text;
+  for (int i = 0; i < 10000; i++) {
+    text += line;
+  }
+  model->SetText(text);
+  EXPECT_EQ(model->GetText(), text);
+  // Each line is 15 UTF-16 code units and 16 UTF-8 bytes long.
+  EXPECT_TRUE(model->SetSelection(TextRange(15 * 5000)));
+  EXPECT_EQ(model->GetCursorOffset(), static_cast<int>(line.length() * 5000));
+  model->AddText("𐍈");
+  EXPECT_EQ(model->GetCursorOffset(),
+            static_cast<int>(line.length() * 5000 + 4));
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_EQ(model->GetText(), text);
+}
+
+TEST(TextInputModel, NoEditingDeltaByDefault) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("ABCDE");
+  model->AddText("FGH");
+  EXPECT_FALSE(model->TakeEditingDelta());
+}
+
+TEST(TextInputModel, EditingDeltaForAddText) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_record_editing_deltas(true);
+  model->SetText("ABCDE");
+  EXPECT_TRUE(model->SetSelection(TextRange(3, 1)));
+  model->AddText("¢x");
+  auto delta = model->TakeEditingDelta();
+  ASSERT_TRUE(delta);
+  EXPECT_EQ(delta->range, TextRange(1, 3));
+  EXPECT_EQ(delta->text, "¢x");
+  EXPECT_EQ(delta->old_text, "BC");
+  EXPECT_FALSE(model->TakeEditingDelta());
+}
+
+TEST(TextInputModel, EditingDeltaForDeletion) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_record_editing_deltas(true);
+  model->SetText("A𐍈B");
+  EXPECT_TRUE(model->SetSelection(TextRange(3)));
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_TRUE(model->Delete());
+  EXPECT_FALSE(model->Delete());
+  auto delta = model->TakeEditingDelta();
+  ASSERT_TRUE(delta);
+  EXPECT_EQ(delta->range, TextRange(1, 4));
+  EXPECT_EQ(delta->text, "");
+  EXPECT_EQ(delta->old_text, "𐍈B");
+  EXPECT_EQ(model->GetText(), "A");
+}
+
+TEST(TextInputModel, EditingDeltaForComposing) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_record_editing_deltas(true);
+  model->SetText("ABCDE");
+  EXPECT_TRUE(model->SetSelection(TextRange(2)));
+  model->BeginComposing();
+  model->UpdateComposingText("xy");
+  model->UpdateComposingText("xyz");
+  model->CommitComposing();
+  model->EndComposing();
+  auto delta = model->TakeEditingDelta();
+  ASSERT_TRUE(delta);
+  EXPECT_EQ(delta->range, TextRange(2));
+  EXPECT_EQ(delta->text, "xyz");
+  EXPECT_EQ(delta->old_text, "");
+  EXPECT_EQ(model->GetText(), "ABxyzCDE");
+}
+
+TEST(TextInputModel, EditingDeltaCoversSeparateEdits) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_record_editing_deltas(true);
+  model->SetText("ABCDEFGH");
+  EXPECT_TRUE(model->SetSelection(TextRange(6)));
+  model->AddText("xy");
+  EXPECT_TRUE(model->SetSelection(TextRange(1)));
+  EXPECT_TRUE(model->Delete());
+  auto delta = model->TakeEditingDelta();
+  ASSERT_TRUE(delta);
+  // "BCDEF" became "CDEFxy".
+  EXPECT_EQ(delta->range, TextRange(1, 6));
+  EXPECT_EQ(delta->text, "CDEFxy");
+  EXPECT_EQ(delta->old_text, "BCDEF");
+  EXPECT_EQ(model->GetText(), "ACDEFxyGH");
+}
+
+TEST(TextInputModel, EditingDeltaDoesNotSplitSurrogatePairs) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_record_editing_deltas(true);
+  model->SetText("A𐍈B");
+  // Insert between the two halves of the pair, then delete the "A" so that
+  // the changed region ends between them.
+  EXPECT_TRUE(model->SetSelection(TextRange(2)));
+  model->AddText("x");
+  EXPECT_TRUE(model->SetSelection(TextRange(0)));
+  EXPECT_TRUE(model->Delete());
+  auto delta = model->TakeEditingDelta();
+  ASSERT_TRUE(delta);
+  // The region covers the whole pair, and its now unpaired halves are sent as
+  // U+FFFD.
+  EXPECT_EQ(delta->range, TextRange(0, 3));
+  EXPECT_EQ(delta->text, "\xEF\xBF\xBDx\xEF\xBF\xBD");
+  EXPECT_EQ(delta->old_text, "A𐍈");
+}
+
+TEST(TextInputModel, SetTextDiscardsEditingDelta) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_record_editing_deltas(true);
+  model->SetText("ABCDE");
+  model->AddText("FGH");
+  model->SetText("IJK");
+  EXPECT_FALSE(model->TakeEditingDelta());
+}
+
+TEST(TextInputModel, SelectionChangesHaveNoEditingDelta) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_record_editing_deltas(true);
+  model->SetText("ABCDE");
+  EXPECT_TRUE(model->SetSelection(TextRange(1, 4)));
+  EXPECT_TRUE(model->MoveCursorForward());
+  EXPECT_TRUE(model->MoveCursorToBeginning());
+  EXPECT_FALSE(model->TakeEditingDelta());
+}
+
 }  // namespace flutter
@@ -0,0 +1,335 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/cpp/text_rope.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+bool IsLeadingSurrogate(char16_t code_unit) {
+  return (code_unit & 0xFC00) == 0xD800;
+}
+
+bool IsTrailingSurrogate(char16_t code_unit) {
+  return (code_unit & 0xFC00) == 0xDC00;
+}
+
+// Returns the length of the UTF-8 encoding of the first |length| code units of
+// |text|.
+size_t Utf8Length(const std::u16string& text, size_t length) {
+  size_t result = 0;
+  for (size_t i = 0; i < length; i++) {
+    char16_t code_unit = text[i];
+    if (code_unit < 0x80) {
+      result += 1;
+    } else if (code_unit < 0x800) {
+      result += 2;
+    } else if (IsLeadingSurrogate(code_unit) && i + 1 < length &&
+               IsTrailingSurrogate(text[i + 1])) {
+      result += 4;
+      i++;
+    } else {
+      result += 3;
+    }
+  }
+  return result;
+}
+
+// Appends the UTF-8 encoding of the |length| code units at |text| to
+// |output|.
+void AppendUtf8(const char16_t* text, size_t length, std::string* output) {
+  for (size_t i = 0; i < length; i++) {
+    char32_t code_point = text[i];
+    if (IsLeadingSurrogate(code_point) && i + 1 < length &&
+        IsTrailingSurrogate(text[i + 1])) {
+      code_point =
+          0x10000 + ((code_point - 0xD800) << 10) + (text[++i] - 0xDC00);
+    } else if (IsLeadingSurrogate(code_point) ||
+               IsTrailingSurrogate(code_point)) {
+      code_point = 0xFFFD;
+    }
+
+    if (code_point < 0x80) {
+      output->push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+      output->push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+      output->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+      output->push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+      output->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      output->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+      output->push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+      output->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+      output->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      output->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+  }
+}
+
+}  // namespace
+
+void TextRope::LengthIndex::Reset(const std::vector<size_t>& lengths) {
+  tree_.assign(lengths.size() + 1, 0);
+  for (size_t i = 1; i < tree_.size(); i++) {
+    tree_[i] += lengths[i - 1];
+    size_t parent = i + (i & -i);
+    if (parent < tree_.size()) {
+      tree_[parent] += tree_[i];
+    }
+  }
+}
+
+void TextRope::LengthIndex::Add(size_t chunk, int64_t delta) {
+  for (size_t i = chunk + 1; i < tree_.size(); i += i & -i) {
+    tree_[i] += delta;
+  }
+}
+
+size_t TextRope::LengthIndex::Sum(size_t count) const {
+  size_t sum = 0;
+  for (size_t i = count; i > 0; i -= i & -i) {
+    sum += tree_[i];
+  }
+  return sum;
+}
+
+size_t TextRope::LengthIndex::CountBelow(size_t target) const {
+  const size_t size = tree_.size() - 1;
+  size_t step = 1;
+  while (step * 2 <= size) {
+    step *= 2;
+  }
+  size_t count = 0;
+  for (; step > 0; step /= 2) {
+    if (count + step <= size && tree_[count + step] < target) {
+      count += step;
+      target -= tree_[count];
+    }
+  }
+  return count;
+}
+
+TextRope::TextRope() : TextRope(std::u16string()) {}
+
+TextRope::TextRope(const std::u16string& text) : length_(text.length()) {
+  chunks_.push_back(MakeChunk(text));
+  SplitChunk(0);
+  RebuildIndex();
+}
+
+TextRope::~TextRope() = default;
+
+TextRope::TextRope(TextRope&&) = default;
+
+TextRope& TextRope::operator=(TextRope&&) = default;
+
+char16_t TextRope::at(size_t position) const {
+  FML_DCHECK(position < length_);
+  auto [index, offset] = Locate(position + 1);
+  return chunks_[index].text[offset - 1];
+}
+
+void TextRope::Replace(size_t position,
+                       size_t length,
+                       const std::u16string& text) {
+  FML_DCHECK(position + length <= length_);
+  auto [first, first_offset] = Locate(position);
+  auto [last, last_offset] = Locate(position + length);
+
+  std::u16string& chunk_text = chunks_[first].text;
+  if (first == last) {
+    chunk_text.replace(first_offset, length, text);
+  } else {
+    // Keep the head of the first chunk and the tail of the last one, and drop
+    // the chunks in between.
+    chunk_text.resize(first_offset);
+    chunk_text.append(text);
+    chunk_text.append(chunks_[last].text, last_offset);
+    chunks_.erase(chunks_.begin() + first + 1, chunks_.begin() + last + 1);
+  }
+  RefreshChunk(first);
+  length_ = length_ - length + text.length();
+
+  bool structure_changed = first != last;
+  size_t end = first + 1 + SplitChunk(first);
+  if (chunks_[first].text.empty() && chunks_.size() > 1) {
+    chunks_.erase(chunks_.begin() + first);
+    end--;
+  }
+  structure_changed = structure_changed || end != first + 1;
+  // Only the boundaries around the edited chunks can split a surrogate pair.
+  for (size_t i = first > 0 ? first - 1 : 0; i < end; i++) {
+    structure_changed = JoinSurrogatePair(i) || structure_changed;
+  }
+
+  if (structure_changed) {
+    RebuildIndex();
+  } else {
+    // Only the length of the edited chunk changed.
+    const Chunk& chunk = chunks_[first];
+    const size_t old_length =
+        utf16_index_.Sum(first + 1) - utf16_index_.Sum(first);
+    const size_t old_utf8_length =
+        utf8_index_.Sum(first + 1) - utf8_index_.Sum(first);
+    utf16_index_.Add(first, static_cast<int64_t>(chunk.text.length()) -
+                                static_cast<int64_t>(old_length));
+    utf8_index_.Add(first, static_cast<int64_t>(chunk.utf8_length) -
+                               static_cast<int64_t>(old_utf8_length));
+  }
+}
+
+std::u16string TextRope::Substring(size_t position, size_t length) const {
+  std::u16string result;
+  if (position >= length_) {
+    return result;
+  }
+  length = std::min(length, length_ - position);
+  result.reserve(length);
+  auto [index, offset] = Locate(position);
+  while (result.length() < length) {
+    const std::u16string& text = chunks_[index].text;
+    size_t count = std::min(text.length() - offset, length - result.length());
+    result.append(text, offset, count);
+    index++;
+    offset = 0;
+  }
+  return result;
+}
+
+std::u16string TextRope::ToUtf16() const {
+  std::u16string result;
+  result.reserve(length_);
+  for (const Chunk& chunk : chunks_) {
+    result.append(chunk.text);
+  }
+  return result;
+}
+
+std::string TextRope::ToUtf8() const {
+  std::string result;
+  result.reserve(utf8_index_.Sum(chunks_.size()));
+  for (const Chunk& chunk : chunks_) {
+    if (chunk.utf8.empty() && !chunk.text.empty()) {
+      chunk.utf8.reserve(chunk.utf8_length);
+      AppendUtf8(chunk.text.data(), chunk.text.length(), &chunk.utf8);
+    }
+    result.append(chunk.utf8);
+  }
+  return result;
+}
+
+std::string TextRope::Utf8Substring(size_t position, size_t length) const {
+  std::string result;
+  if (position >= length_) {
+    return result;
+  }
+  length = std::min(length, length_ - position);
+  auto [index, offset] = Locate(position);
+  while (length > 0) {
+    const std::u16string& text = chunks_[index].text;
+    size_t count = std::min(text.length() - offset, length);
+    AppendUtf8(text.data() + offset, count, &result);
+    length -= count;
+    index++;
+    offset = 0;
+  }
+  return result;
+}
+
+std::string TextRope::ToUtf8(const std::u16string& text) {
+  std::string result;
+  AppendUtf8(text.data(), text.length(), &result);
+  return result;
+}
+
+size_t TextRope::Utf8Offset(size_t position) const {
+  FML_DCHECK(position <= length_);
+  auto [index, offset] = Locate(position);
+  return utf8_index_.Sum(index) + Utf8Length(chunks_[index].text, offset);
+}
+
+std::pair<size_t, size_t> TextRope::Locate(size_t position) const {
+  if (position == 0) {
+    return {0, 0};
+  }
+  size_t index = utf16_index_.CountBelow(position);
+  return {index, position - utf16_index_.Sum(index)};
+}
+
+void TextRope::RefreshChunk(size_t index) {
+  Chunk& chunk = chunks_[index];
+  chunk.utf8_length = Utf8Length(chunk.text, chunk.text.length());
+  chunk.utf8.clear();
+}
+
+size_t TextRope::SplitChunk(size_t index) {
+  if (chunks_[index].text.length() <= kMaxChunkLength) {
+    return 0;
+  }
+  const std::u16string text = std::move(chunks_[index].text);
+  std::vector<Chunk> pieces;
+  size_t start = 0;
+  while (start < text.length()) {
+    size_t end = std::min(start + kMaxChunkLength / 2, text.length());
+    if (end < text.length() && IsLeadingSurrogate(text[end - 1]) &&
+        IsTrailingSurrogate(text[end])) {
+      end++;
+    }
+    pieces.push_back(MakeChunk(text.substr(start, end - start)));
+    start = end;
+  }
+  chunks_[index] = std::move(pieces[0]);
+  chunks_.insert(chunks_.begin() + index + 1,
+                 std::make_move_iterator(pieces.begin() + 1),
+                 std::make_move_iterator(pieces.end()));
+  return pieces.size() - 1;
+}
+
+bool TextRope::JoinSurrogatePair(size_t index) {
+  if (index + 1 >= chunks_.size()) {
+    return false;
+  }
+  std::u16string& text = chunks_[index].text;
+  std::u16string& next = chunks_[index + 1].text;
+  if (text.empty() || next.empty() || !IsLeadingSurrogate(text.back()) ||
+      !IsTrailingSurrogate(next.front())) {
+    return false;
+  }
+  text.push_back(next.front());
+  next.erase(0, 1);
+  RefreshChunk(index);
+  if (next.empty()) {
+    chunks_.erase(chunks_.begin() + index + 1);
+  } else {
+    RefreshChunk(index + 1);
+  }
+  return true;
+}
+
+void TextRope::RebuildIndex() {
+  std::vector<size_t> lengths(chunks_.size());
+  std::vector<size_t> utf8_lengths(chunks_.size());
+  for (size_t i = 0; i < chunks_.size(); i++) {
+    lengths[i] = chunks_[i].text.length();
+    utf8_lengths[i] = chunks_[i].utf8_length;
+  }
+  utf16_index_.Reset(lengths);
+  utf8_index_.Reset(utf8_lengths);
+}
+
+TextRope::Chunk TextRope::MakeChunk(std::u16string text) {
+  Chunk chunk;
+  chunk.utf8_length = Utf8Length(text, text.length());
+  chunk.text = std::move(text);
+  return chunk;
+}
+
+}  // namespace flutter
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_CPP_TEXT_ROPE_H_
+#define FLUTTER_SHELL_PLATFORM_CPP_TEXT_ROPE_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace flutter {
+
+// A UTF-16 string stored as a sequence of chunks of bounded length.
+//
+// Edits only rewrite the chunks they touch, so typing into a large document
+// costs time proportional to the chunk length rather than to the length of
+// the document. The number of UTF-16 code units and of UTF-8 bytes before
+// each chunk are kept in Fenwick trees, which makes finding the chunk of an
+// offset and converting UTF-16 offsets to UTF-8 offsets O(log n). The UTF-8
+// encoding of every chunk is cached until the chunk changes.
+//
+// Surrogate pairs never straddle two chunks. Unpaired surrogates are encoded
+// as U+FFFD in UTF-8.
+class TextRope {
+ public:
+  // The length above which a chunk is split in two.
+  static constexpr size_t kMaxChunkLength = 1024;
+
+  TextRope();
+  explicit TextRope(const std::u16string& text);
+  ~TextRope();
+
+  TextRope(TextRope&&);
+  TextRope& operator=(TextRope&&);
+
+  // The length of the text in UTF-16 code units.
+  size_t length() const { return length_; }
+
+  bool empty() const { return length_ == 0; }
+
+  // Returns the UTF-16 code unit at |position|, which must be less than
+  // |length|.
+  char16_t at(size_t position) const;
+
+  // Replaces the |length| code units starting at |position| with |text|.
+  void Replace(size_t position, size_t length, const std::u16string& text);
+
+  void Insert(size_t position, const std::u16string& text) {
+    Replace(position, 0, text);
+  }
+
+  void Erase(size_t position, size_t length) {
+    Replace(position, length, std::u16string());
+  }
+
+  // Returns up to |length| code units starting at |position|.
+  std::u16string Substring(size_t position, size_t length) const;
+
+  std::u16string ToUtf16() const;
+
+  std::string ToUtf8() const;
+
+  // Returns the UTF-8 encoding of up to |length| code units starting at
+  // |position|, without encoding the rest of the text.
+  std::string Utf8Substring(size_t position, size_t length) const;
+
+  // Returns the UTF-8 encoding of |text|, with unpaired surrogates encoded as
+  // U+FFFD like the text of a rope.
+  static std::string ToUtf8(const std::u16string& text);
+
+  // Returns the length in bytes of the UTF-8 encoding of the first |position|
+  // code units of the text.
+  size_t Utf8Offset(size_t position) const;
+
+  size_t chunk_count() const { return chunks_.size(); }
+
+ private:
+  struct Chunk {
+    std::u16string text;
+    size_t utf8_length = 0;
+    // The UTF-8 encoding of |text|, or empty if it hasn't been computed since
+    // |text| last changed.
+    mutable std::string utf8;
+  };
+
+  // A Fenwick tree over the lengths of the chunks in one encoding.
+  class LengthIndex {
+   public:
+    void Reset(const std::vector<size_t>& lengths);
+
+    void Add(size_t chunk, int64_t delta);
+
+    // Returns the sum of the lengths of the first |count| chunks.
+    size_t Sum(size_t count) const;
+
+    // Returns the number of leading chunks whose lengths sum to less than
+    // |target|, which must not exceed the total length.
+    size_t CountBelow(size_t target) const;
+
+   private:
+    std::vector<size_t> tree_;
+  };
+
+  std::vector<Chunk> chunks_;
+  LengthIndex utf16_index_;
+  LengthIndex utf8_index_;
+  size_t length_ = 0;
+
+  // Returns the chunk that contains |position| and the offset of |position|
+  // in that chunk. Positions between two chunks belong to the first one.
+  std::pair<size_t, size_t> Locate(size_t position) const;
+
+  // Recomputes the UTF-8 length of the chunk after its text changed.
+  void RefreshChunk(size_t index);
+
+  // Splits the chunk into chunks no longer than half of |kMaxChunkLength| if
+  // it is longer than |kMaxChunkLength|. Returns the number of chunks added.
+  size_t SplitChunk(size_t index);
+
+  // Moves the trailing surrogate at the start of the chunk that follows
+  // |index| into it, if the chunk at |index| ends with a leading surrogate.
+  // Returns true if the chunks changed.
+  bool JoinSurrogatePair(size_t index);
+
+  void RebuildIndex();
+
+  static Chunk MakeChunk(std::u16string text);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_CPP_TEXT_ROPE_H_
@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/cpp/text_rope.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+TEST(TextRope, Empty) {
+  TextRope rope;
+  EXPECT_TRUE(rope.empty());
+  EXPECT_EQ(rope.length(), 0u);
+  EXPECT_EQ(rope.ToUtf16(), u"");
+  EXPECT_EQ(rope.ToUtf8(), "");
+  EXPECT_EQ(rope.Utf8Offset(0), 0u);
+}
+
+TEST(TextRope, Replace) {
+  TextRope rope(u"ABCDE");
+  rope.Replace(1, 3, u"xy");
+  EXPECT_EQ(rope.ToUtf16(), u"AxyE");
+  rope.Insert(4, u"FG");
+  EXPECT_EQ(rope.ToUtf16(), u"AxyEFG");
+  rope.Erase(0, 2);
+  EXPECT_EQ(rope.ToUtf16(), u"yEFG");
+  EXPECT_EQ(rope.length(), 4u);
+  EXPECT_EQ(rope.at(1), u'E');
+  EXPECT_EQ(rope.Substring(1, 2), u"EF");
+  EXPECT_EQ(rope.Substring(3, 10), u"G");
+}
+
+TEST(TextRope, Utf8) {
+  // These characters take 1, 2, 3 and 4 bytes in UTF-8.
+  TextRope rope(u"$¢€𐍈");
+  EXPECT_EQ(rope.ToUtf8(), "$¢€𐍈");
+  EXPECT_EQ(rope.Utf8Offset(1), 1u);
+  EXPECT_EQ(rope.Utf8Offset(2), 3u);
+  EXPECT_EQ(rope.Utf8Offset(3), 6u);
+  EXPECT_EQ(rope.Utf8Offset(5), 10u);
+}
+
+TEST(TextRope, Utf8Substring) {
+  std::u16string text;
+  while (text.length() < TextRope::kMaxChunkLength * 3) {
+    text.append(u"$¢€𐍈");
+  }
+  TextRope rope(text);
+  ASSERT_GT(rope.chunk_count(), 1u);
+  EXPECT_EQ(rope.Utf8Substring(1, 4), "¢€𐍈");
+  EXPECT_EQ(rope.Utf8Substring(0, text.length()), rope.ToUtf8());
+  EXPECT_EQ(rope.Utf8Substring(text.length() - 2, 10), "𐍈");
+  EXPECT_EQ(rope.Utf8Substring(text.length(), 10), "");
+  EXPECT_EQ(TextRope::ToUtf8(u"$¢€𐍈"), "$¢€𐍈");
+  EXPECT_EQ(TextRope::ToUtf8(std::u16string({0xDC00, u'A'})), "�A");
+}
+
+TEST(TextRope, UnpairedSurrogatesAreReplaced) {
+  TextRope rope(std::u16string({u'A', 0xD800, u'B'}));
+  EXPECT_EQ(rope.ToUtf8(), "A�B");
+  EXPECT_EQ(rope.Utf8Offset(3), 5u);
+}
+
+TEST(TextRope, LongTextIsChunked) {
+  std::u16string text(TextRope::kMaxChunkLength * 10, u'a');
+  TextRope rope(text);
+  EXPECT_GT(rope.chunk_count(), 10u);
+  EXPECT_EQ(rope.ToUtf16(), text);
+
+  // Replacing text across chunks joins them.
+  rope.Replace(100, text.length() - 200, u"b");
+  EXPECT_EQ(rope.length(), 201u);
+  EXPECT_EQ(rope.chunk_count(), 1u);
+  EXPECT_EQ(rope.at(100), u'b');
+}
+
+TEST(TextRope, SurrogatePairsAreNotSplit) {
+  std::u16string text;
+  while (text.length() < TextRope::kMaxChunkLength * 4) {
+    text.append(u"a𐍈");
+  }
+  TextRope rope(text);
+  ASSERT_GT(rope.chunk_count(), 1u);
+  for (size_t i = 0; i <= text.length(); i++) {
+    size_t expected = (i / 3) * 5 + (i % 3 == 0 ? 0 : 1);
+    // An offset inside a pair counts the leading surrogate as U+FFFD.
+    if (i % 3 == 2) {
+      expected += 3;
+    }
+    ASSERT_EQ(rope.Utf8Offset(i), expected) << "at " << i;
+  }
+}
+
+// Checks random edits against std::u16string.
+TEST(TextRope, RandomEdits) {
+  const char16_t kCodeUnits[] = {u'a', u'z', 0xE9, 0x4E2D, 0xD83D, 0xDE00};
+  std::mt19937 random(42);
+  std::u16string expected;
+  TextRope rope;
+  for (int i = 0; i < 2000; i++) {
+    size_t position = random() % (expected.length() + 1);
+    size_t length = random() % (expected.length() - position + 1);
+    if (random() % 2) {
+      length = std::min<size_t>(length, 8);
+    }
+    std::u16string text(random() % (i % 10 == 0 ? 3000 : 16), u' ');
+    for (char16_t& code_unit : text) {
+      code_unit = kCodeUnits[random() % std::size(kCodeUnits)];
+    }
+
+    expected.replace(position, length, text);
+    rope.Replace(position, length, text);
+
+    ASSERT_EQ(rope.length(), expected.length());
+    ASSERT_EQ(rope.ToUtf16(), expected);
+    size_t offset = random() % (expected.length() + 1);
+    ASSERT_EQ(rope.Utf8Offset(offset),
+              TextRope(expected.substr(0, offset)).ToUtf8().length());
+  }
+}
+
+}  // namespace flutter
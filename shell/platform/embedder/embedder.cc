@@ -640,6 +640,10 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
       SAFE_ACCESS(compositor, present_layers_callback, nullptr);
   bool avoid_backing_store_cache =
       SAFE_ACCESS(compositor, avoid_backing_store_cache, false);
+  bool use_tight_backing_stores =
+      SAFE_ACCESS(compositor, use_tight_backing_stores, false);
+  bool reuse_unchanged_backing_stores =
+      SAFE_ACCESS(compositor, reuse_unchanged_backing_stores, false);
 
   // Make sure the required callbacks are present
   if (!c_create_callback || !c_collect_callback || !c_present_callback) {
@@ -666,7 +670,8 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
       };
 
   return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
-              avoid_backing_store_cache, create_render_target_callback,
+              avoid_backing_store_cache, use_tight_backing_stores,
+              reuse_unchanged_backing_stores, create_render_target_callback,
               present_callback),
           false};
 }
@@ -918,6 +923,11 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   settings.assets_path = args->assets_path;
   settings.leak_vm = !SAFE_ACCESS(args, shutdown_dart_vm_when_done, false);
   settings.old_gen_heap_size = SAFE_ACCESS(args, dart_old_gen_heap_size, -1);
+  if (auto custom_task_runners =
+          SAFE_ACCESS(args, custom_task_runners, nullptr)) {
+    settings.worker_cpu_affinity_mask =
+        SAFE_ACCESS(custom_task_runners, worker_cpu_affinity_mask, 0);
+  }
 
   if (!flutter::DartVM::IsRunningPrecompiledCode()) {
     // Verify the assets path contains Dart 2 kernel assets.
@@ -796,6 +796,25 @@ typedef struct {
   size_t identifier;
 } FlutterTaskRunnerDescription;
 
+/// How a thread created by the engine is scheduled. Settings that the platform
+/// does not support, or that the process is not permitted to apply, are
+/// ignored.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterThreadConfig).
+  size_t struct_size;
+  /// The nice value of the thread, from -20 to 19. Zero leaves the nice value
+  /// of the thread as is.
+  int32_t nice;
+  /// The SCHED_FIFO priority of the thread, from 1 to 99. Zero leaves the
+  /// scheduling policy of the thread as is.
+  int32_t realtime_priority;
+  /// The CPUs the thread may run on, one bit per CPU. Zero allows all CPUs.
+  uint64_t cpu_affinity_mask;
+  /// The size of the stack of the thread in bytes. Zero picks the default of
+  /// the platform.
+  size_t stack_size;
+} FlutterThreadConfig;
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterCustomTaskRunners).
   size_t struct_size;
@@ -809,6 +828,17 @@ typedef struct {
   /// and platform task runners. This makes the Flutter engine use the same
   /// thread for both task runners.
   const FlutterTaskRunnerDescription* render_task_runner;
+  /// How the UI thread is scheduled. May be null for the defaults.
+  const FlutterThreadConfig* ui_thread_config;
+  /// How the raster thread is scheduled if the engine creates it, i.e. if no
+  /// `render_task_runner` is specified. May be null for the defaults.
+  const FlutterThreadConfig* raster_thread_config;
+  /// How the IO thread is scheduled. May be null for the defaults.
+  const FlutterThreadConfig* io_thread_config;
+  /// The CPUs that the background worker threads of the engine may run on,
+  /// one bit per CPU. Use this to keep them off the cores of the UI and
+  /// raster threads. Zero allows all CPUs.
+  uint64_t worker_cpu_affinity_mask;
 } FlutterCustomTaskRunners;
 
 typedef struct {
@@ -993,6 +1023,18 @@ typedef struct {
   FlutterLayersPresentCallback present_layers_callback;
   /// Avoid caching backing stores provided by this compositor.
   bool avoid_backing_store_cache;
+  /// Size the backing stores of the layers above platform views to the bounds
+  /// of their contents instead of the whole frame. The sizes are rounded up so
+  /// that backing stores can still be reused across frames. Embedders that set
+  /// this must place backing store layers at their `FlutterLayer::offset`.
+  bool use_tight_backing_stores;
+  /// Skip rendering into a backing store recycled from the previous frame when
+  /// its contents would not change, and present it with
+  /// `FlutterBackingStore::did_update` unset. Embedders that set this must
+  /// keep the contents of their backing stores intact between presents.
+  /// Comparing contents has a cost on the raster thread every frame, so this
+  /// has no effect when `avoid_backing_store_cache` is set.
+  bool reuse_unchanged_backing_stores;
 } FlutterCompositor;
 
 typedef struct {
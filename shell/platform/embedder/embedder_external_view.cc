@@ -3,8 +3,15 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
+
+#include <algorithm>
+
+#include "flutter/flow/picture_fingerprint.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/common/canvas_spy.h"
+#include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
+#include "third_party/skia/include/core/SkBBHFactory.h"
+#include "third_party/skia/include/core/SkStream.h"
 
 namespace flutter {
 
@@ -20,26 +27,36 @@ EmbedderExternalView::EmbedderExternalView(
     const SkMatrix& surface_transformation)
     : EmbedderExternalView(frame_size, surface_transformation, {}, nullptr) {}
 
+// Recording into a bounding box hierarchy makes the recorded picture's cull
+// rect the bounds of what was drawn instead of the whole frame.
+static SkBBHFactory* GetBBHFactory(bool use_tight_bounds) {
+  static SkRTreeFactory rtree_factory;
+  return use_tight_bounds ? &rtree_factory : nullptr;
+}
+
 EmbedderExternalView::EmbedderExternalView(
     const SkISize& frame_size,
     const SkMatrix& surface_transformation,
     ViewIdentifier view_identifier,
-    std::unique_ptr<EmbeddedViewParams> params)
-    : render_surface_size_(
+    std::unique_ptr<EmbeddedViewParams> params,
+    bool use_tight_bounds)
+    : frame_surface_size_(
           TransformedSurfaceSize(frame_size, surface_transformation)),
       surface_transformation_(surface_transformation),
+      use_tight_bounds_(use_tight_bounds),
+      render_surface_bounds_(SkIRect::MakeSize(frame_surface_size_)),
       view_identifier_(view_identifier),
       embedded_view_params_(std::move(params)),
       recorder_(std::make_unique<SkPictureRecorder>()),
-      canvas_spy_(std::make_unique<CanvasSpy>(
-          recorder_->beginRecording(frame_size.width(), frame_size.height()))) {
-}
+      canvas_spy_(std::make_unique<CanvasSpy>(recorder_->beginRecording(
+          SkRect::MakeIWH(frame_size.width(), frame_size.height()),
+          GetBBHFactory(use_tight_bounds)))) {}
 
 EmbedderExternalView::~EmbedderExternalView() = default;
 
 EmbedderExternalView::RenderTargetDescriptor
 EmbedderExternalView::CreateRenderTargetDescriptor() const {
-  return {view_identifier_, render_surface_size_};
+  return {view_identifier_, render_surface_bounds_.size()};
 }
 
 SkCanvas* EmbedderExternalView::GetCanvas() const {
@@ -47,7 +64,60 @@ SkCanvas* EmbedderExternalView::GetCanvas() const {
 }
 
 SkISize EmbedderExternalView::GetRenderSurfaceSize() const {
-  return render_surface_size_;
+  return render_surface_bounds_.size();
+}
+
+SkIRect EmbedderExternalView::GetRenderSurfaceBounds() const {
+  return render_surface_bounds_;
+}
+
+void EmbedderExternalView::FinishRecording() {
+  if (picture_) {
+    return;
+  }
+
+  picture_ = recorder_->finishRecordingAsPicture();
+  if (!picture_ || !use_tight_bounds_) {
+    return;
+  }
+
+  const auto frame_bounds = SkIRect::MakeSize(frame_surface_size_);
+  auto content_bounds =
+      surface_transformation_.mapRect(picture_->cullRect()).roundOut();
+  if (!content_bounds.intersect(frame_bounds)) {
+    render_surface_bounds_.setEmpty();
+    return;
+  }
+
+  // Render surfaces are pooled by size class. Grow the bounds to the size of
+  // their class, moving them back into the frame where they would overhang.
+  const auto size = EmbedderRenderTargetCache::GetSizeClass(
+      content_bounds.size(), frame_surface_size_);
+  const auto left =
+      std::min(content_bounds.left(), frame_bounds.right() - size.width());
+  const auto top =
+      std::min(content_bounds.top(), frame_bounds.bottom() - size.height());
+  render_surface_bounds_ =
+      SkIRect::MakeXYWH(left, top, size.width(), size.height());
+}
+
+sk_sp<SkData> EmbedderExternalView::CreateContentsFingerprint() const {
+  if (!picture_) {
+    return nullptr;
+  }
+
+  TRACE_EVENT0("flutter", "EmbedderExternalView::CreateContentsFingerprint");
+
+  const SkSerialProcs procs = MakePictureFingerprintSerialProcs();
+
+  SkScalar transformation[9];
+  surface_transformation_.get9(transformation);
+
+  SkDynamicMemoryWStream stream;
+  stream.write(transformation, sizeof(transformation));
+  stream.write(&render_surface_bounds_, sizeof(render_surface_bounds_));
+  picture_->serialize(&stream, &procs);
+  return stream.detachAsData();
 }
 
 bool EmbedderExternalView::IsRootView() const {
@@ -59,7 +129,7 @@ bool EmbedderExternalView::HasPlatformView() const {
 }
 
 bool EmbedderExternalView::HasEngineRenderedContents() const {
-  return canvas_spy_->DidDrawIntoCanvas();
+  return canvas_spy_->DidDrawIntoCanvas() && !render_surface_bounds_.isEmpty();
 }
 
 EmbedderExternalView::ViewIdentifier EmbedderExternalView::GetViewIdentifier()
@@ -78,8 +148,8 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
       << "Unnecessarily asked to render into a render target when there was "
          "nothing to render.";
 
-  auto picture = recorder_->finishRecordingAsPicture();
-  if (!picture) {
+  FinishRecording();
+  if (!picture_) {
     return false;
   }
 
@@ -89,16 +159,19 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
   }
 
   FML_DCHECK(SkISize::Make(surface->width(), surface->height()) ==
-             render_surface_size_);
+             render_surface_bounds_.size());
 
   auto canvas = surface->getCanvas();
   if (!canvas) {
     return false;
   }
 
-  canvas->setMatrix(surface_transformation_);
+  auto transformation = surface_transformation_;
+  transformation.postTranslate(-render_surface_bounds_.left(),
+                               -render_surface_bounds_.top());
+  canvas->setMatrix(transformation);
   canvas->clear(SK_ColorTRANSPARENT);
-  canvas->drawPicture(picture);
+  canvas->drawPicture(picture_);
   canvas->flush();
 
   return true;
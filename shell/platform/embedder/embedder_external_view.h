@@ -88,7 +88,8 @@ class EmbedderExternalView {
   EmbedderExternalView(const SkISize& frame_size,
                        const SkMatrix& surface_transformation,
                        ViewIdentifier view_identifier,
-                       std::unique_ptr<EmbeddedViewParams> params);
+                       std::unique_ptr<EmbeddedViewParams> params,
+                       bool use_tight_bounds = false);
 
   ~EmbedderExternalView();
 
@@ -108,15 +109,45 @@ class EmbedderExternalView {
 
   SkISize GetRenderSurfaceSize() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The bounds of the render surface within the frame, post
+  ///             transformation. These cover the whole frame unless the view
+  ///             uses tight bounds.
+  ///
+  SkIRect GetRenderSurfaceBounds() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops recording into the canvas of this view. Views that use
+  ///             tight bounds only know the size of their render surface
+  ///             after this call, so it must be made before asking for a
+  ///             render target.
+  ///
+  void FinishRecording();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a fingerprint of what this view would render into its
+  ///             render target. Views whose fingerprints are equal render the
+  ///             same pixels. Pictures and images drawn by the view are only
+  ///             identified by their unique IDs, so this is much cheaper than
+  ///             rendering.
+  ///
+  /// @return     The fingerprint, or null if the view has not finished
+  ///             recording.
+  ///
+  sk_sp<SkData> CreateContentsFingerprint() const;
+
   bool Render(const EmbedderRenderTarget& render_target);
 
  private:
-  const SkISize render_surface_size_;
+  const SkISize frame_surface_size_;
   const SkMatrix surface_transformation_;
+  const bool use_tight_bounds_;
+  SkIRect render_surface_bounds_;
   ViewIdentifier view_identifier_;
   std::unique_ptr<EmbeddedViewParams> embedded_view_params_;
   std::unique_ptr<SkPictureRecorder> recorder_;
   std::unique_ptr<CanvasSpy> canvas_spy_;
+  sk_sp<SkPicture> picture_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalView);
 };
@@ -14,9 +14,14 @@ namespace flutter {
 
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     bool avoid_backing_store_cache,
+    bool use_tight_backing_stores,
+    bool reuse_unchanged_backing_stores,
     const CreateRenderTargetCallback& create_render_target_callback,
     const PresentCallback& present_callback)
     : avoid_backing_store_cache_(avoid_backing_store_cache),
+      use_tight_backing_stores_(use_tight_backing_stores),
+      reuse_unchanged_backing_stores_(reuse_unchanged_backing_stores &&
+                                      !avoid_backing_store_cache),
       create_render_target_callback_(create_render_target_callback),
       present_callback_(present_callback) {
   FML_DCHECK(create_render_target_callback_);
@@ -78,7 +83,8 @@ void EmbedderExternalViewEmbedder::PrerollCompositeEmbeddedView(
       pending_frame_size_,              // frame size
       pending_surface_transformation_,  // surface xformation
       view_id,                          // view identifier
-      std::move(params)                 // embedded view params
+      std::move(params),                // embedded view params
+      use_tight_backing_stores_         // use tight bounds
   );
   composition_order_.push_back(view_id);
 }
@@ -137,6 +143,12 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
     GrDirectContext* context,
     std::unique_ptr<SurfaceFrame> frame,
     const std::shared_ptr<fml::SyncSwitch>& gpu_disable_sync_switch) {
+  // The size of the render targets of views with tight bounds is only known
+  // once they are done recording.
+  for (const auto& view : pending_views_) {
+    view.second->FinishRecording();
+  }
+
   auto [matched_render_targets, pending_keys] =
       render_target_cache_.GetExistingTargetsInCache(pending_views_);
 
@@ -167,11 +179,9 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
     }
 
     // This is the size of render surface we want the embedder to create for
-    // us. As or right now, this is going to always be equal to the frame size
-    // post transformation. But, in case optimizations are applied that make
-    // it so that embedder rendered into surfaces that aren't full screen,
-    // this assumption will break. So it's just best to ask view for its size
-    // directly.
+    // us. This is the frame size post transformation, unless the view uses
+    // tight bounds, in which case it is the size class of the bounds of its
+    // contents. So it's just best to ask view for its size directly.
     const auto render_surface_size = external_view->GetRenderSurfaceSize();
 
     const auto backing_store_config =
@@ -203,12 +213,29 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   // Scribble embedder provide render targets. The order in which we scribble
   // into the buffers is irrelevant to the presentation order.
   for (const auto& render_target : matched_render_targets) {
-    if (!pending_views_.at(render_target.first)
-             ->Render(*render_target.second)) {
+    const auto& external_view = pending_views_.at(render_target.first);
+
+    // A render target recycled from the last frame still holds what its view
+    // rendered then. If the embedder keeps backing store contents between
+    // presents and the view would render the same contents again, reuse them
+    // as-is and let the embedder know it need not update its copy.
+    sk_sp<SkData> fingerprint;
+    if (reuse_unchanged_backing_stores_) {
+      fingerprint = external_view->CreateContentsFingerprint();
+      if (fingerprint &&
+          fingerprint->equals(
+              render_target.second->GetContentsFingerprint().get())) {
+        render_target.second->MarkContentsUnchanged();
+        continue;
+      }
+    }
+
+    if (!external_view->Render(*render_target.second)) {
       FML_LOG(ERROR)
           << "Could not render into the embedder supplied render target.";
       return;
     }
+    render_target.second->SetContentsFingerprint(std::move(fingerprint));
   }
 
   // We are going to be transferring control back over to the embedder there the
@@ -246,8 +273,14 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
       // platform view.
       if (external_view->HasEngineRenderedContents()) {
         const auto& exteral_render_target = matched_render_targets.at(view_id);
-        presented_layers.PushBackingStoreLayer(
-            exteral_render_target->GetBackingStore());
+        if (use_tight_backing_stores_ && !external_view->IsRootView()) {
+          presented_layers.PushBackingStoreLayer(
+              exteral_render_target->GetBackingStore(),
+              external_view->GetRenderSurfaceBounds());
+        } else {
+          presented_layers.PushBackingStoreLayer(
+              exteral_render_target->GetBackingStore());
+        }
       }
     }
 
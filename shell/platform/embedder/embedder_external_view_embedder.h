@@ -44,6 +44,15 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                      will beinvoked every frame for every
   ///                                      engine composited layer. The result
   ///                                      will not cached.
+  /// @param[in] use_tight_backing_stores  If set, the render targets of the
+  ///                                      views above platform views are
+  ///                                      sized to the bounds of their
+  ///                                      contents instead of the frame.
+  /// @param[in] reuse_unchanged_backing_stores
+  ///                                      If set, render targets recycled
+  ///                                      from the last frame are not
+  ///                                      rendered into again when their
+  ///                                      contents would not change.
   ///
   /// @param[in]  create_render_target_callback
   ///                                     The render target callback used to
@@ -55,6 +64,8 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///
   EmbedderExternalViewEmbedder(
       bool avoid_backing_store_cache,
+      bool use_tight_backing_stores,
+      bool reuse_unchanged_backing_stores,
       const CreateRenderTargetCallback& create_render_target_callback,
       const PresentCallback& present_callback);
 
@@ -107,6 +118,8 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
 
  private:
   const bool avoid_backing_store_cache_;
+  const bool use_tight_backing_stores_;
+  const bool reuse_unchanged_backing_stores_;
   const CreateRenderTargetCallback create_render_target_callback_;
   const PresentCallback present_callback_;
   SurfaceTransformationCallback surface_transformation_callback_;
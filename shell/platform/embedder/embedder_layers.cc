@@ -38,6 +38,22 @@ void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store) {
   presented_layers_.push_back(layer);
 }
 
+void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store,
+                                           const SkIRect& bounds) {
+  FlutterLayer layer = {};
+
+  layer.struct_size = sizeof(FlutterLayer);
+  layer.type = kFlutterLayerContentTypeBackingStore;
+  layer.backing_store = store;
+
+  layer.offset.x = bounds.x();
+  layer.offset.y = bounds.y();
+  layer.size.width = bounds.width();
+  layer.size.height = bounds.height();
+
+  presented_layers_.push_back(layer);
+}
+
 static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
     double opacity) {
   FlutterPlatformViewMutation mutation = {};
@@ -12,6 +12,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flutter {
@@ -26,6 +27,11 @@ class EmbedderLayers {
 
   void PushBackingStoreLayer(const FlutterBackingStore* store);
 
+  // Pushes a backing store that only covers |bounds|, which are post root
+  // surface transformation.
+  void PushBackingStoreLayer(const FlutterBackingStore* store,
+                             const SkIRect& bounds);
+
   void PushPlatformViewLayer(FlutterPlatformViewIdentifier identifier,
                              const EmbeddedViewParams& params);
 
@@ -14,8 +14,6 @@ EmbedderRenderTarget::EmbedderRenderTarget(FlutterBackingStore backing_store,
     : backing_store_(backing_store),
       render_surface_(std::move(render_surface)),
       on_release_(on_release) {
-  // TODO(38468): The optimization to elide backing store updates between frames
-  // has not been implemented yet.
   backing_store_.did_update = true;
   FML_DCHECK(render_surface_);
 }
@@ -34,4 +32,17 @@ sk_sp<SkSurface> EmbedderRenderTarget::GetRenderSurface() const {
   return render_surface_;
 }
 
+const sk_sp<SkData>& EmbedderRenderTarget::GetContentsFingerprint() const {
+  return contents_fingerprint_;
+}
+
+void EmbedderRenderTarget::SetContentsFingerprint(sk_sp<SkData> fingerprint) {
+  contents_fingerprint_ = std::move(fingerprint);
+  backing_store_.did_update = true;
+}
+
+void EmbedderRenderTarget::MarkContentsUnchanged() {
+  backing_store_.did_update = false;
+}
+
 }  // namespace flutter
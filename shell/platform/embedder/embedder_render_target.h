@@ -9,6 +9,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
@@ -65,8 +66,32 @@ class EmbedderRenderTarget {
   ///
   const FlutterBackingStore* GetBackingStore() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The fingerprint of the contents last rendered into this
+  ///             render target. See
+  ///             `EmbedderExternalView::CreateContentsFingerprint`.
+  ///
+  /// @return     The fingerprint, or null if nothing was rendered yet.
+  ///
+  const sk_sp<SkData>& GetContentsFingerprint() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Notes that the contents with the given fingerprint were just
+  ///             rendered into this render target, so that the embedder is
+  ///             told that the backing store was updated.
+  ///
+  void SetContentsFingerprint(sk_sp<SkData> fingerprint);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Notes that the contents of this render target were reused
+  ///             as-is, so that the embedder is told that the backing store
+  ///             was not updated since it was last presented.
+  ///
+  void MarkContentsUnchanged();
+
  private:
   FlutterBackingStore backing_store_;
+  sk_sp<SkData> contents_fingerprint_;
   sk_sp<SkSurface> render_surface_;
   fml::closure on_release_;
 
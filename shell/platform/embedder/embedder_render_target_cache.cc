@@ -4,8 +4,13 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+
 namespace flutter {
 
+// The granularity, in pixels, of the size classes of render targets.
+static constexpr int32_t kSizeClassGranularity = 64;
+
 EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
@@ -70,4 +75,15 @@ size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
   return count;
 }
 
+SkISize EmbedderRenderTargetCache::GetSizeClass(const SkISize& size,
+                                               const SkISize& max_size) {
+  auto round_up = [](int32_t value, int32_t max_value) {
+    const int32_t rounded = (value + kSizeClassGranularity - 1) /
+                            kSizeClassGranularity * kSizeClassGranularity;
+    return std::min(rounded, max_value);
+  };
+  return SkISize::Make(round_up(size.width(), max_size.width()),
+                       round_up(size.height(), max_size.height()));
+}
+
 }  // namespace flutter
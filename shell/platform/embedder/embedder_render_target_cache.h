@@ -43,6 +43,14 @@ class EmbedderRenderTargetCache {
 
   size_t GetCachedTargetsCount() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Rounds the size of a render target up to its size class so
+  ///             that targets whose contents change size slightly from frame
+  ///             to frame can still be reused. The result never exceeds
+  ///             |max_size|.
+  ///
+  static SkISize GetSizeClass(const SkISize& size, const SkISize& max_size);
+
  private:
   using CachedRenderTargets =
       std::unordered_map<EmbedderExternalView::RenderTargetDescriptor,
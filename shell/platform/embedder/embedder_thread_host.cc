@@ -103,6 +103,23 @@ EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
   return nullptr;
 }
 
+static fml::Thread::ThreadConfig GetThreadConfig(
+    const FlutterThreadConfig* config) {
+  fml::Thread::ThreadConfig thread_config;
+  if (config == nullptr) {
+    return thread_config;
+  }
+  if (int32_t nice = SAFE_ACCESS(config, nice, 0)) {
+    thread_config.nice = nice;
+  }
+  if (int32_t priority = SAFE_ACCESS(config, realtime_priority, 0)) {
+    thread_config.realtime_priority = priority;
+  }
+  thread_config.cpu_affinity_mask = SAFE_ACCESS(config, cpu_affinity_mask, 0);
+  thread_config.stack_size = SAFE_ACCESS(config, stack_size, 0);
+  return thread_config;
+}
+
 static fml::RefPtr<fml::TaskRunner> GetCurrentThreadTaskRunner() {
   fml::MessageLoop::EnsureInitializedForCurrentThread();
   return fml::MessageLoop::GetCurrent().GetTaskRunner();
@@ -154,7 +171,15 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
 
   // Create a thread host with just the threads that need to be managed by the
   // engine. The embedder has provided the rest.
-  ThreadHost thread_host(kFlutterThreadName, engine_thread_host_mask);
+  ThreadHost::ThreadConfigs thread_configs;
+  thread_configs.ui = GetThreadConfig(
+      SAFE_ACCESS(custom_task_runners, ui_thread_config, nullptr));
+  thread_configs.raster = GetThreadConfig(
+      SAFE_ACCESS(custom_task_runners, raster_thread_config, nullptr));
+  thread_configs.io = GetThreadConfig(
+      SAFE_ACCESS(custom_task_runners, io_thread_config, nullptr));
+  ThreadHost thread_host(kFlutterThreadName, engine_thread_host_mask,
+                         thread_configs);
 
   // If the embedder has supplied a platform task runner, use that. If not, use
   // the current thread task runner.
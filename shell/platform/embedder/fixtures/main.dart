@@ -645,6 +645,27 @@ void push_frames_over_and_over() {
 }
 
 
+@pragma('vm:entry-point')
+void push_static_overlay_frames_over_and_over() {
+  // The pictures are reused in every frame, so nothing but the platform view
+  // changes from one frame to the next.
+  final Picture background = CreateColoredBox(Color.fromARGB(255, 128, 128, 128), Size(1024.0, 600.0));
+  final Picture overlay = CreateColoredBox(Color.fromARGB(255, 0, 0, 255), Size(50.0, 50.0));
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    SceneBuilder builder = SceneBuilder();
+    builder.pushOffset(0.0, 0.0);
+    builder.addPicture(Offset(0.0, 0.0), background);
+    builder.addPlatformView(42, width: 1024.0, height: 540.0);
+    builder.addPicture(Offset(10.0, 10.0), overlay);
+    builder.pop();
+    PlatformDispatcher.instance.views.first.render(builder.build());
+    signalNativeTest();
+    PlatformDispatcher.instance.scheduleFrame();
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
+
 @pragma('vm:entry-point')
 void platform_view_mutators() {
   PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
@@ -265,7 +265,10 @@ void EmbedderConfigBuilder::SetPlatformMessageCallback(
   context_.SetPlatformMessageCallback(callback);
 }
 
-void EmbedderConfigBuilder::SetCompositor(bool avoid_backing_store_cache) {
+void EmbedderConfigBuilder::SetCompositor(
+    bool avoid_backing_store_cache,
+    bool use_tight_backing_stores,
+    bool reuse_unchanged_backing_stores) {
   context_.SetupCompositor();
   auto& compositor = context_.GetCompositor();
   compositor_.struct_size = sizeof(compositor_);
@@ -296,6 +299,8 @@ void EmbedderConfigBuilder::SetCompositor(bool avoid_backing_store_cache) {
     );
   };
   compositor_.avoid_backing_store_cache = avoid_backing_store_cache;
+  compositor_.use_tight_backing_stores = use_tight_backing_stores;
+  compositor_.reuse_unchanged_backing_stores = reuse_unchanged_backing_stores;
   project_args_.compositor = &compositor_;
 }
 
@@ -87,7 +87,9 @@ class EmbedderConfigBuilder {
   void SetPlatformMessageCallback(
       const std::function<void(const FlutterPlatformMessage*)>& callback);
 
-  void SetCompositor(bool avoid_backing_store_cache = false);
+  void SetCompositor(bool avoid_backing_store_cache = false,
+                     bool use_tight_backing_stores = false,
+                     bool reuse_unchanged_backing_stores = false);
 
   FlutterCompositor& GetCompositor();
 
@@ -50,7 +50,9 @@ bool EmbedderTestCompositorSoftware::UpdateOffscrenComposition(
         layer_image =
             reinterpret_cast<SkSurface*>(layer->backing_store->user_data)
                 ->makeImageSnapshot();
-
+        // Backing stores only cover the whole frame unless the engine was
+        // asked to use tight backing stores.
+        canvas_offset = SkIPoint::Make(layer->offset.x, layer->offset.y);
         break;
       case kFlutterLayerContentTypePlatformView:
         layer_image = platform_view_renderer_callback_
@@ -71,8 +73,8 @@ bool EmbedderTestCompositorSoftware::UpdateOffscrenComposition(
     // The test could have just specified no contents to be rendered in place of
     // a platform view. This is not an error.
     if (layer_image) {
-      // The image rendered by Flutter already has the correct offset and
-      // transformation applied. The layers offset is meant for the platform.
+      // The image rendered by Flutter already has the correct transformation
+      // applied.
       canvas->drawImage(layer_image.get(), canvas_offset.x(),
                         canvas_offset.y());
     }
@@ -961,6 +961,244 @@ TEST_F(EmbedderTest, VerifyB143464703WithSoftwareBackend) {
       ImageMatchesFixture("verifyb143464703_soft_noxform.png", rendered_scene));
 }
 
+TEST_F(EmbedderTest, CanUseTightBackingStoresWithSoftwareBackend) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig(SkISize::Make(1024, 600));
+  builder.SetCompositor(/*avoid_backing_store_cache=*/false,
+                        /*use_tight_backing_stores=*/true);
+  builder.SetDartEntrypoint("verify_b143464703");
+
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kSoftwareBuffer);
+
+  // The bytes of the backing stores the embedder allocated and composited in
+  // the frame, and what they would have been with full frame backing stores.
+  size_t backing_store_bytes = 0;
+  size_t full_frame_backing_store_bytes = 0;
+
+  fml::CountDownLatch latch(1);
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 3u);
+
+        for (size_t i = 0; i < layers_count; ++i) {
+          if (layers[i]->type != kFlutterLayerContentTypeBackingStore) {
+            continue;
+          }
+          backing_store_bytes +=
+              layers[i]->backing_store->software.row_bytes *
+              layers[i]->backing_store->software.height;
+          full_frame_backing_store_bytes += 1024 * 600 * 4;
+        }
+
+        // Layer 0 (Root) always covers the whole frame.
+        {
+          FlutterBackingStore backing_store = *layers[0]->backing_store;
+          backing_store.type = kFlutterBackingStoreTypeSoftware;
+          backing_store.did_update = true;
+
+          FlutterLayer layer = {};
+          layer.struct_size = sizeof(layer);
+          layer.type = kFlutterLayerContentTypeBackingStore;
+          layer.backing_store = &backing_store;
+          layer.size = FlutterSizeMake(1024.0, 600.0);
+          layer.offset = FlutterPointMake(0.0, 0.0);
+
+          ASSERT_EQ(*layers[0], layer);
+        }
+
+        ASSERT_EQ(layers[1]->type, kFlutterLayerContentTypePlatformView);
+
+        // Layer 2 only covers the top bar at (135, 0, 1024, 60), rounded up to
+        // its size class and moved back into the frame.
+        {
+          FlutterBackingStore backing_store = *layers[2]->backing_store;
+          backing_store.type = kFlutterBackingStoreTypeSoftware;
+          backing_store.did_update = true;
+
+          FlutterLayer layer = {};
+          layer.struct_size = sizeof(layer);
+          layer.type = kFlutterLayerContentTypeBackingStore;
+          layer.backing_store = &backing_store;
+          layer.size = FlutterSizeMake(896.0, 64.0);
+          layer.offset = FlutterPointMake(128.0, 0.0);
+
+          ASSERT_EQ(*layers[2], layer);
+        }
+
+        latch.CountDown();
+      });
+
+  context.GetCompositor().SetPlatformViewRendererCallback(
+      [](const FlutterLayer& layer,
+         GrDirectContext* context) -> sk_sp<SkImage> {
+        auto surface = CreateRenderSurface(
+            layer, nullptr /* null because software compositor */);
+        auto canvas = surface->getCanvas();
+        FML_CHECK(canvas != nullptr);
+
+        SkPaint paint;
+        paint.setColor(SK_ColorGREEN);
+        paint.setAlpha(127);
+        canvas->drawRect(SkRect::MakeWH(layer.size.width, layer.size.height),
+                         paint);
+
+        return surface->makeImageSnapshot();
+      });
+
+  auto engine = builder.LaunchEngine();
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 1024;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+
+  auto rendered_scene = context.GetNextSceneImage();
+
+  latch.Wait();
+
+  ASSERT_EQ(full_frame_backing_store_bytes, 2u * 1024u * 600u * 4u);
+  ASSERT_EQ(backing_store_bytes, (1024u * 600u + 896u * 64u) * 4u);
+
+  // The composition must be the same as with full frame backing stores.
+#if !defined(OS_LINUX)
+  GTEST_SKIP() << "Skipping golden tests on non-Linux OSes";
+#endif  // OS_LINUX
+  ASSERT_TRUE(
+      ImageMatchesFixture("verifyb143464703_soft_noxform.png", rendered_scene));
+}
+
+TEST_F(EmbedderTest, UnchangedBackingStoresAreNotRenderedAgain) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig(SkISize::Make(1024, 600));
+  builder.SetCompositor(/*avoid_backing_store_cache=*/false,
+                        /*use_tight_backing_stores=*/false,
+                        /*reuse_unchanged_backing_stores=*/true);
+  builder.SetDartEntrypoint("push_static_overlay_frames_over_and_over");
+
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kSoftwareBuffer);
+
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY([](Dart_NativeArguments args) {}));
+
+  // The number of backing stores the engine rendered into in each frame.
+  constexpr size_t frames_expected = 10;
+  std::vector<size_t> updated_backing_stores;
+  fml::CountDownLatch latch(frames_expected);
+  context.GetCompositor().SetPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        if (updated_backing_stores.size() == frames_expected) {
+          return;
+        }
+
+        ASSERT_EQ(layers_count, 3u);
+
+        size_t updated = 0;
+        for (size_t i = 0; i < layers_count; ++i) {
+          if (layers[i]->type == kFlutterLayerContentTypeBackingStore &&
+              layers[i]->backing_store->did_update) {
+            updated++;
+          }
+        }
+        updated_backing_stores.push_back(updated);
+        latch.CountDown();
+      },
+      false  // one shot
+  );
+
+  auto engine = builder.LaunchEngine();
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 1024;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+
+  latch.Wait();
+
+  // Both the root and the overlay are rendered in the first frame, and reused
+  // as-is in every frame after that.
+  ASSERT_EQ(updated_backing_stores.size(), frames_expected);
+  ASSERT_EQ(updated_backing_stores[0], 2u);
+  for (size_t i = 1; i < frames_expected; ++i) {
+    ASSERT_EQ(updated_backing_stores[i], 0u) << "Frame " << i;
+  }
+}
+
+TEST_F(EmbedderTest, BackingStoresAreRenderedEveryFrameByDefault) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig(SkISize::Make(1024, 600));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("push_static_overlay_frames_over_and_over");
+
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kSoftwareBuffer);
+
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY([](Dart_NativeArguments args) {}));
+
+  // The number of backing stores the engine rendered into in each frame.
+  constexpr size_t frames_expected = 10;
+  std::vector<size_t> updated_backing_stores;
+  fml::CountDownLatch latch(frames_expected);
+  context.GetCompositor().SetPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        if (updated_backing_stores.size() == frames_expected) {
+          return;
+        }
+
+        ASSERT_EQ(layers_count, 3u);
+
+        size_t updated = 0;
+        for (size_t i = 0; i < layers_count; ++i) {
+          if (layers[i]->type == kFlutterLayerContentTypeBackingStore &&
+              layers[i]->backing_store->did_update) {
+            updated++;
+          }
+        }
+        updated_backing_stores.push_back(updated);
+        latch.CountDown();
+      },
+      false  // one shot
+  );
+
+  auto engine = builder.LaunchEngine();
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 1024;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+
+  latch.Wait();
+
+  // Embedders that did not opt in to reusing backing stores may not keep their
+  // contents, so both the root and the overlay are rendered in every frame.
+  ASSERT_EQ(updated_backing_stores.size(), frames_expected);
+  for (size_t i = 0; i < frames_expected; ++i) {
+    ASSERT_EQ(updated_backing_stores[i], 2u) << "Frame " << i;
+  }
+}
+
 TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
 
@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <iostream>
+#include <optional>
 
 #include "flutter/shell/platform/common/cpp/json_method_codec.h"
 
@@ -19,11 +20,14 @@ static constexpr char kMultilineInputType[] = "TextInputType.multiline";
 
 static constexpr char kUpdateEditingStateMethod[] =
     "TextInputClient.updateEditingState";
+static constexpr char kUpdateEditingStateWithDeltasMethod[] =
+    "TextInputClient.updateEditingStateWithDeltas";
 static constexpr char kPerformActionMethod[] = "TextInputClient.performAction";
 
 static constexpr char kTextInputAction[] = "inputAction";
 static constexpr char kTextInputType[] = "inputType";
 static constexpr char kTextInputTypeName[] = "name";
+static constexpr char kEnableDeltaModel[] = "enableDeltaModel";
 static constexpr char kComposingBaseKey[] = "composingBase";
 static constexpr char kComposingExtentKey[] = "composingExtent";
 static constexpr char kSelectionAffinityKey[] = "selectionAffinity";
@@ -32,6 +36,11 @@ static constexpr char kSelectionBaseKey[] = "selectionBase";
 static constexpr char kSelectionExtentKey[] = "selectionExtent";
 static constexpr char kSelectionIsDirectionalKey[] = "selectionIsDirectional";
 static constexpr char kTextKey[] = "text";
+static constexpr char kDeltasKey[] = "deltas";
+static constexpr char kDeltaOldTextKey[] = "oldText";
+static constexpr char kDeltaTextKey[] = "deltaText";
+static constexpr char kDeltaStartKey[] = "deltaStart";
+static constexpr char kDeltaEndKey[] = "deltaEnd";
 
 static constexpr char kChannelName[] = "flutter/textinput";
 
@@ -46,7 +55,7 @@ void TextInputPlugin::CharHook(GLFWwindow* window, unsigned int code_point) {
     return;
   }
   active_model_->AddCodePoint(code_point);
-  SendStateUpdate(*active_model_);
+  SendStateUpdate(active_model_.get());
 }
 
 void TextInputPlugin::KeyboardHook(GLFWwindow* window,
@@ -61,30 +70,30 @@ void TextInputPlugin::KeyboardHook(GLFWwindow* window,
     switch (key) {
       case GLFW_KEY_LEFT:
         if (active_model_->MoveCursorBack()) {
-          SendStateUpdate(*active_model_);
+          SendStateUpdate(active_model_.get());
         }
         break;
       case GLFW_KEY_RIGHT:
         if (active_model_->MoveCursorForward()) {
-          SendStateUpdate(*active_model_);
+          SendStateUpdate(active_model_.get());
         }
         break;
       case GLFW_KEY_END:
         active_model_->MoveCursorToEnd();
-        SendStateUpdate(*active_model_);
+        SendStateUpdate(active_model_.get());
         break;
       case GLFW_KEY_HOME:
         active_model_->MoveCursorToBeginning();
-        SendStateUpdate(*active_model_);
+        SendStateUpdate(active_model_.get());
         break;
       case GLFW_KEY_BACKSPACE:
         if (active_model_->Backspace()) {
-          SendStateUpdate(*active_model_);
+          SendStateUpdate(active_model_.get());
         }
         break;
       case GLFW_KEY_DELETE:
         if (active_model_->Delete()) {
-          SendStateUpdate(*active_model_);
+          SendStateUpdate(active_model_.get());
         }
         break;
       case GLFW_KEY_ENTER:
@@ -159,7 +168,14 @@ void TextInputPlugin::HandleMethodCall(
         input_type_ = input_type_json->value.GetString();
       }
     }
+    bool enable_delta_model = false;
+    auto enable_delta_model_json = client_config.FindMember(kEnableDeltaModel);
+    if (enable_delta_model_json != client_config.MemberEnd() &&
+        enable_delta_model_json->value.IsBool()) {
+      enable_delta_model = enable_delta_model_json->value.GetBool();
+    }
     active_model_ = std::make_unique<TextInputModel>();
+    active_model_->set_record_editing_deltas(enable_delta_model);
   } else if (method.compare(kSetEditingStateMethod) == 0) {
     if (!method_call.arguments() || method_call.arguments()->IsNull()) {
       result->Error(kBadArgumentError, "Method invoked without args");
@@ -205,31 +221,80 @@ void TextInputPlugin::HandleMethodCall(
   result->Success();
 }
 
-void TextInputPlugin::SendStateUpdate(const TextInputModel& model) {
+namespace {
+
+// Adds the selection and composing range of |model| to |editing_state|.
+void AddSelectionAndComposing(const TextInputModel& model,
+                              rapidjson::Value* editing_state,
+                              rapidjson::Document::AllocatorType& allocator) {
+  TextRange selection = model.selection();
+  editing_state->AddMember(kComposingBaseKey, -1, allocator);
+  editing_state->AddMember(kComposingExtentKey, -1, allocator);
+  editing_state->AddMember(kSelectionAffinityKey, kAffinityDownstream,
+                           allocator);
+  editing_state->AddMember(kSelectionBaseKey, selection.base(), allocator);
+  editing_state->AddMember(kSelectionExtentKey, selection.extent(), allocator);
+  editing_state->AddMember(kSelectionIsDirectionalKey, false, allocator);
+}
+
+}  // namespace
+
+void TextInputPlugin::SendStateUpdate(TextInputModel* model) {
+  if (model->record_editing_deltas()) {
+    SendDeltaStateUpdate(model);
+    return;
+  }
   auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
   auto& allocator = args->GetAllocator();
   args->PushBack(client_id_, allocator);
 
-  TextRange selection = model.selection();
   rapidjson::Value editing_state(rapidjson::kObjectType);
-  editing_state.AddMember(kComposingBaseKey, -1, allocator);
-  editing_state.AddMember(kComposingExtentKey, -1, allocator);
-  editing_state.AddMember(kSelectionAffinityKey, kAffinityDownstream,
-                          allocator);
-  editing_state.AddMember(kSelectionBaseKey, selection.base(), allocator);
-  editing_state.AddMember(kSelectionExtentKey, selection.extent(), allocator);
-  editing_state.AddMember(kSelectionIsDirectionalKey, false, allocator);
+  AddSelectionAndComposing(*model, &editing_state, allocator);
   editing_state.AddMember(
-      kTextKey, rapidjson::Value(model.GetText(), allocator).Move(), allocator);
+      kTextKey, rapidjson::Value(model->GetText(), allocator).Move(),
+      allocator);
   args->PushBack(editing_state, allocator);
 
   channel_->InvokeMethod(kUpdateEditingStateMethod, std::move(args));
 }
 
+void TextInputPlugin::SendDeltaStateUpdate(TextInputModel* model) {
+  auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
+  auto& allocator = args->GetAllocator();
+  args->PushBack(client_id_, allocator);
+
+  // A selection change without a change to the text is sent as an empty delta
+  // at -1.
+  std::optional<TextEditingDelta> delta = model->TakeEditingDelta();
+  rapidjson::Value delta_json(rapidjson::kObjectType);
+  delta_json.AddMember(
+      kDeltaOldTextKey,
+      rapidjson::Value(delta ? delta->old_text : "", allocator).Move(),
+      allocator);
+  delta_json.AddMember(
+      kDeltaTextKey,
+      rapidjson::Value(delta ? delta->text : "", allocator).Move(), allocator);
+  delta_json.AddMember(kDeltaStartKey,
+                       delta ? static_cast<int>(delta->range.start()) : -1,
+                       allocator);
+  delta_json.AddMember(kDeltaEndKey,
+                       delta ? static_cast<int>(delta->range.end()) : -1,
+                       allocator);
+  AddSelectionAndComposing(*model, &delta_json, allocator);
+  rapidjson::Value deltas(rapidjson::kArrayType);
+  deltas.PushBack(delta_json, allocator);
+
+  rapidjson::Value editing_state(rapidjson::kObjectType);
+  editing_state.AddMember(kDeltasKey, deltas, allocator);
+  args->PushBack(editing_state, allocator);
+
+  channel_->InvokeMethod(kUpdateEditingStateWithDeltasMethod, std::move(args));
+}
+
 void TextInputPlugin::EnterPressed(TextInputModel* model) {
   if (input_type_ == kMultilineInputType) {
     model->AddCodePoint('\n');
-    SendStateUpdate(*model);
+    SendStateUpdate(model);
   }
   auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
   auto& allocator = args->GetAllocator();
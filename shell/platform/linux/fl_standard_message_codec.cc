@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
 #include "flutter/shell/platform/linux/fl_standard_message_codec_private.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
@@ -27,8 +28,20 @@ static constexpr int kValueFloat64List = 11;
 static constexpr int kValueList = 12;
 static constexpr int kValueMap = 13;
 
+// Bytes of decoding arena per byte of message. Decoded values are several
+// times larger than their encoding.
+static constexpr size_t kArenaBytesPerMessageByte = 8;
+
+// Upper bound for the initial size of a decoding arena. Large messages are
+// mostly made of typed lists and strings, which the arena doesn't hold or
+// holds once.
+static constexpr size_t kMaxArenaSizeHint = 64 * 1024;
+
 struct _FlStandardMessageCodec {
   FlMessageCodec parent_instance;
+
+  // TRUE if decoded values are allocated from one arena per message.
+  gboolean arena_decoding;
 };
 
 G_DEFINE_TYPE(FlStandardMessageCodec,
@@ -68,8 +81,24 @@ static void write_float64(GByteArray* buffer, double value) {
 
 // Write padding bytes to align to @align multiple of bytes.
 static void write_align(GByteArray* buffer, guint align) {
-  while (buffer->len % align != 0) {
-    write_uint8(buffer, 0);
+  static constexpr uint8_t kPadding[8] = {};
+  guint padding = (align - buffer->len % align) % align;
+  g_byte_array_append(buffer, kPadding, padding);
+}
+
+// Returns @offset rounded up to a multiple of @align.
+static size_t align_offset(size_t offset, size_t align) {
+  return (offset + align - 1) / align * align;
+}
+
+// Returns the number of bytes used to encode a size field with @size.
+static size_t get_size_length(uint32_t size) {
+  if (size < 254) {
+    return sizeof(uint8_t);
+  } else if (size <= 0xffff) {
+    return sizeof(uint8_t) + sizeof(uint16_t);
+  } else {
+    return sizeof(uint8_t) + sizeof(uint32_t);
   }
 }
 
@@ -160,12 +189,14 @@ static gboolean read_uint32(GBytes* buffer,
 // error.
 static FlValue* read_int32_value(GBytes* buffer,
                                  size_t* offset,
+                                 FlValueArena* arena,
                                  GError** error) {
   if (!check_size(buffer, *offset, sizeof(int32_t), error)) {
     return nullptr;
   }
 
-  FlValue* value = fl_value_new_int(
+  FlValue* value = fl_value_arena_new_int(
+      arena,
       reinterpret_cast<const int32_t*>(get_data(buffer, offset))[0]);
   *offset += sizeof(int32_t);
   return value;
@@ -176,12 +207,14 @@ static FlValue* read_int32_value(GBytes* buffer,
 // error.
 static FlValue* read_int64_value(GBytes* buffer,
                                  size_t* offset,
+                                 FlValueArena* arena,
                                  GError** error) {
   if (!check_size(buffer, *offset, sizeof(int64_t), error)) {
     return nullptr;
   }
 
-  FlValue* value = fl_value_new_int(
+  FlValue* value = fl_value_arena_new_int(
+      arena,
       reinterpret_cast<const int64_t*>(get_data(buffer, offset))[0]);
   *offset += sizeof(int64_t);
   return value;
@@ -192,6 +225,7 @@ static FlValue* read_int64_value(GBytes* buffer,
 // error.
 static FlValue* read_float64_value(GBytes* buffer,
                                    size_t* offset,
+                                   FlValueArena* arena,
                                    GError** error) {
   if (!read_align(buffer, offset, 8, error)) {
     return nullptr;
@@ -200,7 +234,8 @@ static FlValue* read_float64_value(GBytes* buffer,
     return nullptr;
   }
 
-  FlValue* value = fl_value_new_float(
+  FlValue* value = fl_value_arena_new_float(
+      arena,
       reinterpret_cast<const double*>(get_data(buffer, offset))[0]);
   *offset += sizeof(double);
   return value;
@@ -212,6 +247,7 @@ static FlValue* read_float64_value(GBytes* buffer,
 static FlValue* read_string_value(FlStandardMessageCodec* self,
                                   GBytes* buffer,
                                   size_t* offset,
+                                  FlValueArena* arena,
                                   GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -221,8 +257,8 @@ static FlValue* read_string_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_string_sized(
-      reinterpret_cast<const gchar*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_arena_new_string_sized(
+      arena, reinterpret_cast<const gchar*>(get_data(buffer, offset)), length);
   *offset += length;
   return value;
 }
@@ -233,6 +269,7 @@ static FlValue* read_string_value(FlStandardMessageCodec* self,
 static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
                                       GBytes* buffer,
                                       size_t* offset,
+                                      FlValueArena* arena,
                                       GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -242,7 +279,11 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(uint8_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_uint8_list(get_data(buffer, offset), length);
+  FlValue* value =
+      arena != nullptr
+          ? fl_value_arena_new_typed_list(arena, FL_VALUE_TYPE_UINT8_LIST,
+                                          buffer, *offset, length)
+          : fl_value_new_uint8_list(get_data(buffer, offset), length);
   *offset += length;
   return value;
 }
@@ -253,6 +294,7 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
 static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
                                       GBytes* buffer,
                                       size_t* offset,
+                                      FlValueArena* arena,
                                       GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -265,8 +307,13 @@ static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int32_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int32_list(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset)), length);
+  FlValue* value =
+      arena != nullptr
+          ? fl_value_arena_new_typed_list(arena, FL_VALUE_TYPE_INT32_LIST,
+                                          buffer, *offset, length)
+          : fl_value_new_int32_list(
+                reinterpret_cast<const int32_t*>(get_data(buffer, offset)),
+                length);
   *offset += sizeof(int32_t) * length;
   return value;
 }
@@ -277,6 +324,7 @@ static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
 static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
                                       GBytes* buffer,
                                       size_t* offset,
+                                      FlValueArena* arena,
                                       GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -289,8 +337,13 @@ static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int64_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int64_list(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset)), length);
+  FlValue* value =
+      arena != nullptr
+          ? fl_value_arena_new_typed_list(arena, FL_VALUE_TYPE_INT64_LIST,
+                                          buffer, *offset, length)
+          : fl_value_new_int64_list(
+                reinterpret_cast<const int64_t*>(get_data(buffer, offset)),
+                length);
   *offset += sizeof(int64_t) * length;
   return value;
 }
@@ -301,6 +354,7 @@ static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
 static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
                                         GBytes* buffer,
                                         size_t* offset,
+                                        FlValueArena* arena,
                                         GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -313,18 +367,32 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(double) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float_list(
-      reinterpret_cast<const double*>(get_data(buffer, offset)), length);
+  FlValue* value =
+      arena != nullptr
+          ? fl_value_arena_new_typed_list(arena, FL_VALUE_TYPE_FLOAT_LIST,
+                                          buffer, *offset, length)
+          : fl_value_new_float_list(
+                reinterpret_cast<const double*>(get_data(buffer, offset)),
+                length);
   *offset += sizeof(double) * length;
   return value;
 }
 
+// Returns the number of values to reserve room for in a list or map of
+// @length values read from @offset in @buffer. Each value takes at least one
+// byte, so a corrupt length can't cause a huge allocation.
+static size_t get_capacity(GBytes* buffer, size_t offset, uint32_t length) {
+  size_t remaining = g_bytes_get_size(buffer) - offset;
+  return MIN(static_cast<size_t>(length), remaining);
+}
+
 // Reads a list from @buffer in standard codec format.
 // Returns a new #FlValue of type #FL_VALUE_TYPE_LIST if successful or %NULL on
 // error.
 static FlValue* read_list_value(FlStandardMessageCodec* self,
                                 GBytes* buffer,
                                 size_t* offset,
+                                FlValueArena* arena,
                                 GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -332,14 +400,15 @@ static FlValue* read_list_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) list = fl_value_new_list();
+  g_autoptr(FlValue) list =
+      fl_value_arena_new_list(arena, get_capacity(buffer, *offset, length));
   for (size_t i = 0; i < length; i++) {
-    g_autoptr(FlValue) child =
-        fl_standard_message_codec_read_value(self, buffer, offset, error);
+    FlValue* child = fl_standard_message_codec_read_value(self, buffer, offset,
+                                                          arena, error);
     if (child == nullptr) {
       return nullptr;
     }
-    fl_value_append(list, child);
+    fl_value_append_take(list, child);
   }
 
   return fl_value_ref(list);
@@ -351,6 +420,7 @@ static FlValue* read_list_value(FlStandardMessageCodec* self,
 static FlValue* read_map_value(FlStandardMessageCodec* self,
                                GBytes* buffer,
                                size_t* offset,
+                               FlValueArena* arena,
                                GError** error) {
   uint32_t length;
   if (!fl_standard_message_codec_read_size(self, buffer, offset, &length,
@@ -358,15 +428,16 @@ static FlValue* read_map_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) map = fl_value_new_map();
+  g_autoptr(FlValue) map =
+      fl_value_arena_new_map(arena, get_capacity(buffer, *offset, length));
   for (size_t i = 0; i < length; i++) {
-    g_autoptr(FlValue) key =
-        fl_standard_message_codec_read_value(self, buffer, offset, error);
+    g_autoptr(FlValue) key = fl_standard_message_codec_read_value(
+        self, buffer, offset, arena, error);
     if (key == nullptr) {
       return nullptr;
     }
-    g_autoptr(FlValue) value =
-        fl_standard_message_codec_read_value(self, buffer, offset, error);
+    g_autoptr(FlValue) value = fl_standard_message_codec_read_value(
+        self, buffer, offset, arena, error);
     if (value == nullptr) {
       return nullptr;
     }
@@ -383,7 +454,8 @@ static GBytes* fl_standard_message_codec_encode_message(FlMessageCodec* codec,
   FlStandardMessageCodec* self =
       reinterpret_cast<FlStandardMessageCodec*>(codec);
 
-  g_autoptr(GByteArray) buffer = g_byte_array_new();
+  g_autoptr(GByteArray) buffer = g_byte_array_sized_new(
+      fl_standard_message_codec_get_value_end(self, 0, message));
   if (!fl_standard_message_codec_write_value(self, buffer, message, error)) {
     return nullptr;
   }
@@ -399,8 +471,10 @@ static FlValue* fl_standard_message_codec_decode_message(FlMessageCodec* codec,
       reinterpret_cast<FlStandardMessageCodec*>(codec);
 
   size_t offset = 0;
-  g_autoptr(FlValue) value =
-      fl_standard_message_codec_read_value(self, message, &offset, error);
+  g_autoptr(FlValueArena) arena =
+      fl_standard_message_codec_new_decode_arena(self, message);
+  g_autoptr(FlValue) value = fl_standard_message_codec_read_value(
+      self, message, &offset, arena, error);
   if (value == nullptr) {
     return nullptr;
   }
@@ -424,13 +498,32 @@ static void fl_standard_message_codec_class_init(
       fl_standard_message_codec_decode_message;
 }
 
-static void fl_standard_message_codec_init(FlStandardMessageCodec* self) {}
+static void fl_standard_message_codec_init(FlStandardMessageCodec* self) {
+  self->arena_decoding = TRUE;
+}
 
 G_MODULE_EXPORT FlStandardMessageCodec* fl_standard_message_codec_new() {
   return static_cast<FlStandardMessageCodec*>(
       g_object_new(fl_standard_message_codec_get_type(), nullptr));
 }
 
+void fl_standard_message_codec_set_arena_decoding(FlStandardMessageCodec* self,
+                                                  gboolean arena_decoding) {
+  g_return_if_fail(FL_IS_STANDARD_CODEC(self));
+  self->arena_decoding = arena_decoding;
+}
+
+FlValueArena* fl_standard_message_codec_new_decode_arena(
+    FlStandardMessageCodec* self,
+    GBytes* message) {
+  if (!self->arena_decoding) {
+    return nullptr;
+  }
+  return fl_value_arena_new(
+      MIN(g_bytes_get_size(message) * kArenaBytesPerMessageByte,
+          kMaxArenaSizeHint));
+}
+
 void fl_standard_message_codec_write_size(FlStandardMessageCodec* codec,
                                           GByteArray* buffer,
                                           uint32_t size) {
@@ -590,9 +683,78 @@ gboolean fl_standard_message_codec_write_value(FlStandardMessageCodec* self,
   return FALSE;
 }
 
+size_t fl_standard_message_codec_get_value_end(FlStandardMessageCodec* self,
+                                               size_t offset,
+                                               FlValue* value) {
+  // The type byte.
+  offset += sizeof(uint8_t);
+  if (value == nullptr) {
+    return offset;
+  }
+
+  switch (fl_value_get_type(value)) {
+    case FL_VALUE_TYPE_NULL:
+    case FL_VALUE_TYPE_BOOL:
+      return offset;
+    case FL_VALUE_TYPE_INT: {
+      int64_t v = fl_value_get_int(value);
+      return offset + (v >= INT32_MIN && v <= INT32_MAX ? sizeof(int32_t)
+                                                        : sizeof(int64_t));
+    }
+    case FL_VALUE_TYPE_FLOAT:
+      return align_offset(offset, 8) + sizeof(double);
+    case FL_VALUE_TYPE_STRING: {
+      size_t length = strlen(fl_value_get_string(value));
+      return offset + get_size_length(length) + length;
+    }
+    case FL_VALUE_TYPE_UINT8_LIST: {
+      size_t length = fl_value_get_length(value);
+      return offset + get_size_length(length) + sizeof(uint8_t) * length;
+    }
+    case FL_VALUE_TYPE_INT32_LIST: {
+      size_t length = fl_value_get_length(value);
+      return align_offset(offset + get_size_length(length), 4) +
+             sizeof(int32_t) * length;
+    }
+    case FL_VALUE_TYPE_INT64_LIST: {
+      size_t length = fl_value_get_length(value);
+      return align_offset(offset + get_size_length(length), 8) +
+             sizeof(int64_t) * length;
+    }
+    case FL_VALUE_TYPE_FLOAT_LIST: {
+      size_t length = fl_value_get_length(value);
+      return align_offset(offset + get_size_length(length), 8) +
+             sizeof(double) * length;
+    }
+    case FL_VALUE_TYPE_LIST: {
+      size_t length = fl_value_get_length(value);
+      offset += get_size_length(length);
+      for (size_t i = 0; i < length; i++) {
+        offset = fl_standard_message_codec_get_value_end(
+            self, offset, fl_value_get_list_value(value, i));
+      }
+      return offset;
+    }
+    case FL_VALUE_TYPE_MAP: {
+      size_t length = fl_value_get_length(value);
+      offset += get_size_length(length);
+      for (size_t i = 0; i < length; i++) {
+        offset = fl_standard_message_codec_get_value_end(
+            self, offset, fl_value_get_map_key(value, i));
+        offset = fl_standard_message_codec_get_value_end(
+            self, offset, fl_value_get_map_value(value, i));
+      }
+      return offset;
+    }
+  }
+
+  return offset;
+}
+
 FlValue* fl_standard_message_codec_read_value(FlStandardMessageCodec* self,
                                               GBytes* buffer,
                                               size_t* offset,
+                                              FlValueArena* arena,
                                               GError** error) {
   uint8_t type;
   if (!read_uint8(buffer, offset, &type, error)) {
@@ -601,31 +763,31 @@ FlValue* fl_standard_message_codec_read_value(FlStandardMessageCodec* self,
 
   g_autoptr(FlValue) value = nullptr;
   if (type == kValueNull) {
-    return fl_value_new_null();
+    return fl_value_arena_new_null(arena);
   } else if (type == kValueTrue) {
-    return fl_value_new_bool(TRUE);
+    return fl_value_arena_new_bool(arena, TRUE);
   } else if (type == kValueFalse) {
-    return fl_value_new_bool(FALSE);
+    return fl_value_arena_new_bool(arena, FALSE);
   } else if (type == kValueInt32) {
-    value = read_int32_value(buffer, offset, error);
+    value = read_int32_value(buffer, offset, arena, error);
   } else if (type == kValueInt64) {
-    value = read_int64_value(buffer, offset, error);
+    value = read_int64_value(buffer, offset, arena, error);
   } else if (type == kValueFloat64) {
-    value = read_float64_value(buffer, offset, error);
+    value = read_float64_value(buffer, offset, arena, error);
   } else if (type == kValueString) {
-    value = read_string_value(self, buffer, offset, error);
+    value = read_string_value(self, buffer, offset, arena, error);
   } else if (type == kValueUint8List) {
-    value = read_uint8_list_value(self, buffer, offset, error);
+    value = read_uint8_list_value(self, buffer, offset, arena, error);
   } else if (type == kValueInt32List) {
-    value = read_int32_list_value(self, buffer, offset, error);
+    value = read_int32_list_value(self, buffer, offset, arena, error);
   } else if (type == kValueInt64List) {
-    value = read_int64_list_value(self, buffer, offset, error);
+    value = read_int64_list_value(self, buffer, offset, arena, error);
   } else if (type == kValueFloat64List) {
-    value = read_float64_list_value(self, buffer, offset, error);
+    value = read_float64_list_value(self, buffer, offset, arena, error);
   } else if (type == kValueList) {
-    value = read_list_value(self, buffer, offset, error);
+    value = read_list_value(self, buffer, offset, arena, error);
   } else if (type == kValueMap) {
-    value = read_map_value(self, buffer, offset, error);
+    value = read_map_value(self, buffer, offset, arena, error);
   } else {
     g_set_error(error, FL_MESSAGE_CODEC_ERROR,
                 FL_MESSAGE_CODEC_ERROR_UNSUPPORTED_TYPE,
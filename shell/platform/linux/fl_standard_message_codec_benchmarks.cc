@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/shell/platform/linux/fl_standard_message_codec_private.h"
+
+namespace {
+
+// Returns a map like the ones platform channels commonly send, e.g. a text
+// editing state update.
+FlValue* MakeSmallMessageValue() {
+  FlValue* value = fl_value_new_map();
+  fl_value_set_string_take(value, "text", fl_value_new_string("Hello world"));
+  fl_value_set_string_take(value, "selectionBase", fl_value_new_int(5));
+  fl_value_set_string_take(value, "selectionExtent", fl_value_new_int(5));
+  fl_value_set_string_take(value, "selectionAffinity",
+                           fl_value_new_string("TextAffinity.downstream"));
+  fl_value_set_string_take(value, "selectionIsDirectional",
+                           fl_value_new_bool(FALSE));
+  fl_value_set_string_take(value, "composingBase", fl_value_new_int(-1));
+  fl_value_set_string_take(value, "composingExtent", fl_value_new_int(-1));
+  return value;
+}
+
+// Returns a list of |count| small maps, each with a typed list, like a batch
+// of semantics or sensor updates.
+FlValue* MakeLargeMessageValue(int64_t count) {
+  FlValue* value = fl_value_new_list();
+  for (int64_t i = 0; i < count; i++) {
+    g_autoptr(FlValue) entry = MakeSmallMessageValue();
+    double transform[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    fl_value_set_string_take(entry, "transform",
+                             fl_value_new_float_list(transform, 16));
+    fl_value_append(value, entry);
+  }
+  return value;
+}
+
+GBytes* EncodeMessage(FlStandardMessageCodec* codec, FlValue* value) {
+  g_autoptr(GError) error = nullptr;
+  GBytes* message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), value, &error);
+  FML_CHECK(message != nullptr);
+  return message;
+}
+
+void DecodeMessage(benchmark::State& state,
+                   FlValue* value,
+                   gboolean arena_decoding) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  fl_standard_message_codec_set_arena_decoding(codec, arena_decoding);
+  g_autoptr(GBytes) message = EncodeMessage(codec, value);
+  while (state.KeepRunning()) {
+    g_autoptr(GError) error = nullptr;
+    g_autoptr(FlValue) decoded = fl_message_codec_decode_message(
+        FL_MESSAGE_CODEC(codec), message, &error);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * g_bytes_get_size(message));
+}
+
+void BM_StandardMessageCodecDecodeSmall(benchmark::State& state) {
+  g_autoptr(FlValue) value = MakeSmallMessageValue();
+  DecodeMessage(state, value, state.range(0));
+}
+
+void BM_StandardMessageCodecDecodeLarge(benchmark::State& state) {
+  g_autoptr(FlValue) value = MakeLargeMessageValue(state.range(0));
+  DecodeMessage(state, value, state.range(1));
+}
+
+void BM_StandardMessageCodecEncodeLarge(benchmark::State& state) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FlValue) value = MakeLargeMessageValue(state.range(0));
+  while (state.KeepRunning()) {
+    g_autoptr(GBytes) message = EncodeMessage(codec, value);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+}  // namespace
+
+// The last argument selects arena decoding.
+BENCHMARK(BM_StandardMessageCodecDecodeSmall)->Arg(false)->Arg(true);
+BENCHMARK(BM_StandardMessageCodecDecodeLarge)
+    ->Args({100, false})
+    ->Args({100, true})
+    ->Args({10000, false})
+    ->Args({10000, true});
+BENCHMARK(BM_StandardMessageCodecEncodeLarge)->Arg(100)->Arg(10000);
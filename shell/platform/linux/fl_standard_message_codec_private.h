@@ -5,10 +5,37 @@
 #ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_STANDARD_MESSAGE_CODEC_PRIVATE_H_
 #define FLUTTER_SHELL_PLATFORM_LINUX_FL_STANDARD_MESSAGE_CODEC_PRIVATE_H_
 
+#include "flutter/shell/platform/linux/fl_value_private.h"
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
 
 G_BEGIN_DECLS
 
+/**
+ * fl_standard_message_codec_set_arena_decoding:
+ * @codec: an #FlStandardMessageCodec.
+ * @arena_decoding: %TRUE to allocate the values decoded from a message from a
+ * single #FlValueArena.
+ *
+ * Sets whether decoded values are allocated from an arena, which is the
+ * default. Arena decoded typed lists also reference the message instead of
+ * copying it.
+ */
+void fl_standard_message_codec_set_arena_decoding(FlStandardMessageCodec* codec,
+                                                  gboolean arena_decoding);
+
+/**
+ * fl_standard_message_codec_new_decode_arena:
+ * @codec: an #FlStandardMessageCodec.
+ * @message: message that is going to be decoded.
+ *
+ * Creates an arena sized for the values decoded from @message.
+ *
+ * Returns: a new #FlValueArena or %NULL if arena decoding is disabled.
+ */
+FlValueArena* fl_standard_message_codec_new_decode_arena(
+    FlStandardMessageCodec* codec,
+    GBytes* message);
+
 /**
  * fl_standard_message_codec_write_size:
  * @codec: an #FlStandardMessageCodec.
@@ -57,12 +84,28 @@ gboolean fl_standard_message_codec_write_value(FlStandardMessageCodec* codec,
                                                FlValue* value,
                                                GError** error);
 
+/**
+ * fl_standard_message_codec_get_value_end:
+ * @codec: an #FlStandardMessageCodec.
+ * @offset: position in the buffer the value would be written at.
+ * @value: (allow-none): value to measure.
+ *
+ * Computes where writing @value at @offset would end, including alignment
+ * padding, so that buffers can be allocated at their final size.
+ *
+ * Returns: the position after the encoded value.
+ */
+size_t fl_standard_message_codec_get_value_end(FlStandardMessageCodec* codec,
+                                               size_t offset,
+                                               FlValue* value);
+
 /**
  * fl_standard_message_codec_read_value:
  * @codec: an #FlStandardMessageCodec.
  * @buffer: buffer to read from.
  * @offset: (inout): read position in @buffer.
- * @value: location to read size.
+ * @arena: (allow-none): arena to allocate the value from, or %NULL to allocate
+ * it from the heap.
  * @error: (allow-none): #GError location to store the error occurring, or
  * %NULL.
  *
@@ -73,6 +116,7 @@ gboolean fl_standard_message_codec_write_value(FlStandardMessageCodec* codec,
 FlValue* fl_standard_message_codec_read_value(FlStandardMessageCodec* codec,
                                               GBytes* buffer,
                                               size_t* offset,
+                                              FlValueArena* arena,
                                               GError** error);
 
 G_END_DECLS
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/shell/platform/linux/fl_standard_message_codec_private.h"
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
 #include "flutter/shell/platform/linux/testing/fl_test.h"
 #include "gtest/gtest.h"
@@ -1035,3 +1036,117 @@ TEST(FlStandardMessageCodecTest, EncodeDecode) {
 
   ASSERT_TRUE(fl_value_equal(input, output));
 }
+
+// Returns a value that uses every type the codec supports.
+static FlValue* make_all_types_value() {
+  FlValue* value = fl_value_new_list();
+  fl_value_append_take(value, fl_value_new_null());
+  fl_value_append_take(value, fl_value_new_bool(TRUE));
+  fl_value_append_take(value, fl_value_new_int(42));
+  fl_value_append_take(value, fl_value_new_int(G_MAXINT64));
+  fl_value_append_take(value, fl_value_new_float(M_PI));
+  fl_value_append_take(value, fl_value_new_string("hello"));
+  uint8_t uint8_data[] = {1, 2, 3};
+  fl_value_append_take(value, fl_value_new_uint8_list(uint8_data, 3));
+  int32_t int32_data[] = {-1, 0, 1};
+  fl_value_append_take(value, fl_value_new_int32_list(int32_data, 3));
+  int64_t int64_data[] = {G_MININT64, 0, G_MAXINT64};
+  fl_value_append_take(value, fl_value_new_int64_list(int64_data, 3));
+  double float_data[] = {0.0, -1.5, M_PI};
+  fl_value_append_take(value, fl_value_new_float_list(float_data, 3));
+  g_autoptr(FlValue) map = fl_value_new_map();
+  fl_value_set_string_take(map, "list", fl_value_new_list());
+  fl_value_set_take(map, fl_value_new_int(1), fl_value_new_string("one"));
+  fl_value_append(value, map);
+  return value;
+}
+
+TEST(FlStandardMessageCodecTest, GetValueEnd) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FlValue) value = make_all_types_value();
+  g_autoptr(GByteArray) buffer = g_byte_array_new();
+  for (guint offset = 0; offset < 8; offset++) {
+    g_byte_array_set_size(buffer, offset);
+    g_autoptr(GError) error = nullptr;
+    ASSERT_TRUE(fl_standard_message_codec_write_value(codec, buffer, value,
+                                                      &error));
+    EXPECT_EQ(fl_standard_message_codec_get_value_end(codec, offset, value),
+              buffer->len);
+  }
+  EXPECT_EQ(fl_standard_message_codec_get_value_end(codec, 0, nullptr), 1u);
+}
+
+TEST(FlStandardMessageCodecTest, DecodeWithoutArena) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FlValue) value = make_all_types_value();
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(GBytes) message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), value, &error);
+  ASSERT_NE(message, nullptr);
+
+  g_autoptr(FlValue) arena_value =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  EXPECT_EQ(error, nullptr);
+  EXPECT_TRUE(fl_value_equal(value, arena_value));
+
+  fl_standard_message_codec_set_arena_decoding(codec, FALSE);
+  EXPECT_EQ(fl_standard_message_codec_new_decode_arena(codec, message),
+            nullptr);
+  g_autoptr(FlValue) heap_value =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  EXPECT_EQ(error, nullptr);
+  EXPECT_TRUE(fl_value_equal(value, heap_value));
+}
+
+TEST(FlStandardMessageCodecTest, DecodedTypedListReferencesMessage) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(GBytes) message = hex_string_to_bytes(
+      "0b030000000000000000000000000000000000000000f8bf182d4454fb210940");
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) value =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  ASSERT_NE(value, nullptr);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_FLOAT_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(3));
+  const double* data = fl_value_get_float_list(value);
+  EXPECT_EQ(data[0], 0.0);
+  EXPECT_EQ(data[1], -1.5);
+  EXPECT_EQ(data[2], M_PI);
+  EXPECT_EQ(reinterpret_cast<const uint8_t*>(data),
+            static_cast<const uint8_t*>(g_bytes_get_data(message, nullptr)) +
+                8);
+}
+
+TEST(FlStandardMessageCodecTest, DecodedChildOutlivesParent) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FlValue) value = make_all_types_value();
+  g_autoptr(GError) error = nullptr;
+  GBytes* message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), value, &error);
+  ASSERT_NE(message, nullptr);
+  FlValue* decoded =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  ASSERT_NE(decoded, nullptr);
+  g_autoptr(FlValue) string = fl_value_ref(fl_value_get_list_value(decoded, 5));
+  g_autoptr(FlValue) list = fl_value_ref(fl_value_get_list_value(decoded, 9));
+  g_autoptr(FlValue) map = fl_value_ref(fl_value_get_list_value(decoded, 10));
+  g_bytes_unref(message);
+  fl_value_unref(decoded);
+
+  EXPECT_STREQ(fl_value_get_string(string), "hello");
+  EXPECT_TRUE(fl_value_equal(list, fl_value_get_list_value(value, 9)));
+  EXPECT_TRUE(fl_value_equal(map, fl_value_get_list_value(value, 10)));
+
+  // Values can still be added to decoded collections.
+  fl_value_set_string_take(map, "added", fl_value_new_int(7));
+  EXPECT_EQ(fl_value_get_length(map), static_cast<size_t>(3));
+  fl_value_append_take(fl_value_lookup_string(map, "list"),
+                       fl_value_new_null());
+  EXPECT_EQ(fl_value_get_length(fl_value_lookup_string(map, "list")),
+            static_cast<size_t>(1));
+}
+
+TEST(FlStandardMessageCodecTest, DecodeListHugeLength) {
+  decode_error_value("0cffffffff7f00", FL_MESSAGE_CODEC_ERROR,
+                     FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA);
+}
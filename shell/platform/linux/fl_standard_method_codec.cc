@@ -41,8 +41,11 @@ static GBytes* fl_standard_method_codec_encode_method_call(FlMethodCodec* codec,
                                                            GError** error) {
   FlStandardMethodCodec* self = FL_STANDARD_METHOD_CODEC(codec);
 
-  g_autoptr(GByteArray) buffer = g_byte_array_new();
   g_autoptr(FlValue) name_value = fl_value_new_string(name);
+  size_t size = fl_standard_message_codec_get_value_end(self->codec, 0,
+                                                        name_value);
+  size = fl_standard_message_codec_get_value_end(self->codec, size, args);
+  g_autoptr(GByteArray) buffer = g_byte_array_sized_new(size);
   if (!fl_standard_message_codec_write_value(self->codec, buffer, name_value,
                                              error)) {
     return nullptr;
@@ -66,8 +69,10 @@ static gboolean fl_standard_method_codec_decode_method_call(
   FlStandardMethodCodec* self = FL_STANDARD_METHOD_CODEC(codec);
 
   size_t offset = 0;
+  g_autoptr(FlValueArena) arena =
+      fl_standard_message_codec_new_decode_arena(self->codec, message);
   g_autoptr(FlValue) name_value = fl_standard_message_codec_read_value(
-      self->codec, message, &offset, error);
+      self->codec, message, &offset, arena, error);
   if (name_value == nullptr) {
     return FALSE;
   }
@@ -78,7 +83,7 @@ static gboolean fl_standard_method_codec_decode_method_call(
   }
 
   g_autoptr(FlValue) args_value = fl_standard_message_codec_read_value(
-      self->codec, message, &offset, error);
+      self->codec, message, &offset, arena, error);
   if (args_value == nullptr) {
     return FALSE;
   }
@@ -102,7 +107,8 @@ static GBytes* fl_standard_method_codec_encode_success_envelope(
     GError** error) {
   FlStandardMethodCodec* self = FL_STANDARD_METHOD_CODEC(codec);
 
-  g_autoptr(GByteArray) buffer = g_byte_array_new();
+  g_autoptr(GByteArray) buffer = g_byte_array_sized_new(
+      fl_standard_message_codec_get_value_end(self->codec, 1, result));
   guint8 type = kEnvelopeTypeSuccess;
   g_byte_array_append(buffer, &type, 1);
   if (!fl_standard_message_codec_write_value(self->codec, buffer, result,
@@ -123,16 +129,21 @@ static GBytes* fl_standard_method_codec_encode_error_envelope(
     GError** error) {
   FlStandardMethodCodec* self = FL_STANDARD_METHOD_CODEC(codec);
 
-  g_autoptr(GByteArray) buffer = g_byte_array_new();
+  g_autoptr(FlValue) code_value = fl_value_new_string(code);
+  g_autoptr(FlValue) message_value =
+      message != nullptr ? fl_value_new_string(message) : nullptr;
+  size_t size =
+      fl_standard_message_codec_get_value_end(self->codec, 1, code_value);
+  size =
+      fl_standard_message_codec_get_value_end(self->codec, size, message_value);
+  size = fl_standard_message_codec_get_value_end(self->codec, size, details);
+  g_autoptr(GByteArray) buffer = g_byte_array_sized_new(size);
   guint8 type = kEnvelopeTypeError;
   g_byte_array_append(buffer, &type, 1);
-  g_autoptr(FlValue) code_value = fl_value_new_string(code);
   if (!fl_standard_message_codec_write_value(self->codec, buffer, code_value,
                                              error)) {
     return nullptr;
   }
-  g_autoptr(FlValue) message_value =
-      message != nullptr ? fl_value_new_string(message) : nullptr;
   if (!fl_standard_message_codec_write_value(self->codec, buffer, message_value,
                                              error)) {
     return nullptr;
@@ -164,11 +175,13 @@ static FlMethodResponse* fl_standard_method_codec_decode_response(
       static_cast<const guint8*>(g_bytes_get_data(message, nullptr));
   guint8 type = data[0];
   size_t offset = 1;
+  g_autoptr(FlValueArena) arena =
+      fl_standard_message_codec_new_decode_arena(self->codec, message);
 
   g_autoptr(FlMethodResponse) response = nullptr;
   if (type == kEnvelopeTypeError) {
     g_autoptr(FlValue) code = fl_standard_message_codec_read_value(
-        self->codec, message, &offset, error);
+        self->codec, message, &offset, arena, error);
     if (code == nullptr) {
       return nullptr;
     }
@@ -179,7 +192,7 @@ static FlMethodResponse* fl_standard_method_codec_decode_response(
     }
 
     g_autoptr(FlValue) error_message = fl_standard_message_codec_read_value(
-        self->codec, message, &offset, error);
+        self->codec, message, &offset, arena, error);
     if (error_message == nullptr) {
       return nullptr;
     }
@@ -191,7 +204,7 @@ static FlMethodResponse* fl_standard_method_codec_decode_response(
     }
 
     g_autoptr(FlValue) details = fl_standard_message_codec_read_value(
-        self->codec, message, &offset, error);
+        self->codec, message, &offset, arena, error);
     if (details == nullptr) {
       return nullptr;
     }
@@ -204,7 +217,7 @@ static FlMethodResponse* fl_standard_method_codec_decode_response(
         fl_value_get_type(details) != FL_VALUE_TYPE_NULL ? details : nullptr));
   } else if (type == kEnvelopeTypeSuccess) {
     g_autoptr(FlValue) result = fl_standard_message_codec_read_value(
-        self->codec, message, &offset, error);
+        self->codec, message, &offset, arena, error);
 
     if (result == nullptr) {
       return nullptr;
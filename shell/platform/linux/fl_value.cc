@@ -3,16 +3,47 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
 #include <cstring>
 
+// Alignment of allocations made from an arena, enough for any value type.
+static constexpr size_t kArenaAlignment = 16;
+
+// Minimum size of the blocks an arena allocates when it runs out of space.
+static constexpr size_t kArenaBlockSize = 4096;
+
 struct _FlValue {
   FlValueType type;
   int ref_count;
+  // Arena this value was allocated from or nullptr if allocated on the heap.
+  FlValueArena* arena;
+};
+
+// A block of memory allocated by an arena after the first one.
+typedef struct _FlValueArenaBlock {
+  struct _FlValueArenaBlock* next;
+} FlValueArenaBlock;
+
+// The first block of memory follows this structure in the same allocation.
+struct _FlValueArena {
+  int ref_count;
+  FlValueArenaBlock* blocks;
+  uint8_t* next;
+  size_t remaining;
 };
 
+// A growable array of values. The storage of a value allocated from an arena
+// starts out in the arena and moves to the heap if it needs to grow.
+typedef struct {
+  FlValue** values;
+  size_t length;
+  size_t capacity;
+  bool values_on_heap;
+} FlValueArray;
+
 typedef struct {
   FlValue parent;
   bool value;
@@ -37,47 +68,137 @@ typedef struct {
   FlValue parent;
   uint8_t* values;
   size_t values_length;
+  // Bytes that |values| points into, or nullptr if |values| is owned.
+  GBytes* bytes;
 } FlValueUint8List;
 
 typedef struct {
   FlValue parent;
   int32_t* values;
   size_t values_length;
+  // Bytes that |values| points into, or nullptr if |values| is owned.
+  GBytes* bytes;
 } FlValueInt32List;
 
 typedef struct {
   FlValue parent;
   int64_t* values;
   size_t values_length;
+  // Bytes that |values| points into, or nullptr if |values| is owned.
+  GBytes* bytes;
 } FlValueInt64List;
 
 typedef struct {
   FlValue parent;
   double* values;
   size_t values_length;
+  // Bytes that |values| points into, or nullptr if |values| is owned.
+  GBytes* bytes;
 } FlValueFloatList;
 
 typedef struct {
   FlValue parent;
-  GPtrArray* values;
+  FlValueArray values;
 } FlValueList;
 
 typedef struct {
   FlValue parent;
-  GPtrArray* keys;
-  GPtrArray* values;
+  FlValueArray keys;
+  FlValueArray values;
 } FlValueMap;
 
-static FlValue* fl_value_new(FlValueType type, size_t size) {
-  FlValue* self = static_cast<FlValue*>(g_malloc0(size));
+// Rounds |size| up to a multiple of the arena alignment.
+static size_t arena_align(size_t size) {
+  return (size + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+}
+
+// Allocates |size| zeroed bytes from |arena|, or from the heap if |arena| is
+// nullptr.
+static gpointer arena_alloc0(FlValueArena* arena, size_t size) {
+  if (arena == nullptr) {
+    return g_malloc0(size);
+  }
+
+  size = arena_align(size);
+  if (size > arena->remaining) {
+    size_t block_size = MAX(size, kArenaBlockSize);
+    FlValueArenaBlock* block = static_cast<FlValueArenaBlock*>(
+        g_malloc(arena_align(sizeof(FlValueArenaBlock)) + block_size));
+    block->next = arena->blocks;
+    arena->blocks = block;
+    arena->next =
+        reinterpret_cast<uint8_t*>(block) + arena_align(sizeof(*block));
+    arena->remaining = block_size;
+  }
+
+  gpointer result = arena->next;
+  arena->next += size;
+  arena->remaining -= size;
+  memset(result, 0, size);
+  return result;
+}
+
+static FlValue* fl_value_new(FlValueArena* arena,
+                             FlValueType type,
+                             size_t size) {
+  FlValue* self = static_cast<FlValue*>(arena_alloc0(arena, size));
   self->type = type;
   self->ref_count = 1;
+  // Every live value keeps its arena alive.
+  self->arena = arena != nullptr ? fl_value_arena_ref(arena) : nullptr;
   return self;
 }
 
-// Helper function to match GDestroyNotify type.
-static void fl_value_destroy(gpointer value) {
-  fl_value_unref(static_cast<FlValue*>(value));
+// Initializes an empty array with room for |capacity| values.
+static void fl_value_array_init(FlValueArray* array,
+                                FlValueArena* arena,
+                                size_t capacity) {
+  array->values = static_cast<FlValue**>(
+      capacity > 0 ? arena_alloc0(arena, sizeof(FlValue*) * capacity)
+                   : nullptr);
+  array->length = 0;
+  array->capacity = capacity;
+  array->values_on_heap = arena == nullptr;
+}
+
+// Appends |value| to |array|, taking ownership of it.
+static void fl_value_array_add(FlValueArray* array, FlValue* value) {
+  if (array->length == array->capacity) {
+    size_t capacity = MAX(array->capacity * 2, 4);
+    if (array->values_on_heap) {
+      array->values = g_renew(FlValue*, array->values, capacity);
+    } else {
+      FlValue** values = g_new(FlValue*, capacity);
+      if (array->length > 0) {
+        memcpy(values, array->values, sizeof(FlValue*) * array->length);
+      }
+      array->values = values;
+      array->values_on_heap = true;
+    }
+    array->capacity = capacity;
+  }
+  array->values[array->length++] = value;
+}
+
+// Unreferences the values in |array| and frees its storage.
+static void fl_value_array_clear(FlValueArray* array) {
+  for (size_t i = 0; i < array->length; i++) {
+    fl_value_unref(array->values[i]);
+  }
+  if (array->values_on_heap) {
+    g_free(array->values);
+  }
+}
+
+// Frees the elements of a typed list.
+static void fl_value_free_typed_list(FlValue* self,
+                                     gpointer values,
+                                     GBytes* bytes) {
+  if (bytes != nullptr) {
+    g_bytes_unref(bytes);
+  } else if (self->arena == nullptr) {
+    g_free(values);
+  }
 }
 
 // Finds the index of a key in a FlValueMap.
@@ -219,99 +340,140 @@ static void value_to_string(FlValue* value, GString* buffer) {
   }
 }
 
+// Returns the size of the elements of a typed list of |type|.
+static size_t typed_list_element_size(FlValueType type) {
+  switch (type) {
+    case FL_VALUE_TYPE_UINT8_LIST:
+      return sizeof(uint8_t);
+    case FL_VALUE_TYPE_INT32_LIST:
+      return sizeof(int32_t);
+    case FL_VALUE_TYPE_INT64_LIST:
+      return sizeof(int64_t);
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      return sizeof(double);
+    default:
+      return 0;
+  }
+}
+
+// Creates a typed list of |type| with elements in |values|, which points into
+// |bytes| if that is not nullptr.
+static FlValue* fl_value_new_typed_list(FlValueArena* arena,
+                                        FlValueType type,
+                                        gpointer values,
+                                        size_t length,
+                                        GBytes* bytes) {
+  switch (type) {
+    case FL_VALUE_TYPE_UINT8_LIST: {
+      FlValueUint8List* self = reinterpret_cast<FlValueUint8List*>(
+          fl_value_new(arena, type, sizeof(FlValueUint8List)));
+      self->values = static_cast<uint8_t*>(values);
+      self->values_length = length;
+      self->bytes = bytes;
+      return reinterpret_cast<FlValue*>(self);
+    }
+    case FL_VALUE_TYPE_INT32_LIST: {
+      FlValueInt32List* self = reinterpret_cast<FlValueInt32List*>(
+          fl_value_new(arena, type, sizeof(FlValueInt32List)));
+      self->values = static_cast<int32_t*>(values);
+      self->values_length = length;
+      self->bytes = bytes;
+      return reinterpret_cast<FlValue*>(self);
+    }
+    case FL_VALUE_TYPE_INT64_LIST: {
+      FlValueInt64List* self = reinterpret_cast<FlValueInt64List*>(
+          fl_value_new(arena, type, sizeof(FlValueInt64List)));
+      self->values = static_cast<int64_t*>(values);
+      self->values_length = length;
+      self->bytes = bytes;
+      return reinterpret_cast<FlValue*>(self);
+    }
+    case FL_VALUE_TYPE_FLOAT_LIST: {
+      FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(
+          fl_value_new(arena, type, sizeof(FlValueFloatList)));
+      self->values = static_cast<double*>(values);
+      self->values_length = length;
+      self->bytes = bytes;
+      return reinterpret_cast<FlValue*>(self);
+    }
+    default:
+      g_return_val_if_reached(nullptr);
+  }
+}
+
+// Creates a typed list of |type| with a copy of the elements in |data|.
+static FlValue* fl_value_new_typed_list_copy(FlValueArena* arena,
+                                             FlValueType type,
+                                             gconstpointer data,
+                                             size_t length) {
+  size_t size = typed_list_element_size(type) * length;
+  gpointer values = arena != nullptr ? arena_alloc0(arena, size)
+                                     : g_malloc(size);
+  if (size > 0) {
+    memcpy(values, data, size);
+  }
+  return fl_value_new_typed_list(arena, type, values, length, nullptr);
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_null() {
-  return fl_value_new(FL_VALUE_TYPE_NULL, sizeof(FlValue));
+  return fl_value_arena_new_null(nullptr);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_bool(bool value) {
-  FlValueBool* self = reinterpret_cast<FlValueBool*>(
-      fl_value_new(FL_VALUE_TYPE_BOOL, sizeof(FlValueBool)));
-  self->value = value ? true : false;
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_arena_new_bool(nullptr, value);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_int(int64_t value) {
-  FlValueInt* self = reinterpret_cast<FlValueInt*>(
-      fl_value_new(FL_VALUE_TYPE_INT, sizeof(FlValueInt)));
-  self->value = value;
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_arena_new_int(nullptr, value);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_float(double value) {
-  FlValueDouble* self = reinterpret_cast<FlValueDouble*>(
-      fl_value_new(FL_VALUE_TYPE_FLOAT, sizeof(FlValueDouble)));
-  self->value = value;
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_arena_new_float(nullptr, value);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_string(const gchar* value) {
   FlValueString* self = reinterpret_cast<FlValueString*>(
-      fl_value_new(FL_VALUE_TYPE_STRING, sizeof(FlValueString)));
+      fl_value_new(nullptr, FL_VALUE_TYPE_STRING, sizeof(FlValueString)));
   self->value = g_strdup(value);
   return reinterpret_cast<FlValue*>(self);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_string_sized(const gchar* value,
                                                    size_t value_length) {
-  FlValueString* self = reinterpret_cast<FlValueString*>(
-      fl_value_new(FL_VALUE_TYPE_STRING, sizeof(FlValueString)));
-  self->value =
-      value_length == 0 ? g_strdup("") : g_strndup(value, value_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_arena_new_string_sized(nullptr, value, value_length);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_uint8_list(const uint8_t* data,
                                                  size_t data_length) {
-  FlValueUint8List* self = reinterpret_cast<FlValueUint8List*>(
-      fl_value_new(FL_VALUE_TYPE_UINT8_LIST, sizeof(FlValueUint8List)));
-  self->values_length = data_length;
-  self->values = static_cast<uint8_t*>(g_malloc(sizeof(uint8_t) * data_length));
-  memcpy(self->values, data, sizeof(uint8_t) * data_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_typed_list_copy(nullptr, FL_VALUE_TYPE_UINT8_LIST, data,
+                                      data_length);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_uint8_list_from_bytes(GBytes* data) {
-  gsize length;
-  const uint8_t* d =
-      static_cast<const uint8_t*>(g_bytes_get_data(data, &length));
-  return fl_value_new_uint8_list(d, length);
+  return fl_value_arena_new_typed_list(nullptr, FL_VALUE_TYPE_UINT8_LIST, data,
+                                       0, g_bytes_get_size(data));
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_int32_list(const int32_t* data,
                                                  size_t data_length) {
-  FlValueInt32List* self = reinterpret_cast<FlValueInt32List*>(
-      fl_value_new(FL_VALUE_TYPE_INT32_LIST, sizeof(FlValueInt32List)));
-  self->values_length = data_length;
-  self->values = static_cast<int32_t*>(g_malloc(sizeof(int32_t) * data_length));
-  memcpy(self->values, data, sizeof(int32_t) * data_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_typed_list_copy(nullptr, FL_VALUE_TYPE_INT32_LIST, data,
+                                      data_length);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_int64_list(const int64_t* data,
                                                  size_t data_length) {
-  FlValueInt64List* self = reinterpret_cast<FlValueInt64List*>(
-      fl_value_new(FL_VALUE_TYPE_INT64_LIST, sizeof(FlValueInt64List)));
-  self->values_length = data_length;
-  self->values = static_cast<int64_t*>(g_malloc(sizeof(int64_t) * data_length));
-  memcpy(self->values, data, sizeof(int64_t) * data_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_typed_list_copy(nullptr, FL_VALUE_TYPE_INT64_LIST, data,
+                                      data_length);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_float_list(const double* data,
                                                  size_t data_length) {
-  FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(
-      fl_value_new(FL_VALUE_TYPE_FLOAT_LIST, sizeof(FlValueFloatList)));
-  self->values_length = data_length;
-  self->values = static_cast<double*>(g_malloc(sizeof(double) * data_length));
-  memcpy(self->values, data, sizeof(double) * data_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_typed_list_copy(nullptr, FL_VALUE_TYPE_FLOAT_LIST, data,
+                                      data_length);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_list() {
-  FlValueList* self = reinterpret_cast<FlValueList*>(
-      fl_value_new(FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
-  self->values = g_ptr_array_new_with_free_func(fl_value_destroy);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_arena_new_list(nullptr, 0);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_list_from_strv(
@@ -325,11 +487,7 @@ G_MODULE_EXPORT FlValue* fl_value_new_list_from_strv(
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_map() {
-  FlValueMap* self = reinterpret_cast<FlValueMap*>(
-      fl_value_new(FL_VALUE_TYPE_MAP, sizeof(FlValueMap)));
-  self->keys = g_ptr_array_new_with_free_func(fl_value_destroy);
-  self->values = g_ptr_array_new_with_free_func(fl_value_destroy);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_arena_new_map(nullptr, 0);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_ref(FlValue* self) {
@@ -349,38 +507,40 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
   switch (self->type) {
     case FL_VALUE_TYPE_STRING: {
       FlValueString* v = reinterpret_cast<FlValueString*>(self);
-      g_free(v->value);
+      if (self->arena == nullptr) {
+        g_free(v->value);
+      }
       break;
     }
     case FL_VALUE_TYPE_UINT8_LIST: {
       FlValueUint8List* v = reinterpret_cast<FlValueUint8List*>(self);
-      g_free(v->values);
+      fl_value_free_typed_list(self, v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_INT32_LIST: {
       FlValueInt32List* v = reinterpret_cast<FlValueInt32List*>(self);
-      g_free(v->values);
+      fl_value_free_typed_list(self, v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_INT64_LIST: {
       FlValueInt64List* v = reinterpret_cast<FlValueInt64List*>(self);
-      g_free(v->values);
+      fl_value_free_typed_list(self, v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_FLOAT_LIST: {
       FlValueFloatList* v = reinterpret_cast<FlValueFloatList*>(self);
-      g_free(v->values);
+      fl_value_free_typed_list(self, v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_LIST: {
       FlValueList* v = reinterpret_cast<FlValueList*>(self);
-      g_ptr_array_unref(v->values);
+      fl_value_array_clear(&v->values);
       break;
     }
     case FL_VALUE_TYPE_MAP: {
       FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
-      g_ptr_array_unref(v->keys);
-      g_ptr_array_unref(v->values);
+      fl_value_array_clear(&v->keys);
+      fl_value_array_clear(&v->values);
       break;
     }
     case FL_VALUE_TYPE_NULL:
@@ -389,7 +549,11 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     case FL_VALUE_TYPE_FLOAT:
       break;
   }
-  g_free(self);
+  if (self->arena != nullptr) {
+    fl_value_arena_unref(self->arena);
+  } else {
+    g_free(self);
+  }
 }
 
 G_MODULE_EXPORT FlValueType fl_value_get_type(FlValue* self) {
@@ -517,7 +681,7 @@ G_MODULE_EXPORT void fl_value_append_take(FlValue* self, FlValue* value) {
   g_return_if_fail(value != nullptr);
 
   FlValueList* v = reinterpret_cast<FlValueList*>(self);
-  g_ptr_array_add(v->values, value);
+  fl_value_array_add(&v->values, value);
 }
 
 G_MODULE_EXPORT void fl_value_set(FlValue* self, FlValue* key, FlValue* value) {
@@ -540,13 +704,13 @@ G_MODULE_EXPORT void fl_value_set_take(FlValue* self,
   FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
   ssize_t index = fl_value_lookup_index(self, key);
   if (index < 0) {
-    g_ptr_array_add(v->keys, key);
-    g_ptr_array_add(v->values, value);
+    fl_value_array_add(&v->keys, key);
+    fl_value_array_add(&v->values, value);
   } else {
-    fl_value_destroy(v->keys->pdata[index]);
-    v->keys->pdata[index] = key;
-    fl_value_destroy(v->values->pdata[index]);
-    v->values->pdata[index] = value;
+    fl_value_unref(v->keys.values[index]);
+    v->keys.values[index] = key;
+    fl_value_unref(v->values.values[index]);
+    v->values.values[index] = value;
   }
 }
 
@@ -657,11 +821,11 @@ G_MODULE_EXPORT size_t fl_value_get_length(FlValue* self) {
     }
     case FL_VALUE_TYPE_LIST: {
       FlValueList* v = reinterpret_cast<FlValueList*>(self);
-      return v->values->len;
+      return v->values.length;
     }
     case FL_VALUE_TYPE_MAP: {
       FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
-      return v->keys->len;
+      return v->keys.length;
     }
     case FL_VALUE_TYPE_NULL:
     case FL_VALUE_TYPE_BOOL:
@@ -679,7 +843,7 @@ G_MODULE_EXPORT FlValue* fl_value_get_list_value(FlValue* self, size_t index) {
   g_return_val_if_fail(self->type == FL_VALUE_TYPE_LIST, nullptr);
 
   FlValueList* v = reinterpret_cast<FlValueList*>(self);
-  return static_cast<FlValue*>(g_ptr_array_index(v->values, index));
+  return v->values.values[index];
 }
 
 G_MODULE_EXPORT FlValue* fl_value_get_map_key(FlValue* self, size_t index) {
@@ -687,7 +851,7 @@ G_MODULE_EXPORT FlValue* fl_value_get_map_key(FlValue* self, size_t index) {
   g_return_val_if_fail(self->type == FL_VALUE_TYPE_MAP, nullptr);
 
   FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
-  return static_cast<FlValue*>(g_ptr_array_index(v->keys, index));
+  return v->keys.values[index];
 }
 
 G_MODULE_EXPORT FlValue* fl_value_get_map_value(FlValue* self, size_t index) {
@@ -695,7 +859,7 @@ G_MODULE_EXPORT FlValue* fl_value_get_map_value(FlValue* self, size_t index) {
   g_return_val_if_fail(self->type == FL_VALUE_TYPE_MAP, nullptr);
 
   FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
-  return static_cast<FlValue*>(g_ptr_array_index(v->values, index));
+  return v->values.values[index];
 }
 
 G_MODULE_EXPORT FlValue* fl_value_lookup(FlValue* self, FlValue* key) {
@@ -725,3 +889,113 @@ G_MODULE_EXPORT gchar* fl_value_to_string(FlValue* value) {
   value_to_string(value, buffer);
   return g_string_free(buffer, FALSE);
 }
+
+FlValueArena* fl_value_arena_new(size_t size_hint) {
+  size_hint = arena_align(size_hint);
+  FlValueArena* self = static_cast<FlValueArena*>(
+      g_malloc(arena_align(sizeof(FlValueArena)) + size_hint));
+  self->ref_count = 1;
+  self->blocks = nullptr;
+  self->next = reinterpret_cast<uint8_t*>(self) + arena_align(sizeof(*self));
+  self->remaining = size_hint;
+  return self;
+}
+
+FlValueArena* fl_value_arena_ref(FlValueArena* self) {
+  g_return_val_if_fail(self != nullptr, nullptr);
+  self->ref_count++;
+  return self;
+}
+
+void fl_value_arena_unref(FlValueArena* self) {
+  g_return_if_fail(self != nullptr);
+  g_return_if_fail(self->ref_count > 0);
+  self->ref_count--;
+  if (self->ref_count != 0) {
+    return;
+  }
+
+  FlValueArenaBlock* block = self->blocks;
+  while (block != nullptr) {
+    FlValueArenaBlock* next = block->next;
+    g_free(block);
+    block = next;
+  }
+  g_free(self);
+}
+
+FlValue* fl_value_arena_new_null(FlValueArena* arena) {
+  return fl_value_new(arena, FL_VALUE_TYPE_NULL, sizeof(FlValue));
+}
+
+FlValue* fl_value_arena_new_bool(FlValueArena* arena, bool value) {
+  FlValueBool* self = reinterpret_cast<FlValueBool*>(
+      fl_value_new(arena, FL_VALUE_TYPE_BOOL, sizeof(FlValueBool)));
+  self->value = value ? true : false;
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_int(FlValueArena* arena, int64_t value) {
+  FlValueInt* self = reinterpret_cast<FlValueInt*>(
+      fl_value_new(arena, FL_VALUE_TYPE_INT, sizeof(FlValueInt)));
+  self->value = value;
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_float(FlValueArena* arena, double value) {
+  FlValueDouble* self = reinterpret_cast<FlValueDouble*>(
+      fl_value_new(arena, FL_VALUE_TYPE_FLOAT, sizeof(FlValueDouble)));
+  self->value = value;
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_string_sized(FlValueArena* arena,
+                                         const gchar* value,
+                                         size_t value_length) {
+  FlValueString* self = reinterpret_cast<FlValueString*>(
+      fl_value_new(arena, FL_VALUE_TYPE_STRING, sizeof(FlValueString)));
+  if (arena == nullptr) {
+    self->value =
+        value_length == 0 ? g_strdup("") : g_strndup(value, value_length);
+  } else {
+    // The arena memory is zeroed, so the copy is nul terminated.
+    self->value =
+        static_cast<gchar*>(arena_alloc0(arena, value_length + 1));
+    memcpy(self->value, value, value_length);
+  }
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_typed_list(FlValueArena* arena,
+                                       FlValueType type,
+                                       GBytes* data,
+                                       size_t offset,
+                                       size_t length) {
+  size_t element_size = typed_list_element_size(type);
+  g_return_val_if_fail(element_size > 0, nullptr);
+  g_return_val_if_fail(offset + element_size * length <= g_bytes_get_size(data),
+                       nullptr);
+
+  const uint8_t* values =
+      static_cast<const uint8_t*>(g_bytes_get_data(data, nullptr)) + offset;
+  if (reinterpret_cast<uintptr_t>(values) % element_size != 0) {
+    return fl_value_new_typed_list_copy(arena, type, values, length);
+  }
+  return fl_value_new_typed_list(arena, type, const_cast<uint8_t*>(values),
+                                 length, g_bytes_ref(data));
+}
+
+FlValue* fl_value_arena_new_list(FlValueArena* arena, size_t capacity) {
+  FlValueList* self = reinterpret_cast<FlValueList*>(
+      fl_value_new(arena, FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
+  fl_value_array_init(&self->values, arena, capacity);
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_map(FlValueArena* arena, size_t capacity) {
+  FlValueMap* self = reinterpret_cast<FlValueMap*>(
+      fl_value_new(arena, FL_VALUE_TYPE_MAP, sizeof(FlValueMap)));
+  fl_value_array_init(&self->keys, arena, capacity);
+  fl_value_array_init(&self->values, arena, capacity);
+  return reinterpret_cast<FlValue*>(self);
+}
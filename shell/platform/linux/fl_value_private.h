@@ -0,0 +1,164 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+
+G_BEGIN_DECLS
+
+/**
+ * FlValueArena:
+ *
+ * #FlValueArena is a block of memory that #FlValue objects can be allocated
+ * from. The memory is freed in one go once the arena and every value that was
+ * allocated from it have been unreferenced, which makes building and freeing
+ * a tree of values much cheaper than allocating each value separately.
+ *
+ * Values allocated from an arena behave exactly like other values. Note that
+ * holding a reference to any one of them keeps the memory of the whole arena
+ * alive.
+ */
+typedef struct _FlValueArena FlValueArena;
+
+/**
+ * fl_value_arena_new:
+ * @size_hint: the number of bytes expected to be allocated from the arena.
+ *
+ * Creates a new arena. Allocations that don't fit into @size_hint bytes are
+ * made from additional blocks.
+ *
+ * Returns: a new #FlValueArena.
+ */
+FlValueArena* fl_value_arena_new(size_t size_hint);
+
+/**
+ * fl_value_arena_ref:
+ * @arena: an #FlValueArena.
+ *
+ * Increases the reference count of an #FlValueArena.
+ *
+ * Returns: the arena that was referenced.
+ */
+FlValueArena* fl_value_arena_ref(FlValueArena* arena);
+
+/**
+ * fl_value_arena_unref:
+ * @arena: an #FlValueArena.
+ *
+ * Decreases the reference count of an #FlValueArena. The memory of the arena
+ * is freed once neither the arena nor any value allocated from it is
+ * referenced.
+ */
+void fl_value_arena_unref(FlValueArena* arena);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(FlValueArena, fl_value_arena_unref)
+
+/**
+ * fl_value_arena_new_null:
+ * @arena: (allow-none): an #FlValueArena or %NULL to allocate from the heap.
+ *
+ * Creates an #FlValue of type #FL_VALUE_TYPE_NULL in @arena.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_null(FlValueArena* arena);
+
+/**
+ * fl_value_arena_new_bool:
+ * @arena: (allow-none): an #FlValueArena or %NULL to allocate from the heap.
+ * @value: the value.
+ *
+ * Creates an #FlValue of type #FL_VALUE_TYPE_BOOL in @arena.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_bool(FlValueArena* arena, bool value);
+
+/**
+ * fl_value_arena_new_int:
+ * @arena: (allow-none): an #FlValueArena or %NULL to allocate from the heap.
+ * @value: the value.
+ *
+ * Creates an #FlValue of type #FL_VALUE_TYPE_INT in @arena.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_int(FlValueArena* arena, int64_t value);
+
+/**
+ * fl_value_arena_new_float:
+ * @arena: (allow-none): an #FlValueArena or %NULL to allocate from the heap.
+ * @value: the value.
+ *
+ * Creates an #FlValue of type #FL_VALUE_TYPE_FLOAT in @arena.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_float(FlValueArena* arena, double value);
+
+/**
+ * fl_value_arena_new_string_sized:
+ * @arena: (allow-none): an #FlValueArena or %NULL to allocate from the heap.
+ * @value: a buffer containing UTF-8 text. It does not require a nul terminator.
+ * @value_length: the number of bytes to use from @value.
+ *
+ * Creates an #FlValue of type #FL_VALUE_TYPE_STRING in @arena. The text is
+ * copied into @arena too.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_string_sized(FlValueArena* arena,
+                                         const gchar* value,
+                                         size_t value_length);
+
+/**
+ * fl_value_arena_new_typed_list:
+ * @arena: (allow-none): an #FlValueArena or %NULL to allocate from the heap.
+ * @type: one of #FL_VALUE_TYPE_UINT8_LIST, #FL_VALUE_TYPE_INT32_LIST,
+ * #FL_VALUE_TYPE_INT64_LIST or #FL_VALUE_TYPE_FLOAT_LIST.
+ * @data: the bytes the list is read from.
+ * @offset: the offset of the first element in @data.
+ * @length: the number of elements in the list.
+ *
+ * Creates a typed list whose elements are read from @data. If the elements are
+ * suitably aligned the list references @data instead of copying them.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_typed_list(FlValueArena* arena,
+                                       FlValueType type,
+                                       GBytes* data,
+                                       size_t offset,
+                                       size_t length);
+
+/**
+ * fl_value_arena_new_list:
+ * @arena: (allow-none): an #FlValueArena or %NULL to allocate from the heap.
+ * @capacity: the number of values expected to be appended to the list.
+ *
+ * Creates an empty #FlValue of type #FL_VALUE_TYPE_LIST with room for
+ * @capacity values in @arena. The list grows on the heap if more values are
+ * added.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_list(FlValueArena* arena, size_t capacity);
+
+/**
+ * fl_value_arena_new_map:
+ * @arena: (allow-none): an #FlValueArena or %NULL to allocate from the heap.
+ * @capacity: the number of entries expected to be set in the map.
+ *
+ * Creates an empty #FlValue of type #FL_VALUE_TYPE_MAP with room for @capacity
+ * entries in @arena. The map grows on the heap if more entries are added.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_map(FlValueArena* arena, size_t capacity);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
@@ -54,7 +54,15 @@ class TextInputPlugin : public KeyboardHookHandler {
 
  private:
   // Sends the current state of the given model to the Flutter engine.
-  void SendStateUpdate(const TextInputModel& model);
+  //
+  // If the client enabled the delta model, the state is sent as a delta, see
+  // |SendDeltaStateUpdate|.
+  void SendStateUpdate(TextInputModel* model);
+
+  // Sends the selection of the given model to the Flutter engine, along with
+  // the range of the text that changed since the last update and the text that
+  // range held before and holds now, but not the rest of the text.
+  void SendDeltaStateUpdate(TextInputModel* model);
 
   // Sends an action triggered by the Enter key to the Flutter engine.
   void EnterPressed(TextInputModel* model);
@@ -60,4 +60,25 @@ void main() {
       );
     }
   });
+
+  test('updates paint styles of a laid out paragraph', () {
+    Paragraph build(String text, Color color) {
+      final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+        fontFamily: 'Ahem',
+        fontSize: 10.0,
+      ));
+      builder.pushStyle(TextStyle(color: color));
+      builder.addText(text);
+      return builder.build();
+    }
+
+    final Paragraph paragraph = build('Test', const Color(0xFF000000));
+    paragraph.layout(const ParagraphConstraints(width: 400.0));
+
+    expect(paragraph.updatePaintStyles(build('Test', const Color(0xFFFF0000))), isTrue);
+    expect(paragraph.height, closeTo(10.0, 0.001));
+    expect(paragraph.maxIntrinsicWidth, closeTo(40.0, 0.001));
+
+    expect(paragraph.updatePaintStyles(build('Other', const Color(0xFFFF0000))), isFalse);
+  });
 }
@@ -565,7 +565,7 @@ AXNodeTextStyles AXNodeData::GetTextStyles() const {
   return style_attributes;
 }
 
-void AXNodeData::SetName(const std::string& name) {
+void AXNodeData::SetName(std::string name) {
   if (role == ax::mojom::Role::kNone) {
     BASE_LOG()
         << "A valid role is required before setting the name attribute, "
@@ -582,9 +582,9 @@ void AXNodeData::SetName(const std::string& name) {
 
   if (iter == string_attributes.end()) {
     string_attributes.push_back(
-        std::make_pair(ax::mojom::StringAttribute::kName, name));
+        std::make_pair(ax::mojom::StringAttribute::kName, std::move(name)));
   } else {
-    iter->second = name;
+    iter->second = std::move(name);
   }
 
   if (HasIntAttribute(ax::mojom::IntAttribute::kNameFrom))
@@ -624,8 +624,11 @@ void AXNodeData::SetDescription(const std::u16string& description) {
   SetDescription(base::UTF16ToUTF8(description));
 }
 
-void AXNodeData::SetValue(const std::string& value) {
-  AddStringAttribute(ax::mojom::StringAttribute::kValue, value);
+void AXNodeData::SetValue(std::string value) {
+  if (HasStringAttribute(ax::mojom::StringAttribute::kValue))
+    RemoveStringAttribute(ax::mojom::StringAttribute::kValue);
+  string_attributes.push_back(
+      std::make_pair(ax::mojom::StringAttribute::kValue, std::move(value)));
 }
 
 void AXNodeData::SetValue(const std::u16string& value) {
@@ -139,7 +139,7 @@ struct AX_BASE_EXPORT AXNodeData {
 
   // Adds the name attribute or replaces it if already present. Also sets the
   // NameFrom attribute if not already set.
-  void SetName(const std::string& name);
+  void SetName(std::string name);
   void SetName(const std::u16string& name);
 
   // Allows nameless objects to pass accessibility checks.
@@ -150,7 +150,7 @@ struct AX_BASE_EXPORT AXNodeData {
   void SetDescription(const std::u16string& description);
 
   // Adds the value attribute or replaces it if already present.
-  void SetValue(const std::string& value);
+  void SetValue(std::string value);
   void SetValue(const std::u16string& value);
 
   // Returns true if the given enum bit is 1.
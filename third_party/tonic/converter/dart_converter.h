@@ -5,6 +5,7 @@
 #ifndef LIB_CONVERTER_TONIC_DART_CONVERTER_H_
 #define LIB_CONVERTER_TONIC_DART_CONVERTER_H_
 
+#include <cstdint>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -358,6 +359,34 @@ struct DartListFactory {
   }
 };
 
+// The type of typed data whose elements have the same representation as |T|,
+// or Dart_TypedData_kInvalid if there is none.
+template <typename T>
+constexpr Dart_TypedData_Type TypedDataTypeOf() {
+  if constexpr (std::is_same<int8_t, T>::value) {
+    return Dart_TypedData_kInt8;
+  } else if constexpr (std::is_same<uint8_t, T>::value) {
+    return Dart_TypedData_kUint8;
+  } else if constexpr (std::is_same<int16_t, T>::value) {
+    return Dart_TypedData_kInt16;
+  } else if constexpr (std::is_same<uint16_t, T>::value) {
+    return Dart_TypedData_kUint16;
+  } else if constexpr (std::is_same<int32_t, T>::value) {
+    return Dart_TypedData_kInt32;
+  } else if constexpr (std::is_same<uint32_t, T>::value) {
+    return Dart_TypedData_kUint32;
+  } else if constexpr (std::is_same<int64_t, T>::value) {
+    return Dart_TypedData_kInt64;
+  } else if constexpr (std::is_same<uint64_t, T>::value) {
+    return Dart_TypedData_kUint64;
+  } else if constexpr (std::is_same<float, T>::value) {
+    return Dart_TypedData_kFloat32;
+  } else if constexpr (std::is_same<double, T>::value) {
+    return Dart_TypedData_kFloat64;
+  }
+  return Dart_TypedData_kInvalid;
+}
+
 template <typename T>
 struct DartConverter<std::vector<T>> {
   using ValueType = typename DartConverterTypes<T>::ValueType;
@@ -385,6 +414,25 @@ struct DartConverter<std::vector<T>> {
   static std::vector<ValueType> FromDart(Dart_Handle handle) {
     std::vector<ValueType> result;
 
+    // Typed data with the same representation as the values is copied as a
+    // whole rather than converting each element.
+    if constexpr (std::is_same<ValueType, ConverterType>::value &&
+                  TypedDataTypeOf<ValueType>() != Dart_TypedData_kInvalid) {
+      if (Dart_GetTypeOfTypedData(handle) == TypedDataTypeOf<ValueType>()) {
+        Dart_TypedData_Type type;
+        void* data = nullptr;
+        intptr_t length = 0;
+        Dart_Handle acquire_result =
+            Dart_TypedDataAcquireData(handle, &type, &data, &length);
+        if (!LogIfError(acquire_result)) {
+          const ValueType* values = static_cast<const ValueType*>(data);
+          result.assign(values, values + length);
+          Dart_TypedDataReleaseData(handle);
+        }
+        return result;
+      }
+    }
+
     if (!Dart_IsList(handle))
       return result;
 
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/testing/dart_isolate_runner.h"
+#include "flutter/testing/fixture_test.h"
+#include "third_party/tonic/converter/dart_converter.h"
+#include "third_party/tonic/typed_data/typed_list.h"
+
+namespace flutter {
+namespace testing {
+
+class DartConverterTest : public FixtureTest {
+ public:
+  DartConverterTest()
+      : settings_(CreateSettingsForFixture()),
+        vm_(DartVMRef::Create(settings_)) {}
+
+  ~DartConverterTest() = default;
+
+  [[nodiscard]] bool RunInIsolateScope(std::function<bool(void)> closure) {
+    auto thread = CreateNewThread();
+    TaskRunners single_threaded_task_runner(GetCurrentTestName(), thread,
+                                            thread, thread, thread);
+    auto isolate =
+        RunDartCodeInIsolate(vm_, settings_, single_threaded_task_runner,
+                             "main", {}, GetFixturesPath());
+    if (!isolate || isolate->get()->GetPhase() != DartIsolate::Phase::Running) {
+      return false;
+    }
+    return isolate->RunInIsolateScope(closure);
+  }
+
+ private:
+  Settings settings_;
+  DartVMRef vm_;
+  FML_DISALLOW_COPY_AND_ASSIGN(DartConverterTest);
+};
+
+namespace {
+
+template <typename T>
+Dart_Handle NewTypedData(Dart_TypedData_Type type,
+                         const std::vector<T>& values) {
+  Dart_Handle list = Dart_NewTypedData(type, values.size());
+  Dart_TypedData_Type acquired_type;
+  void* data = nullptr;
+  intptr_t length = 0;
+  Dart_TypedDataAcquireData(list, &acquired_type, &data, &length);
+  std::memcpy(data, values.data(), values.size() * sizeof(T));
+  Dart_TypedDataReleaseData(list);
+  return list;
+}
+
+}  // namespace
+
+TEST_F(DartConverterTest, VectorFromTypedData) {
+  ASSERT_TRUE(RunInIsolateScope([]() -> bool {
+    const std::vector<int32_t> ints = {1, -2, 3, 1 << 30};
+    EXPECT_EQ(tonic::DartConverter<std::vector<int32_t>>::FromDart(
+                  NewTypedData(Dart_TypedData_kInt32, ints)),
+              ints);
+
+    const std::vector<double> doubles = {0.5, -1.25, 1e100};
+    EXPECT_EQ(tonic::DartConverter<std::vector<double>>::FromDart(
+                  NewTypedData(Dart_TypedData_kFloat64, doubles)),
+              doubles);
+
+    // Typed data of another type is converted element by element.
+    const std::vector<uint8_t> bytes = {0, 1, 255};
+    EXPECT_EQ(tonic::DartConverter<std::vector<int32_t>>::FromDart(
+                  NewTypedData(Dart_TypedData_kUint8, bytes)),
+              std::vector<int32_t>({0, 1, 255}));
+    return true;
+  }));
+}
+
+TEST_F(DartConverterTest, VectorFromList) {
+  ASSERT_TRUE(RunInIsolateScope([]() -> bool {
+    const std::vector<int64_t> values = {1, -2, int64_t{1} << 40};
+    Dart_Handle list =
+        tonic::DartConverter<std::vector<int64_t>>::ToDart(values);
+    EXPECT_FALSE(Dart_IsTypedData(list));
+    EXPECT_EQ(tonic::DartConverter<std::vector<int64_t>>::FromDart(list),
+              values);
+    return true;
+  }));
+}
+
+TEST_F(DartConverterTest, TypedListIsIterable) {
+  ASSERT_TRUE(RunInIsolateScope([]() -> bool {
+    const std::vector<float> values = {1, 2, 3};
+    tonic::Float32List list(NewTypedData(Dart_TypedData_kFloat32, values));
+    EXPECT_EQ(std::vector<float>(list.begin(), list.end()), values);
+    return true;
+  }));
+}
+
+}  // namespace testing
+}  // namespace flutter
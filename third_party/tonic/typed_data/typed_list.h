@@ -39,6 +39,10 @@ class TypedList {
 
   const ElemType* data() const { return data_; }
   intptr_t num_elements() const { return num_elements_; }
+
+  // The elements, which are borrowed from Dart until the list is released.
+  const ElemType* begin() const { return data_; }
+  const ElemType* end() const { return data_ + num_elements_; }
   Dart_Handle dart_handle() const { return dart_handle_; }
 
   void Release();
@@ -17,8 +17,10 @@
 #include <minikin/Layout.h>
 
 #include <cstring>
+#include <string>
 
 #include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
 #include "flutter/third_party/txt/tests/txt_test_utils.h"
 #include "minikin/LayoutUtils.h"
@@ -28,6 +30,7 @@
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
 #include "txt/font_collection.h"
+#include "txt/font_coverage_cache.h"
 #include "txt/font_skia.h"
 #include "txt/font_style.h"
 #include "txt/font_weight.h"
@@ -119,6 +122,106 @@ BENCHMARK_F(ParagraphFixture, LongLayout)(benchmark::State& state) {
   }
 }
 
+// Lays out a long paragraph after every keystroke of an edit that retypes one
+// of its words. Only the edited word should miss the layout cache.
+BENCHMARK_DEFINE_F(ParagraphFixture, EditLongLayout)(benchmark::State& state) {
+  const char* text =
+      "This is a very long sentence to test if the text will properly wrap "
+      "around and go to the next line. Sometimes, short sentence. Longer "
+      "sentences are okay too because they are necessary. Very short. "
+      "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+      "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim "
+      "veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea "
+      "commodo consequat. Duis aute irure dolor in reprehenderit in voluptate "
+      "velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint "
+      "occaecat cupidatat non proident, sunt in culpa qui officia deserunt "
+      "mollit anim id est laborum.";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+  if (state.range(0)) {
+    text_style.font_features.SetFeature("tnum", 1);
+  }
+
+  // Retype the word "dolore" one letter at a time.
+  const size_t edit_start = u16_text.find(u"dolore");
+  const std::u16string word = u"dolore";
+
+  minikin::Layout::purgeCaches();
+  size_t keystroke = 0;
+  while (state.KeepRunning()) {
+    std::u16string edited_text = u16_text;
+    edited_text.replace(edit_start, word.size(),
+                        word.substr(0, keystroke % (word.size() + 1)));
+    keystroke++;
+
+    txt::ParagraphBuilderTxt builder(paragraph_style, font_collection_);
+    builder.PushStyle(text_style);
+    builder.AddText(edited_text);
+    builder.Pop();
+    auto paragraph = BuildParagraph(builder);
+    paragraph->Layout(300);
+  }
+
+  const auto stats = minikin::Layout::getCacheStats();
+  state.counters["CacheHitRate"] =
+      static_cast<double>(stats.hits) / (stats.hits + stats.misses);
+}
+BENCHMARK_REGISTER_F(ParagraphFixture, EditLongLayout)->Arg(false)->Arg(true);
+
+// Lays out the first paragraph of a fresh font collection, which loads its
+// fonts and computes their coverage. With the coverage cache, the coverage is
+// read from the files written by an earlier run instead.
+BENCHMARK_DEFINE_F(ParagraphFixture, FirstLayout)(benchmark::State& state) {
+  auto icu_text = icu::UnicodeString::fromUTF8("Hello World");
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+
+  fml::ScopedTemporaryDirectory cache_directory;
+  if (state.range(0)) {
+    minikin::FontFamily::setCoverageCache(std::make_shared<FontCoverageCache>(
+        std::make_shared<fml::UniqueFD>(
+            fml::OpenDirectory(cache_directory.path().c_str(), false,
+                               fml::FilePermission::kReadWrite)),
+        nullptr));
+    // Write the cache files in an earlier "run".
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    BuildParagraph(builder)->Layout(300);
+  }
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::shared_ptr<FontCollection> font_collection = GetTestFontCollection();
+    minikin::Layout::purgeCaches();
+    state.ResumeTiming();
+
+    txt::ParagraphBuilderTxt builder(paragraph_style, font_collection);
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    auto paragraph = BuildParagraph(builder);
+    paragraph->Layout(300);
+  }
+
+  minikin::FontFamily::setCoverageCache(nullptr);
+}
+BENCHMARK_REGISTER_F(ParagraphFixture, FirstLayout)->Arg(false)->Arg(true);
+
 BENCHMARK_F(ParagraphFixture, JustifyLayout)(benchmark::State& state) {
   const char* text =
       "This is a very long sentence to test if the text will properly wrap "
@@ -245,6 +348,83 @@ BENCHMARK_REGISTER_F(ParagraphFixture, StylesBigO)
     ->Range(1 << 3, 1 << 12)
     ->Complexity(benchmark::oN);
 
+// Builds a paragraph of |line_count| short lines, like a log viewer would.
+static std::unique_ptr<ParagraphTxt> BuildManyLinesParagraph(
+    std::shared_ptr<FontCollection> font_collection,
+    int64_t line_count) {
+  std::u16string u16_text;
+  for (int64_t i = 0; i < line_count; ++i) {
+    std::string line = "Log entry " + std::to_string(i) + " of the run\n";
+    u16_text.append(line.begin(), line.end());
+  }
+
+  txt::ParagraphStyle paragraph_style;
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+
+  txt::ParagraphBuilderTxt builder(paragraph_style, font_collection);
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(300);
+  return paragraph;
+}
+
+// Hit tests points along a drag over the end of a paragraph with many lines.
+BENCHMARK_DEFINE_F(ParagraphFixture, ManyLinesHitTest)
+(benchmark::State& state) {
+  auto paragraph = BuildManyLinesParagraph(font_collection_, state.range(0));
+  const double height = paragraph->GetHeight();
+  double dx = 0;
+  while (state.KeepRunning()) {
+    dx = dx > 200 ? 0 : dx + 7;
+    benchmark::DoNotOptimize(
+        paragraph->GetGlyphPositionAtCoordinate(dx, height - 5));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK_REGISTER_F(ParagraphFixture, ManyLinesHitTest)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 15)
+    ->Complexity();
+
+// Gets the selection boxes of a range at the end of a paragraph with many
+// lines.
+BENCHMARK_DEFINE_F(ParagraphFixture, ManyLinesRectsForRange)
+(benchmark::State& state) {
+  auto paragraph = BuildManyLinesParagraph(font_collection_, state.range(0));
+  const size_t end = paragraph->GetLineMetrics().back().end_index;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(paragraph->GetRectsForRange(
+        end - 40, end, Paragraph::RectHeightStyle::kMax,
+        Paragraph::RectWidthStyle::kTight));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK_REGISTER_F(ParagraphFixture, ManyLinesRectsForRange)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 15)
+    ->Complexity();
+
+// Finds the word boundaries of a word at the end of a paragraph with many
+// lines, as a double tap would.
+BENCHMARK_DEFINE_F(ParagraphFixture, ManyLinesWordBoundary)
+(benchmark::State& state) {
+  auto paragraph = BuildManyLinesParagraph(font_collection_, state.range(0));
+  const size_t end = paragraph->GetLineMetrics().back().end_index;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(paragraph->GetWordBoundary(end - 3));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK_REGISTER_F(ParagraphFixture, ManyLinesWordBoundary)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 15)
+    ->Complexity();
+
 BENCHMARK_F(ParagraphFixture, PaintSimple)(benchmark::State& state) {
   const char* text = "Hello world! This is a simple sentence to test drawing.";
   auto icu_text = icu::UnicodeString::fromUTF8(text);
@@ -352,6 +532,53 @@ BENCHMARK_F(ParagraphFixture, PaintDecoration)(benchmark::State& state) {
   }
 }
 
+// Animates the color of a laid out paragraph. Without the paint-only update,
+// every frame builds and lays out the paragraph again.
+BENCHMARK_DEFINE_F(ParagraphFixture, ColorAnimation)(benchmark::State& state) {
+  const char* text =
+      "Hello world! This is a simple sentence to test drawing. Hello world! "
+      "This is a simple sentence to test drawing.";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.decoration = TextDecoration::kUnderline;
+  text_style.decoration_style = TextDecorationStyle(kWavy);
+  text_style.color = SK_ColorBLACK;
+
+  txt::ParagraphBuilderTxt builder(paragraph_style, font_collection_);
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(300);
+
+  uint8_t red = 0;
+  while (state.KeepRunning()) {
+    text_style.color = SkColorSetRGB(red++, 0, 0);
+    if (state.range(0)) {
+      txt::StyledRuns runs;
+      runs.AddStyle(paragraph_style.GetTextStyle());
+      runs.StartRun(runs.AddStyle(text_style), 0);
+      runs.EndRunIfNeeded(u16_text.size());
+      paragraph->UpdatePaintStyles(std::move(runs));
+    } else {
+      txt::ParagraphBuilderTxt new_builder(paragraph_style, font_collection_);
+      new_builder.PushStyle(text_style);
+      new_builder.AddText(u16_text);
+      paragraph = BuildParagraph(new_builder);
+      paragraph->Layout(300);
+    }
+    paragraph->Paint(canvas_.get(), 10, 10);
+  }
+}
+BENCHMARK_REGISTER_F(ParagraphFixture, ColorAnimation)
+    ->Arg(false)
+    ->Arg(true);
+
 // -----------------------------------------------------------------------------
 //
 // The following benchmarks break down the layout function and attempts to time
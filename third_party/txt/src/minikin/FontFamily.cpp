@@ -124,6 +124,48 @@ bool FontFamily::analyzeStyle(const std::shared_ptr<MinikinFont>& typeface,
                                  italic);
 }
 
+static std::shared_ptr<FontCoverageCache> gCoverageCache;
+
+// Returns the 64-bit FNV-1a hash of |size| bytes at |data|, which stays the
+// same across runs so that it can be part of a persistent cache key.
+static uint64_t hashBytes(const uint8_t* data, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ data[i]) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+// Identifies a font by the checksum and the creation and modification dates in
+// its 'head' table, and by the size and a hash of the contents of its cmap
+// table. The 'head' table alone can be shared by fonts with different cmaps,
+// like the faces of a collection or fonts subset without rewriting it. Returns
+// an empty key if the font has no 'head' table.
+static std::string coverageCacheKey(const MinikinFont* typeface,
+                                    const uint8_t* cmap,
+                                    size_t cmapSize) {
+  const uint32_t headTag = MinikinFont::MakeTag('h', 'e', 'a', 'd');
+  HbBlob headTable(getFontTable(typeface, headTag));
+  // checkSumAdjustment is at offset 8, created and modified at offset 20.
+  const size_t kChecksumOffset = 8;
+  const size_t kDatesOffset = 20;
+  const size_t kDatesEnd = 36;
+  if (headTable.get() == nullptr || headTable.size() < kDatesEnd) {
+    return "";
+  }
+  const char* head = reinterpret_cast<const char*>(headTable.get());
+  std::string key(head + kChecksumOffset, 4);
+  key.append(head + kDatesOffset, kDatesEnd - kDatesOffset);
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    key.push_back(static_cast<char>((cmapSize >> shift) & 0xFF));
+  }
+  const uint64_t cmapHash = hashBytes(cmap, cmapSize);
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    key.push_back(static_cast<char>((cmapHash >> shift) & 0xFF));
+  }
+  return key;
+}
+
 // Compute a matching metric between two styles - 0 is an exact match
 static int computeMatch(FontStyle style1, FontStyle style2) {
   if (style1 == style2)
@@ -174,6 +216,12 @@ bool FontFamily::isColorEmojiFamily() const {
   return false;
 }
 
+// static
+void FontFamily::setCoverageCache(std::shared_ptr<FontCoverageCache> cache) {
+  std::scoped_lock _l(gMinikinLock);
+  gCoverageCache = std::move(cache);
+}
+
 void FontFamily::computeCoverage() {
   std::scoped_lock _l(gMinikinLock);
   const FontStyle defaultStyle;
@@ -184,8 +232,29 @@ void FontFamily::computeCoverage() {
     ALOGE("Could not get cmap table size!\n");
     return;
   }
-  mCoverage = CmapCoverage::getCoverage(cmapTable.get(), cmapTable.size(),
-                                        &mHasVSTable);
+
+  const std::string cacheKey =
+      gCoverageCache
+          ? coverageCacheKey(typeface, cmapTable.get(), cmapTable.size())
+          : "";
+  const bool cached =
+      !cacheKey.empty() &&
+      gCoverageCache->load(cacheKey, [this](const uint8_t* data, size_t size) {
+        if (size < 1 || data[0] > 1) {
+          return false;
+        }
+        mHasVSTable = data[0] == 1;
+        return mCoverage.readFrom(data + 1, size - 1);
+      });
+  if (!cached) {
+    mCoverage = CmapCoverage::getCoverage(cmapTable.get(), cmapTable.size(),
+                                          &mHasVSTable);
+    if (!cacheKey.empty()) {
+      std::vector<uint8_t> data = {static_cast<uint8_t>(mHasVSTable)};
+      mCoverage.writeTo(&data);
+      gCoverageCache->store(cacheKey, data);
+    }
+  }
 
   for (size_t i = 0; i < mFonts.size(); ++i) {
     std::unordered_set<AxisTag> supportedAxes =
@@ -17,6 +17,7 @@
 #ifndef MINIKIN_FONT_FAMILY_H
 #define MINIKIN_FONT_FAMILY_H
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -130,6 +131,24 @@ struct FontVariation {
   float value;
 };
 
+// A persistent store for the Unicode coverage of font families, so that the
+// cmap tables of fonts that were seen before don't need to be parsed again.
+// Methods are called with the minikin lock held.
+class FontCoverageCache {
+ public:
+  virtual ~FontCoverageCache() = default;
+
+  // Calls |read| with the data stored for |key| and returns its result, or
+  // returns false if nothing is stored for |key|. The data is only valid
+  // during the call.
+  virtual bool load(
+      const std::string& key,
+      const std::function<bool(const uint8_t* data, size_t size)>& read) = 0;
+
+  virtual void store(const std::string& key,
+                     const std::vector<uint8_t>& data) = 0;
+};
+
 class FontFamily {
  public:
   explicit FontFamily(std::vector<Font>&& fonts);
@@ -168,6 +187,10 @@ class FontFamily {
   // 14 subtable).
   bool hasVSTable() const { return mHasVSTable; }
 
+  // Sets the cache used by families created afterwards to look up their
+  // coverage. May be null to compute the coverage of every family again.
+  static void setCoverageCache(std::shared_ptr<FontCoverageCache> cache);
+
   // Creates new FontFamily based on this family while applying font variations.
   // Returns nullptr if none of variations apply to this family.
   std::shared_ptr<FontFamily> createFamilyWithVariation(
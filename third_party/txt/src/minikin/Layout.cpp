@@ -83,6 +83,7 @@ class LayoutCacheKey {
         mLetterSpacing(paint.letterSpacing),
         mPaintFlags(paint.paintFlags),
         mHyphenEdit(paint.hyphenEdit),
+        mFontFeatureSettings(paint.fontFeatureSettings),
         mIsRtl(dir),
         mHash(computeHash()) {}
   bool operator==(const LayoutCacheKey& other) const;
@@ -121,6 +122,7 @@ class LayoutCacheKey {
   float mLetterSpacing;
   int32_t mPaintFlags;
   HyphenEdit mHyphenEdit;
+  std::string mFontFeatureSettings;
   bool mIsRtl;
   // Note: any fields added to MinikinPaint must also be reflected here.
   // TODO: language matching (possibly integrate into style)
@@ -135,13 +137,21 @@ class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
     mCache.setOnEntryRemovedListener(this);
   }
 
-  void clear() { mCache.clear(); }
+  void clear() {
+    mCache.clear();
+    mStats = {};
+  }
+
+  Layout::CacheStats getStats() const { return mStats; }
 
   Layout* get(LayoutCacheKey& key,
               LayoutContext* ctx,
               const std::shared_ptr<FontCollection>& collection) {
     Layout* layout = mCache.get(key);
-    if (layout == NULL) {
+    if (layout != NULL) {
+      mStats.hits++;
+    } else {
+      mStats.misses++;
       key.copyText();
       layout = new Layout();
       key.doLayout(layout, ctx, collection);
@@ -158,6 +168,7 @@ class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
   }
 
   android::LruCache<LayoutCacheKey, Layout*> mCache;
+  Layout::CacheStats mStats = {};
 
   // static const size_t kMaxEntries = LruCache<LayoutCacheKey,
   // Layout*>::kUnlimitedCapacity;
@@ -191,6 +202,7 @@ bool LayoutCacheKey::operator==(const LayoutCacheKey& other) const {
          mScaleX == other.mScaleX && mSkewX == other.mSkewX &&
          mLetterSpacing == other.mLetterSpacing &&
          mPaintFlags == other.mPaintFlags && mHyphenEdit == other.mHyphenEdit &&
+         mFontFeatureSettings == other.mFontFeatureSettings &&
          mIsRtl == other.mIsRtl && mNchars == other.mNchars &&
          !memcmp(mChars, other.mChars, mNchars * sizeof(uint16_t));
 }
@@ -206,6 +218,9 @@ android::hash_t LayoutCacheKey::computeHash() const {
   hash = android::JenkinsHashMix(hash, hash_type(mLetterSpacing));
   hash = android::JenkinsHashMix(hash, hash_type(mPaintFlags));
   hash = android::JenkinsHashMix(hash, hash_type(mHyphenEdit.getHyphen()));
+  hash = android::JenkinsHashMixBytes(
+      hash, reinterpret_cast<const uint8_t*>(mFontFeatureSettings.data()),
+      mFontFeatureSettings.size());
   hash = android::JenkinsHashMix(hash, hash_type(mIsRtl));
   hash = android::JenkinsHashMixShorts(hash, mChars, mNchars);
   return android::JenkinsHashWhiten(hash);
@@ -708,27 +723,14 @@ float Layout::doLayoutWord(const uint16_t* buf,
   float wordSpacing =
       count == 1 && isWordSpace(buf[start]) ? ctx->paint.wordSpacing : 0;
 
-  float advance;
-  if (ctx->paint.skipCache()) {
-    Layout layoutForWord;
-    key.doLayout(&layoutForWord, ctx, collection);
-    if (layout) {
-      layout->appendLayout(&layoutForWord, bufStart, wordSpacing);
-    }
-    if (advances) {
-      layoutForWord.getAdvances(advances);
-    }
-    advance = layoutForWord.getAdvance();
-  } else {
-    Layout* layoutForWord = cache.get(key, ctx, collection);
-    if (layout) {
-      layout->appendLayout(layoutForWord, bufStart, wordSpacing);
-    }
-    if (advances) {
-      layoutForWord->getAdvances(advances);
-    }
-    advance = layoutForWord->getAdvance();
+  Layout* layoutForWord = cache.get(key, ctx, collection);
+  if (layout) {
+    layout->appendLayout(layoutForWord, bufStart, wordSpacing);
+  }
+  if (advances) {
+    layoutForWord->getAdvances(advances);
   }
+  float advance = layoutForWord->getAdvance();
 
   if (wordSpacing != 0) {
     advance += wordSpacing;
@@ -1199,4 +1201,9 @@ void Layout::purgeCaches() {
   purgeHbFontCacheLocked();
 }
 
+Layout::CacheStats Layout::getCacheStats() {
+  std::scoped_lock _l(gMinikinLock);
+  return LayoutEngine::getInstance().layoutCache.getStats();
+}
+
 }  // namespace minikin
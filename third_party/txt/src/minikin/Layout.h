@@ -117,6 +117,14 @@ class Layout {
   // Purge all caches, useful in low memory conditions
   static void purgeCaches();
 
+  // The number of words whose layouts were found in, or had to be added to,
+  // the layout cache since it was last purged.
+  struct CacheStats {
+    size_t hits;
+    size_t misses;
+  };
+  static CacheStats getCacheStats();
+
  private:
   friend class LayoutCacheKey;
 
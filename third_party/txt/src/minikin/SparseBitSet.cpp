@@ -19,6 +19,8 @@
 #include <stddef.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include <log/log.h>
 
 #include <minikin/SparseBitSet.h>
@@ -107,6 +109,80 @@ void SparseBitSet::initFromRanges(const uint32_t* ranges, size_t nRanges) {
   }
 }
 
+// The header of a serialized set. It is followed by the page indices and then
+// by the bitmaps.
+struct SerializedSparseBitSet {
+  uint32_t maxVal;
+  uint32_t nBitmapElements;
+  uint16_t zeroPageIndex;
+};
+
+void SparseBitSet::writeTo(std::vector<uint8_t>* out) const {
+  const uint32_t nIndices = (mMaxVal + kPageMask) >> kLogValuesPerPage;
+  SerializedSparseBitSet header = {};
+  header.maxVal = mMaxVal;
+  header.zeroPageIndex = mMaxVal == 0 ? noZeroPage : mZeroPageIndex;
+  // Every page is referenced by at least one index.
+  for (uint32_t i = 0; i < nIndices; i++) {
+    header.nBitmapElements =
+        std::max(header.nBitmapElements,
+                 mIndices[i] + (1u << (kLogValuesPerPage - kLogBitsPerEl)));
+  }
+
+  const size_t start = out->size();
+  out->resize(start + sizeof(header) + nIndices * sizeof(uint16_t) +
+              header.nBitmapElements * sizeof(element));
+  uint8_t* dst = out->data() + start;
+  memcpy(dst, &header, sizeof(header));
+  dst += sizeof(header);
+  if (nIndices > 0) {
+    memcpy(dst, mIndices.get(), nIndices * sizeof(uint16_t));
+    dst += nIndices * sizeof(uint16_t);
+    memcpy(dst, mBitmaps.get(), header.nBitmapElements * sizeof(element));
+  }
+}
+
+bool SparseBitSet::readFrom(const uint8_t* data, size_t size) {
+  mMaxVal = 0;
+  mIndices.reset();
+  mBitmaps.reset();
+
+  SerializedSparseBitSet header;
+  if (size < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (header.maxVal >= kMaximumCapacity) {
+    return false;
+  }
+  const uint32_t nIndices = (header.maxVal + kPageMask) >> kLogValuesPerPage;
+  if (size != sizeof(header) + nIndices * sizeof(uint16_t) +
+                  header.nBitmapElements * sizeof(element)) {
+    return false;
+  }
+  if (nIndices == 0) {
+    return true;
+  }
+
+  std::unique_ptr<uint16_t[]> indices(new uint16_t[nIndices]);
+  memcpy(indices.get(), data + sizeof(header), nIndices * sizeof(uint16_t));
+  for (uint32_t i = 0; i < nIndices; i++) {
+    if (indices[i] + (1u << (kLogValuesPerPage - kLogBitsPerEl)) >
+        header.nBitmapElements) {
+      return false;
+    }
+  }
+  std::unique_ptr<element[]> bitmaps(new element[header.nBitmapElements]);
+  memcpy(bitmaps.get(), data + sizeof(header) + nIndices * sizeof(uint16_t),
+         header.nBitmapElements * sizeof(element));
+
+  mMaxVal = header.maxVal;
+  mZeroPageIndex = header.zeroPageIndex;
+  mIndices = std::move(indices);
+  mBitmaps = std::move(bitmaps);
+  return true;
+}
+
 #if defined(_WIN32)
 int SparseBitSet::CountLeadingZeros(element x) {
   return sizeof(element) <= sizeof(int) ? clz_win(x) : clzl_win(x);
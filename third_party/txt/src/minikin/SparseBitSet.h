@@ -21,6 +21,7 @@
 #include <sys/types.h>
 
 #include <memory>
+#include <vector>
 
 // ---------------------------------------------------------------------------
 
@@ -65,6 +66,14 @@ class SparseBitSet {
 
   static const uint32_t kNotFound = ~0u;
 
+  // Append the set to out, in a format readFrom understands. The format is
+  // native to the machine, so it is only meant for caches on the device.
+  void writeTo(std::vector<uint8_t>* out) const;
+
+  // Initialize the set from data written by writeTo. Returns false, leaving
+  // the set empty, if the data is malformed.
+  bool readFrom(const uint8_t* data, size_t size);
+
  private:
   void initFromRanges(const uint32_t* ranges, size_t nRanges);
 
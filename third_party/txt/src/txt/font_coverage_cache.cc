@@ -0,0 +1,98 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "txt/font_coverage_cache.h"
+
+#include "flutter/fml/base32.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+
+namespace txt {
+
+namespace {
+
+std::string KeyToFileName(const std::string& key) {
+  auto encode_result = fml::Base32Encode(key);
+  if (!encode_result.first) {
+    return "";
+  }
+  return encode_result.second;
+}
+
+}  // namespace
+
+FontCoverageCache::FontCoverageCache(
+    std::shared_ptr<fml::UniqueFD> directory,
+    fml::RefPtr<fml::TaskRunner> store_task_runner)
+    : directory_(std::move(directory)),
+      store_task_runner_(std::move(store_task_runner)) {}
+
+FontCoverageCache::~FontCoverageCache() = default;
+
+bool FontCoverageCache::IsValid() const {
+  return directory_ && directory_->is_valid();
+}
+
+bool FontCoverageCache::load(
+    const std::string& key,
+    const std::function<bool(const uint8_t* data, size_t size)>& read) {
+  if (!IsValid()) {
+    return false;
+  }
+  std::string file_name = KeyToFileName(key);
+  if (file_name.empty()) {
+    return false;
+  }
+  fml::UniqueFD file = fml::OpenFileReadOnly(*directory_, file_name.c_str());
+  if (!file.is_valid()) {
+    return false;
+  }
+  fml::FileMapping mapping(file);
+  if (mapping.GetSize() == 0) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "FontCoverageCacheLoadHit");
+  return read(mapping.GetMapping(), mapping.GetSize());
+}
+
+void FontCoverageCache::store(const std::string& key,
+                              const std::vector<uint8_t>& data) {
+  if (!IsValid()) {
+    return;
+  }
+  std::string file_name = KeyToFileName(key);
+  if (file_name.empty()) {
+    return;
+  }
+  auto task = fml::MakeCopyable(
+      [directory = directory_, file_name = std::move(file_name),
+       mapping = std::make_unique<fml::DataMapping>(data)]() mutable {
+        TRACE_EVENT0("flutter", "FontCoverageCacheStore");
+        if (!fml::WriteAtomically(*directory, file_name.c_str(), *mapping)) {
+          FML_LOG(WARNING) << "Could not write the font coverage cache.";
+        }
+      });
+  if (store_task_runner_) {
+    store_task_runner_->PostTask(std::move(task));
+  } else {
+    task();
+  }
+}
+
+}  // namespace txt
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2020 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TXT_FONT_COVERAGE_CACHE_H_
+#define TXT_FONT_COVERAGE_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+#include "minikin/FontFamily.h"
+
+namespace txt {
+
+// Stores the coverage of font families in a directory, one file per font, so
+// that the cmap tables of fonts don't need to be parsed again in later runs.
+// Files are memory mapped when they are loaded.
+class FontCoverageCache : public minikin::FontCoverageCache {
+ public:
+  // Files are written on |store_task_runner| if it is not null, and on the
+  // calling thread otherwise.
+  FontCoverageCache(std::shared_ptr<fml::UniqueFD> directory,
+                    fml::RefPtr<fml::TaskRunner> store_task_runner);
+
+  ~FontCoverageCache() override;
+
+  bool IsValid() const;
+
+  // |minikin::FontCoverageCache|
+  bool load(const std::string& key,
+            const std::function<bool(const uint8_t* data, size_t size)>& read)
+      override;
+
+  // |minikin::FontCoverageCache|
+  void store(const std::string& key, const std::vector<uint8_t>& data) override;
+
+ private:
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const fml::RefPtr<fml::TaskRunner> store_task_runner_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FontCoverageCache);
+};
+
+}  // namespace txt
+
+#endif  // TXT_FONT_COVERAGE_CACHE_H_
@@ -102,4 +102,9 @@ void PaintRecord::SetOffset(SkPoint pt) {
   offset_ = pt;
 }
 
+void PaintRecord::SetStyle(const TextStyle& style) {
+  FML_DCHECK(style_.HasSameLayout(style));
+  style_ = style;
+}
+
 }  // namespace txt
@@ -70,6 +70,9 @@ class PaintRecord {
 
   void SetOffset(SkPoint pt);
 
+  // Replaces the style of the record, which must have the same layout.
+  void SetStyle(const TextStyle& style);
+
   SkTextBlob* text() const { return text_.get(); }
 
   const SkFontMetrics& metrics() const { return metrics_; }
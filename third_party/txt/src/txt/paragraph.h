@@ -175,6 +175,15 @@ class Paragraph {
   virtual Range<size_t> GetWordBoundary(size_t offset) = 0;
 
   virtual std::vector<LineMetrics>& GetLineMetrics() = 0;
+
+  // Replaces the styles of this laid out paragraph with those of |styled|,
+  // which must have been built by the same kind of ParagraphBuilder, while
+  // keeping the layout. This only succeeds if both paragraphs have the same
+  // text, placeholders and paragraph style, and their text styles only differ
+  // in attributes that don't affect layout, like colors, decorations and
+  // shadows. Returns false and leaves this paragraph unchanged otherwise, in
+  // which case |styled| has to be laid out instead.
+  virtual bool UpdatePaintStyles(Paragraph& styled) { return false; }
 };
 
 }  // namespace txt
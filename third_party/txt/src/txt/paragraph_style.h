@@ -102,6 +102,8 @@ class ParagraphStyle {
 
   TextStyle GetTextStyle() const;
 
+  bool equals(const ParagraphStyle& other) const;
+
   bool unlimited_lines() const;
   bool ellipsized() const;
 
@@ -187,6 +187,25 @@ void FindWords(const std::vector<uint16_t>& text,
     words->emplace_back(word_start, end);
 }
 
+// The first code unit that may have a right-to-left or bidi control character
+// as its bidi class. None of the code units before it are surrogates either.
+const uint16_t kFirstBidiCodeUnit = 0x0590;
+
+// Whether |text| is made of code units below kFirstBidiCodeUnit, such as
+// ASCII, Latin, Greek and Cyrillic text. In a left-to-right paragraph, such
+// text is always a single left-to-right bidi run.
+bool IsSimpleText(const std::vector<uint16_t>& text) {
+  return std::all_of(text.begin(), text.end(),
+                     [](uint16_t c) { return c < kFirstBidiCodeUnit; });
+}
+
+// Whether a code unit of simple text is a hard line break. These are the only
+// code units below kFirstBidiCodeUnit whose line break property is
+// U_LB_LINE_FEED or U_LB_MANDATORY_BREAK.
+bool IsSimpleTextHardBreak(uint16_t c) {
+  return c == 0x000A || c == 0x000B || c == 0x000C;
+}
+
 }  // namespace
 
 static const float kDoubleDecorationSpacing = 3.0f;
@@ -239,7 +258,42 @@ void ParagraphTxt::SetText(std::vector<uint16_t> text, StyledRuns runs) {
   if (text.size() == 0)
     return;
   text_ = std::move(text);
+  word_breaker_has_text_ = false;
   runs_ = std::move(runs);
+  is_simple_text_ = IsSimpleText(text_);
+}
+
+bool ParagraphTxt::UpdatePaintStyles(StyledRuns runs) {
+  if (needs_layout_ || !runs_.HasSameLayout(runs))
+    return false;
+  // The runs, line metrics and records refer to the styles of runs_, which
+  // are updated in place. The records have their own copies.
+  runs_.CopyStylesFrom(runs);
+  for (size_t i = 0; i < records_.size(); ++i) {
+    records_[i].SetStyle(*record_styles_[i]);
+  }
+  record_paint_caches_.clear();
+  return true;
+}
+
+bool ParagraphTxt::UpdatePaintStyles(Paragraph& styled) {
+  // Both paragraphs were made by a ParagraphBuilderTxt.
+  const ParagraphTxt& other = static_cast<const ParagraphTxt&>(styled);
+  if (text_ != other.text_ ||
+      !paragraph_style_.equals(other.paragraph_style_) ||
+      font_collection_ != other.font_collection_ ||
+      obj_replacement_char_indexes_ != other.obj_replacement_char_indexes_ ||
+      inline_placeholders_.size() != other.inline_placeholders_.size())
+    return false;
+  for (size_t i = 0; i < inline_placeholders_.size(); ++i) {
+    const PlaceholderRun& a = inline_placeholders_[i];
+    const PlaceholderRun& b = other.inline_placeholders_[i];
+    if (a.width != b.width || a.height != b.height ||
+        a.alignment != b.alignment || a.baseline != b.baseline ||
+        a.baseline_offset != b.baseline_offset)
+      return false;
+  }
+  return UpdatePaintStyles(other.runs_);
 }
 
 void ParagraphTxt::SetInlinePlaceholders(
@@ -258,6 +312,11 @@ bool ParagraphTxt::ComputeLineBreaks() {
   std::vector<size_t> newline_positions;
   // Discover and add all hard breaks.
   for (size_t i = 0; i < text_.size(); ++i) {
+    if (is_simple_text_) {
+      if (IsSimpleTextHardBreak(text_[i]))
+        newline_positions.push_back(i);
+      continue;
+    }
     ULineBreak ulb = static_cast<ULineBreak>(
         u_getIntPropertyValue(text_[i], UCHAR_LINE_BREAK));
     if (ulb == U_LB_LINE_FEED || ulb == U_LB_MANDATORY_BREAK)
@@ -382,10 +441,51 @@ bool ParagraphTxt::ComputeLineBreaks() {
   return true;
 }
 
+void ParagraphTxt::AppendBidiRun(
+    size_t bidi_run_start,
+    size_t bidi_run_end,
+    TextDirection text_direction,
+    const std::map<size_t, StyledRuns::Run>& styled_run_map,
+    std::vector<BidiRun>* result) {
+  // Break this bidi run into chunks based on text style.
+  std::vector<BidiRun> chunks;
+  size_t chunk_start = bidi_run_start;
+  while (chunk_start < bidi_run_end) {
+    auto styled_run_iter = styled_run_map.upper_bound(chunk_start);
+    styled_run_iter--;
+    const StyledRuns::Run& styled_run = styled_run_iter->second;
+    size_t chunk_end = std::min(bidi_run_end, styled_run.end);
+    chunks.emplace_back(chunk_start, chunk_end, text_direction,
+                        styled_run.style);
+    chunk_start = chunk_end;
+  }
+
+  if (text_direction == TextDirection::ltr) {
+    result->insert(result->end(), chunks.begin(), chunks.end());
+  } else {
+    result->insert(result->end(), chunks.rbegin(), chunks.rend());
+  }
+}
+
 bool ParagraphTxt::ComputeBidiRuns(std::vector<BidiRun>* result) {
   if (text_.empty())
     return true;
 
+  // Build a map of styled runs indexed by start position.
+  std::map<size_t, StyledRuns::Run> styled_run_map;
+  for (size_t i = 0; i < runs_.size(); ++i) {
+    StyledRuns::Run run = runs_.GetRun(i);
+    styled_run_map.emplace(std::make_pair(run.start, run));
+  }
+
+  // Simple text in a left-to-right paragraph is a single left-to-right run,
+  // without any bidi control characters to exclude.
+  if (is_simple_text_ &&
+      paragraph_style_.text_direction == TextDirection::ltr) {
+    AppendBidiRun(0, text_.size(), TextDirection::ltr, styled_run_map, result);
+    return true;
+  }
+
   auto ubidi_closer = [](UBiDi* b) { ubidi_close(b); };
   std::unique_ptr<UBiDi, decltype(ubidi_closer)> bidi(ubidi_open(),
                                                       ubidi_closer);
@@ -444,13 +544,6 @@ bool ParagraphTxt::ComputeBidiRuns(std::vector<BidiRun>* result) {
     }
   }
 
-  // Build a map of styled runs indexed by start position.
-  std::map<size_t, StyledRuns::Run> styled_run_map;
-  for (size_t i = 0; i < runs_.size(); ++i) {
-    StyledRuns::Run run = runs_.GetRun(i);
-    styled_run_map.emplace(std::make_pair(run.start, run));
-  }
-
   for (int32_t bidi_run_index = 0; bidi_run_index < bidi_run_count;
        ++bidi_run_index) {
     UBiDiDirection direction = ubidi_getVisualRun(
@@ -487,25 +580,8 @@ bool ParagraphTxt::ComputeBidiRuns(std::vector<BidiRun>* result) {
     size_t bidi_run_end = bidi_run_start + bidi_run_length;
     TextDirection text_direction =
         direction == UBIDI_RTL ? TextDirection::rtl : TextDirection::ltr;
-
-    // Break this bidi run into chunks based on text style.
-    std::vector<BidiRun> chunks;
-    size_t chunk_start = bidi_run_start;
-    while (chunk_start < bidi_run_end) {
-      auto styled_run_iter = styled_run_map.upper_bound(chunk_start);
-      styled_run_iter--;
-      const StyledRuns::Run& styled_run = styled_run_iter->second;
-      size_t chunk_end = std::min(bidi_run_end, styled_run.end);
-      chunks.emplace_back(chunk_start, chunk_end, text_direction,
-                          styled_run.style);
-      chunk_start = chunk_end;
-    }
-
-    if (text_direction == TextDirection::ltr) {
-      result->insert(result->end(), chunks.begin(), chunks.end());
-    } else {
-      result->insert(result->end(), chunks.rbegin(), chunks.rend());
-    }
+    AppendBidiRun(bidi_run_start, bidi_run_end, text_direction, styled_run_map,
+                  result);
   }
 
   return true;
@@ -668,7 +744,10 @@ void ParagraphTxt::Layout(double width) {
   needs_layout_ = false;
 
   records_.clear();
+  record_styles_.clear();
+  record_paint_caches_.clear();
   glyph_lines_.clear();
+  glyph_line_start_indexes_.clear();
   code_unit_runs_.clear();
   inline_placeholder_code_unit_runs_.clear();
   max_right_ = FLT_MIN;
@@ -796,6 +875,7 @@ void ParagraphTxt::Layout(double width) {
     double run_x_offset = 0;
     double justify_x_offset = 0;
     std::vector<PaintRecord> paint_records;
+    std::vector<const TextStyle*> paint_record_styles;
 
     for (auto line_run_it = line_runs.begin(); line_run_it != line_runs.end();
          ++line_run_it) {
@@ -1032,6 +1112,7 @@ void ParagraphTxt::Layout(double width) {
             run.style(), SkPoint::Make(run_x_offset + justify_x_offset, 0),
             builder.make(), *metrics, line_number, record_x_pos.start,
             record_x_pos.end, run.is_ghost(), run.placeholder_run());
+        paint_record_styles.push_back(&run.style());
         justify_x_offset += justify_x_offset_delta;
 
         line_glyph_positions.insert(line_glyph_positions.end(),
@@ -1160,6 +1241,8 @@ void ParagraphTxt::Layout(double width) {
           SkPoint::Make(paint_record.offset().x() + line_x_offset, y_offset));
       records_.emplace_back(std::move(paint_record));
     }
+    record_styles_.insert(record_styles_.end(), paint_record_styles.begin(),
+                          paint_record_styles.end());
   }  // for each line_number
 
   if (paragraph_style_.max_lines == 1 ||
@@ -1386,7 +1469,9 @@ void ParagraphTxt::Paint(SkCanvas* canvas, double x, double y) {
   for (const PaintRecord& record : records_) {
     PaintBackground(canvas, record, base_offset);
   }
-  for (const PaintRecord& record : records_) {
+  for (size_t i = 0; i < records_.size(); ++i) {
+    const PaintRecord& record = records_[i];
+    const RecordPaintCache& cache = GetRecordPaintCache(i);
     if (record.style().has_foreground) {
       paint = record.style().foreground;
     } else {
@@ -1395,16 +1480,43 @@ void ParagraphTxt::Paint(SkCanvas* canvas, double x, double y) {
     }
     SkPoint offset = base_offset + record.offset();
     if (record.GetPlaceholderRun() == nullptr) {
-      PaintShadow(canvas, record, offset);
+      PaintShadow(canvas, record, cache, offset);
       canvas->drawTextBlob(record.text(), offset.x(), offset.y(), paint);
     }
-    PaintDecorations(canvas, record, base_offset);
+    PaintDecorations(canvas, record, cache, base_offset);
   }
 }
 
-void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
-                                    const PaintRecord& record,
-                                    SkPoint base_offset) {
+const ParagraphTxt::RecordPaintCache& ParagraphTxt::GetRecordPaintCache(
+    size_t record_index) {
+  if (record_paint_caches_.size() != records_.size()) {
+    record_paint_caches_.clear();
+    record_paint_caches_.resize(records_.size());
+  }
+  RecordPaintCache& cache = record_paint_caches_[record_index];
+  if (cache.is_valid) {
+    return cache;
+  }
+  const PaintRecord& record = records_[record_index];
+  for (const TextShadow& text_shadow : record.style().text_shadows) {
+    if (!text_shadow.hasShadow()) {
+      continue;
+    }
+    SkPaint paint;
+    paint.setColor(text_shadow.color);
+    if (text_shadow.blur_radius != 0.0) {
+      paint.setMaskFilter(SkMaskFilter::MakeBlur(
+          kNormal_SkBlurStyle, text_shadow.blur_radius, false));
+    }
+    cache.shadow_paints.push_back(std::move(paint));
+  }
+  ComputeDecorations(record, &cache);
+  cache.is_valid = true;
+  return cache;
+}
+
+void ParagraphTxt::ComputeDecorations(const PaintRecord& record,
+                                      RecordPaintCache* cache) {
   if (record.style().decoration == TextDecoration::kNone)
     return;
 
@@ -1412,7 +1524,7 @@ void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
     return;
 
   const SkFontMetrics& metrics = record.metrics();
-  SkPaint paint;
+  SkPaint& paint = cache->decoration_paint;
   paint.setStyle(SkPaint::kStroke_Style);
   if (record.style().decoration_color == SK_ColorTRANSPARENT) {
     paint.setColor(record.style().color);
@@ -1439,12 +1551,11 @@ void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
     // Divide by 14pt as it is the default size.
     underline_thickness = record.style().font_size / 14.0f;
   }
-  paint.setStrokeWidth(underline_thickness *
-                       record.style().decoration_thickness_multiplier);
+  SkScalar stroke_width =
+      underline_thickness * record.style().decoration_thickness_multiplier;
 
-  SkPoint record_offset = base_offset + record.offset();
-  SkScalar x = record_offset.x() + record.x_start();
-  SkScalar y = record_offset.y();
+  // The decorations are relative to the offset of the record.
+  SkScalar x = record.x_start();
 
   // Setup the decorations.
   switch (record.style().decoration_style) {
@@ -1484,14 +1595,24 @@ void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
       break;
     }
     case TextDecorationStyle::kWavy: {
-      ComputeWavyDecoration(
-          path, x, y, width,
-          underline_thickness * record.style().decoration_thickness_multiplier);
+      ComputeWavyDecoration(path, x, 0, width, stroke_width);
       break;
     }
   }
 
-  // Draw the decorations.
+  // Adds a decoration line at |y_offset| from the baseline.
+  auto add_line = [&](double y_offset) {
+    SkPath line;
+    if (record.style().decoration_style != TextDecorationStyle::kWavy) {
+      line.moveTo(x, y_offset);
+      line.lineTo(x + width, y_offset);
+    } else {
+      path.offset(0, y_offset, &line);
+    }
+    cache->decoration_lines.push_back({std::move(line), stroke_width});
+  };
+
+  // Compute the decorations.
   // Use a for loop for "kDouble" decoration style
   for (int i = 0; i < decoration_count; i++) {
     double y_offset = i * underline_thickness * kDoubleDecorationSpacing;
@@ -1503,13 +1624,7 @@ void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
            SkFontMetrics::FontMetricsFlags::kUnderlinePositionIsValid_Flag)
               ? metrics.fUnderlinePosition
               : underline_thickness;
-      if (record.style().decoration_style != TextDecorationStyle::kWavy) {
-        canvas->drawLine(x, y + y_offset, x + width, y + y_offset, paint);
-      } else {
-        SkPath offsetPath = path;
-        offsetPath.offset(0, y_offset);
-        canvas->drawPath(offsetPath, paint);
-      }
+      add_line(y_offset);
       y_offset = y_offset_original;
     }
     // Overline
@@ -1517,21 +1632,15 @@ void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
       // We subtract fAscent here because for double overlines, we want the
       // second line to be above, not below the first.
       y_offset -= metrics.fAscent;
-      if (record.style().decoration_style != TextDecorationStyle::kWavy) {
-        canvas->drawLine(x, y - y_offset, x + width, y - y_offset, paint);
-      } else {
-        SkPath offsetPath = path;
-        offsetPath.offset(0, -y_offset);
-        canvas->drawPath(offsetPath, paint);
-      }
+      add_line(-y_offset);
       y_offset = y_offset_original;
     }
     // Strikethrough
     if (record.style().decoration & TextDecoration::kLineThrough) {
       if (metrics.fFlags &
           SkFontMetrics::FontMetricsFlags::kStrikeoutThicknessIsValid_Flag)
-        paint.setStrokeWidth(metrics.fStrikeoutThickness *
-                             record.style().decoration_thickness_multiplier);
+        stroke_width = metrics.fStrikeoutThickness *
+                       record.style().decoration_thickness_multiplier;
       // Make sure the double line is "centered" vertically.
       y_offset += (decoration_count - 1.0) * underline_thickness *
                   kDoubleDecorationSpacing / -2.0;
@@ -1542,18 +1651,30 @@ void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
               // Backup value if the strikeoutposition metric is not
               // available:
               : metrics.fXHeight / -2.0;
-      if (record.style().decoration_style != TextDecorationStyle::kWavy) {
-        canvas->drawLine(x, y + y_offset, x + width, y + y_offset, paint);
-      } else {
-        SkPath offsetPath = path;
-        offsetPath.offset(0, y_offset);
-        canvas->drawPath(offsetPath, paint);
-      }
+      add_line(y_offset);
       y_offset = y_offset_original;
     }
   }
 }
 
+void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
+                                    const PaintRecord& record,
+                                    const RecordPaintCache& cache,
+                                    SkPoint base_offset) {
+  if (cache.decoration_lines.empty())
+    return;
+
+  SkPoint record_offset = base_offset + record.offset();
+  SkPaint paint = cache.decoration_paint;
+  canvas->save();
+  canvas->translate(record_offset.x(), record_offset.y());
+  for (const RecordPaintCache::DecorationLine& line : cache.decoration_lines) {
+    paint.setStrokeWidth(line.stroke_width);
+    canvas->drawPath(line.path, paint);
+  }
+  canvas->restore();
+}
+
 void ParagraphTxt::ComputeWavyDecoration(SkPath& path,
                                          double x,
                                          double y,
@@ -1611,22 +1732,16 @@ void ParagraphTxt::PaintBackground(SkCanvas* canvas,
 
 void ParagraphTxt::PaintShadow(SkCanvas* canvas,
                                const PaintRecord& record,
+                               const RecordPaintCache& cache,
                                SkPoint offset) {
-  if (record.style().text_shadows.size() == 0)
-    return;
-  for (TextShadow text_shadow : record.style().text_shadows) {
+  size_t paint_index = 0;
+  for (const TextShadow& text_shadow : record.style().text_shadows) {
     if (!text_shadow.hasShadow()) {
       continue;
     }
-
-    SkPaint paint;
-    paint.setColor(text_shadow.color);
-    if (text_shadow.blur_radius != 0.0) {
-      paint.setMaskFilter(SkMaskFilter::MakeBlur(
-          kNormal_SkBlurStyle, text_shadow.blur_radius, false));
-    }
     canvas->drawTextBlob(record.text(), offset.x() + text_shadow.offset.x(),
-                         offset.y() + text_shadow.offset.y(), paint);
+                         offset.y() + text_shadow.offset.y(),
+                         cache.shadow_paints[paint_index++]);
   }
 }
 
@@ -1657,8 +1772,18 @@ std::vector<Paragraph::TextBox> ParagraphTxt::GetRectsForRange(
   size_t min_line = INT_MAX;
   size_t glyph_length = 0;
 
+  // Lines and runs are sorted by code unit, so those that end before the first
+  // line of the range don't need to be visited.
+  const size_t first_line = GetLineIndexForCodeUnit(start);
+  auto first_run =
+      std::partition_point(code_unit_runs_.begin(), code_unit_runs_.end(),
+                           [first_line](const CodeUnitRun& run) {
+                             return run.line_number < first_line;
+                           });
+
   // Generate initial boxes and calculate metrics.
-  for (const CodeUnitRun& run : code_unit_runs_) {
+  for (auto run_it = first_run; run_it != code_unit_runs_.end(); ++run_it) {
+    const CodeUnitRun& run = *run_it;
     // Check to see if we are finished.
     if (run.code_units.start >= end)
       break;
@@ -1727,7 +1852,7 @@ std::vector<Paragraph::TextBox> ParagraphTxt::GetRectsForRange(
 
   // Add empty rectangles representing any newline characters within the
   // range.
-  for (size_t line_number = 0; line_number < line_metrics_.size();
+  for (size_t line_number = first_line; line_number < line_metrics_.size();
        ++line_number) {
     LineMetrics& line = line_metrics_[line_number];
     if (line.start_index >= end)
@@ -1857,46 +1982,57 @@ Paragraph::PositionWithAffinity ParagraphTxt::GetGlyphPositionAtCoordinate(
   if (final_line_count_ <= 0)
     return PositionWithAffinity(0, DOWNSTREAM);
 
-  size_t y_index;
-  for (y_index = 0; y_index < final_line_count_ - 1; ++y_index) {
-    if (dy < line_metrics_[y_index].height)
-      break;
-  }
+  // The line heights are cumulative, so the line can be found by a binary
+  // search. Points below the last line hit the last line.
+  const size_t y_index =
+      std::partition_point(line_metrics_.begin(),
+                           line_metrics_.begin() + final_line_count_ - 1,
+                           [dy](const LineMetrics& line) {
+                             return !(dy < line.height);
+                           }) -
+      line_metrics_.begin();
 
   const std::vector<GlyphPosition>& line_glyph_position =
       glyph_lines_[y_index].positions;
   if (line_glyph_position.empty()) {
-    int line_start_index =
-        std::accumulate(glyph_lines_.begin(), glyph_lines_.begin() + y_index, 0,
-                        [](const int a, const GlyphLine& b) {
-                          return a + static_cast<int>(b.total_code_units);
-                        });
-    return PositionWithAffinity(line_start_index, DOWNSTREAM);
-  }
-
-  size_t x_index;
-  const GlyphPosition* gp = nullptr;
-  for (x_index = 0; x_index < line_glyph_position.size(); ++x_index) {
-    double glyph_end = (x_index < line_glyph_position.size() - 1)
-                           ? line_glyph_position[x_index + 1].x_pos.start
-                           : line_glyph_position[x_index].x_pos.end;
-    if (dx < glyph_end) {
-      gp = &line_glyph_position[x_index];
-      break;
+    if (glyph_line_start_indexes_.empty()) {
+      size_t line_start_index = 0;
+      glyph_line_start_indexes_.reserve(glyph_lines_.size());
+      for (const GlyphLine& line : glyph_lines_) {
+        glyph_line_start_indexes_.push_back(line_start_index);
+        line_start_index += line.total_code_units;
+      }
     }
+    return PositionWithAffinity(glyph_line_start_indexes_[y_index], DOWNSTREAM);
   }
 
-  if (gp == nullptr) {
+  // The glyphs are sorted by x coordinate, and each one extends to the start
+  // of the next one.
+  auto next_gp = std::upper_bound(line_glyph_position.begin() + 1,
+                                  line_glyph_position.end(), dx,
+                                  [](double x, const GlyphPosition& glyph) {
+                                    return x < glyph.x_pos.start;
+                                  });
+  if (next_gp == line_glyph_position.end() &&
+      !(dx < line_glyph_position.back().x_pos.end)) {
     const GlyphPosition& last_glyph = line_glyph_position.back();
     return PositionWithAffinity(last_glyph.code_units.end, UPSTREAM);
   }
+  const GlyphPosition* gp = &*(next_gp - 1);
 
-  // Find the direction of the run that contains this glyph.
+  // Find the direction of the run that contains this glyph. The runs are
+  // sorted by their start, so it is one of those that start before the glyph.
   TextDirection direction = TextDirection::ltr;
-  for (const CodeUnitRun& run : code_unit_runs_) {
-    if (gp->code_units.start >= run.code_units.start &&
-        gp->code_units.end <= run.code_units.end) {
-      direction = run.direction;
+  auto run_it =
+      std::upper_bound(code_unit_runs_.begin(), code_unit_runs_.end(),
+                       gp->code_units.start,
+                       [](size_t code_unit, const CodeUnitRun& run) {
+                         return code_unit < run.code_units.start;
+                       });
+  while (run_it != code_unit_runs_.begin()) {
+    --run_it;
+    if (gp->code_units.end <= run_it->code_units.end) {
+      direction = run_it->direction;
       break;
     }
   }
@@ -1951,6 +2087,14 @@ std::vector<Paragraph::TextBox> ParagraphTxt::GetRectsForPlaceholders() {
   return boxes;
 }
 
+size_t ParagraphTxt::GetLineIndexForCodeUnit(size_t code_unit) const {
+  return std::partition_point(line_metrics_.begin(), line_metrics_.end(),
+                              [code_unit](const LineMetrics& line) {
+                                return line.end_including_newline <= code_unit;
+                              }) -
+         line_metrics_.begin();
+}
+
 Paragraph::Range<size_t> ParagraphTxt::GetWordBoundary(size_t offset) {
   FML_DCHECK(!needs_layout_) << "only valid after layout";
   if (text_.size() == 0)
@@ -1964,7 +2108,13 @@ Paragraph::Range<size_t> ParagraphTxt::GetWordBoundary(size_t offset) {
       return Range<size_t>(0, 0);
   }
 
-  word_breaker_->setText(icu::UnicodeString(false, text_.data(), text_.size()));
+  // Setting the text makes the break iterator scan it, so only do that once
+  // per text.
+  if (!word_breaker_has_text_) {
+    word_breaker_->setText(
+        icu::UnicodeString(false, text_.data(), text_.size()));
+    word_breaker_has_text_ = true;
+  }
 
   int32_t prev_boundary = word_breaker_->preceding(offset + 1);
   int32_t next_boundary = word_breaker_->next();
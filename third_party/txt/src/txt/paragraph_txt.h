@@ -17,6 +17,7 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_TXT_H_
 #define LIB_TXT_SRC_PARAGRAPH_TXT_H_
 
+#include <map>
 #include <set>
 #include <utility>
 #include <vector>
@@ -34,6 +35,8 @@
 #include "styled_runs.h"
 #include "third_party/googletest/googletest/include/gtest/gtest_prod.h"  // nogncheck
 #include "third_party/skia/include/core/SkFontMetrics.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPath.h"
 #include "third_party/skia/include/core/SkRect.h"
 #include "utils/LinuxUtils.h"
 #include "utils/MacUtils.h"
@@ -126,6 +129,15 @@ class ParagraphTxt : public Paragraph {
   // Layout from being calculated by setting to false.
   void SetDirty(bool dirty = true);
 
+  // Replaces the styles of a laid out paragraph with those of |runs| while
+  // keeping its layout. This only succeeds if |runs| covers the text with the
+  // same runs as the current styles, and its styles only differ in attributes
+  // that don't affect layout, like colors, decorations and shadows. Returns
+  // false and leaves the paragraph unchanged otherwise.
+  bool UpdatePaintStyles(StyledRuns runs);
+
+  bool UpdatePaintStyles(Paragraph& styled) override;
+
  private:
   friend class ParagraphBuilderTxt;
   FRIEND_TEST(ParagraphTest, SimpleParagraph);
@@ -141,6 +153,8 @@ class ParagraphTxt : public Paragraph {
   FRIEND_TEST_WINDOWS_DISABLED(ParagraphTest, JustifyRTL);
   FRIEND_TEST_WINDOWS_DISABLED(ParagraphTest, InlinePlaceholderLongestLine);
   FRIEND_TEST_LINUX_ONLY(ParagraphTest, JustifyRTLNewLine);
+  FRIEND_TEST(ParagraphTest, UpdatePaintStylesKeepsLayout);
+  FRIEND_TEST(ParagraphTest, UpdatePaintStylesFromAnotherParagraph);
   FRIEND_TEST(ParagraphTest, DecorationsParagraph);
   FRIEND_TEST(ParagraphTest, ItalicsParagraph);
   FRIEND_TEST(ParagraphTest, ChineseParagraph);
@@ -162,8 +176,10 @@ class ParagraphTxt : public Paragraph {
   FRIEND_TEST(ParagraphTest, InlinePlaceholder0xFFFCParagraph);
   FRIEND_TEST(ParagraphTest, FontFeaturesParagraph);
   FRIEND_TEST(ParagraphTest, GetGlyphPositionAtCoordinateSegfault);
+  FRIEND_TEST(ParagraphTest, QueriesInParagraphWithManyLines);
   FRIEND_TEST(ParagraphTest, KhmerLineBreaker);
   FRIEND_TEST(ParagraphTest, TextHeightBehaviorRectsParagraph);
+  FRIEND_TEST(ParagraphTest, SimpleTextLayoutMatchesBidiLayout);
 
   // Starting data to layout.
   std::vector<uint16_t> text_;
@@ -180,11 +196,16 @@ class ParagraphTxt : public Paragraph {
   // AddText().
   std::unordered_set<size_t> obj_replacement_char_indexes_;
   StyledRuns runs_;
+  // Whether text_ only has code units that cannot change the text direction,
+  // which lets layout skip bidi analysis in left-to-right paragraphs.
+  bool is_simple_text_ = false;
   ParagraphStyle paragraph_style_;
   std::shared_ptr<FontCollection> font_collection_;
 
   minikin::LineBreaker breaker_;
   mutable std::unique_ptr<icu::BreakIterator> word_breaker_;
+  // Whether text_ has been set on word_breaker_.
+  bool word_breaker_has_text_ = false;
 
   std::vector<LineMetrics> line_metrics_;
   size_t final_line_count_;
@@ -192,6 +213,25 @@ class ParagraphTxt : public Paragraph {
 
   // Stores the result of Layout().
   std::vector<PaintRecord> records_;
+  // The style in runs_ of each record, used to update the records when only
+  // the paint of the styles changes.
+  std::vector<const TextStyle*> record_styles_;
+
+  // The parts of painting a record that don't depend on where the paragraph
+  // is painted. Built when a record is first painted.
+  struct RecordPaintCache {
+    struct DecorationLine {
+      SkPath path;
+      SkScalar stroke_width;
+    };
+
+    bool is_valid = false;
+    std::vector<SkPaint> shadow_paints;
+    SkPaint decoration_paint;
+    // Relative to the offset of the record.
+    std::vector<DecorationLine> decoration_lines;
+  };
+  std::vector<RecordPaintCache> record_paint_caches_;
 
   bool did_exceed_max_lines_;
 
@@ -302,6 +342,9 @@ class ParagraphTxt : public Paragraph {
 
   // Holds the laid out x positions of each glyph.
   std::vector<GlyphLine> glyph_lines_;
+  // The index of the first code unit of each glyph line. Built on demand by
+  // hit testing.
+  std::vector<size_t> glyph_line_start_indexes_;
 
   // Holds the positions of each range of code units in the text.
   // Sorted in code unit index order.
@@ -348,6 +391,14 @@ class ParagraphTxt : public Paragraph {
   // Break the text into runs based on LTR/RTL text direction.
   bool ComputeBidiRuns(std::vector<BidiRun>* result);
 
+  // Break a bidi run into chunks based on text style and append them to
+  // result in visual order.
+  void AppendBidiRun(size_t bidi_run_start,
+                     size_t bidi_run_end,
+                     TextDirection text_direction,
+                     const std::map<size_t, StyledRuns::Run>& styled_run_map,
+                     std::vector<BidiRun>* result);
+
   // Calculates and populates strut based on paragraph_style_ strut info.
   void ComputeStrut(StrutMetrics* strut, SkFont& font);
 
@@ -373,9 +424,21 @@ class ParagraphTxt : public Paragraph {
   // alignment.
   double GetLineXOffset(double line_total_advance, bool justify_line);
 
-  // Creates and draws the decorations onto the canvas.
+  // Returns the index of the line that contains |code_unit|, or the number of
+  // lines if it is past the end of the text.
+  size_t GetLineIndexForCodeUnit(size_t code_unit) const;
+
+  // Returns the paint cache of the record at |record_index|, building it if
+  // needed.
+  const RecordPaintCache& GetRecordPaintCache(size_t record_index);
+
+  // Computes the decorations of the record, relative to its offset.
+  void ComputeDecorations(const PaintRecord& record, RecordPaintCache* cache);
+
+  // Draws the decorations onto the canvas.
   void PaintDecorations(SkCanvas* canvas,
                         const PaintRecord& record,
+                        const RecordPaintCache& cache,
                         SkPoint base_offset);
 
   // Computes the beziers for a wavy decoration. The results will be
@@ -392,7 +455,10 @@ class ParagraphTxt : public Paragraph {
                        SkPoint base_offset);
 
   // Draws the shadows onto the canvas.
-  void PaintShadow(SkCanvas* canvas, const PaintRecord& record, SkPoint offset);
+  void PaintShadow(SkCanvas* canvas,
+                   const PaintRecord& record,
+                   const RecordPaintCache& cache,
+                   SkPoint offset);
 
   // Obtain a Minikin font collection matching this text style.
   std::shared_ptr<minikin::FontCollection> GetMinikinFontCollectionForStyle(
@@ -73,4 +73,31 @@ StyledRuns::Run StyledRuns::GetRun(size_t index) const {
   return Run{styles_[run.style_index], run.start, run.end};
 }
 
+bool StyledRuns::HasSameLayout(const StyledRuns& other) const {
+  if (styles_.size() != other.styles_.size() ||
+      runs_.size() != other.runs_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < runs_.size(); ++i) {
+    if (runs_[i].style_index != other.runs_[i].style_index ||
+        runs_[i].start != other.runs_[i].start ||
+        runs_[i].end != other.runs_[i].end) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < styles_.size(); ++i) {
+    if (!styles_[i].HasSameLayout(other.styles_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StyledRuns::CopyStylesFrom(const StyledRuns& other) {
+  FML_DCHECK(HasSameLayout(other));
+  for (size_t i = 0; i < styles_.size(); ++i) {
+    styles_[i] = other.styles_[i];
+  }
+}
+
 }  // namespace txt
@@ -60,6 +60,14 @@ class StyledRuns {
 
   Run GetRun(size_t index) const;
 
+  // Whether |other| has the same runs as this, with styles that have the same
+  // layout.
+  bool HasSameLayout(const StyledRuns& other) const;
+
+  // Copies the styles of |other|, which must have the same layout as this.
+  // The styles are assigned in place, so references to them stay valid.
+  void CopyStylesFrom(const StyledRuns& other);
+
  private:
   FRIEND_TEST(ParagraphTest, SimpleParagraph);
   FRIEND_TEST(ParagraphTest, SimpleParagraphSmall);
@@ -67,4 +67,17 @@ bool TextStyle::equals(const TextStyle& other) const {
   return true;
 }
 
+bool TextStyle::HasSameLayout(const TextStyle& other) const {
+  return font_weight == other.font_weight && font_style == other.font_style &&
+         text_baseline == other.text_baseline &&
+         font_families == other.font_families &&
+         font_size == other.font_size &&
+         letter_spacing == other.letter_spacing &&
+         word_spacing == other.word_spacing && height == other.height &&
+         has_height_override == other.has_height_override &&
+         locale == other.locale &&
+         font_features.GetFontFeatures() ==
+             other.font_features.GetFontFeatures();
+}
+
 }  // namespace txt
@@ -65,6 +65,10 @@ class TextStyle {
   TextStyle();
 
   bool equals(const TextStyle& other) const;
+
+  // Whether text laid out with this style and |other| has the same glyphs and
+  // positions, i.e. whether the styles only differ in how the text is painted.
+  bool HasSameLayout(const TextStyle& other) const;
 };
 
 }  // namespace txt
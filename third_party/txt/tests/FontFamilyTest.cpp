@@ -16,6 +16,8 @@
 
 #include <minikin/FontFamily.h>
 
+#include <map>
+
 #include <gtest/gtest.h>
 #include <log/log.h>
 
@@ -723,4 +725,58 @@ TEST_F(FontFamilyTest, coverageTableSelectionTest) {
   EXPECT_TRUE(unicodeEnc4Font->hasGlyph(0x1F926, 0));
 }
 
+class FontCoverageCacheForTest : public FontCoverageCache {
+ public:
+  bool load(const std::string& key,
+            const std::function<bool(const uint8_t* data, size_t size)>& read)
+      override {
+    auto found = mEntries.find(key);
+    if (found == mEntries.end()) {
+      return false;
+    }
+    mHits++;
+    return read(found->second.data(), found->second.size());
+  }
+
+  void store(const std::string& key,
+             const std::vector<uint8_t>& data) override {
+    mEntries[key] = data;
+  }
+
+  std::map<std::string, std::vector<uint8_t>> mEntries;
+  int mHits = 0;
+};
+
+TEST_F(FontFamilyTest, coverageCacheTest) {
+  auto cache = std::make_shared<FontCoverageCacheForTest>();
+  FontFamily::setCoverageCache(cache);
+
+  std::shared_ptr<FontFamily> computed = makeFamily(kVsTestFont);
+  EXPECT_EQ(1u, cache->mEntries.size());
+  EXPECT_EQ(0, cache->mHits);
+
+  std::shared_ptr<FontFamily> cached = makeFamily(kVsTestFont);
+  EXPECT_EQ(1, cache->mHits);
+  EXPECT_EQ(computed->hasVSTable(), cached->hasVSTable());
+  for (uint32_t ch = 0; ch <= MAX_UNICODE_CODE_POINT; ++ch) {
+    ASSERT_EQ(computed->getCoverage().get(ch), cached->getCoverage().get(ch))
+        << std::hex << ch;
+  }
+
+  // A different font doesn't use the entry of the first one.
+  makeFamily(kTestFontDir "Bold.ttf");
+  EXPECT_EQ(2u, cache->mEntries.size());
+  EXPECT_EQ(1, cache->mHits);
+
+  // Entries that can't be read are computed again.
+  for (auto& entry : cache->mEntries) {
+    entry.second.resize(1);
+  }
+  std::shared_ptr<FontFamily> recomputed = makeFamily(kVsTestFont);
+  EXPECT_EQ(2, cache->mHits);
+  EXPECT_TRUE(recomputed->getCoverage().get(0x82A6));
+
+  FontFamily::setCoverageCache(nullptr);
+}
+
 }  // namespace minikin
@@ -51,4 +51,41 @@ TEST(SparseBitSetTest, randomTest) {
   }
 }
 
+TEST(SparseBitSetTest, serializeTest) {
+  const uint32_t ranges[] = {0x20, 0x7F, 0x3000, 0x3003, 0x4E00, 0x9FFF};
+  SparseBitSet bitset(ranges, 3);
+
+  std::vector<uint8_t> data;
+  bitset.writeTo(&data);
+
+  SparseBitSet copy;
+  ASSERT_TRUE(copy.readFrom(data.data(), data.size()));
+  EXPECT_EQ(bitset.length(), copy.length());
+  for (uint32_t ch = 0; ch < 0x10000; ++ch) {
+    ASSERT_EQ(bitset.get(ch), copy.get(ch)) << std::hex << ch;
+  }
+  EXPECT_EQ(copy.nextSetBit(0x80), 0x3000u);
+
+  // Truncated data is rejected.
+  SparseBitSet truncated;
+  EXPECT_FALSE(truncated.readFrom(data.data(), data.size() - 1));
+  EXPECT_EQ(truncated.length(), 0u);
+  EXPECT_FALSE(truncated.get(0x20));
+
+  // So is data whose first page index points past its bitmaps. The indices
+  // follow a 12 byte header.
+  std::vector<uint8_t> corrupted = data;
+  corrupted[12] = 0xFF;
+  corrupted[13] = 0xFF;
+  SparseBitSet corrupted_copy;
+  EXPECT_FALSE(corrupted_copy.readFrom(corrupted.data(), corrupted.size()));
+
+  SparseBitSet empty;
+  std::vector<uint8_t> empty_data;
+  empty.writeTo(&empty_data);
+  SparseBitSet empty_copy;
+  ASSERT_TRUE(empty_copy.readFrom(empty_data.data(), empty_data.size()));
+  EXPECT_EQ(empty_copy.length(), 0u);
+}
+
 }  // namespace minikin
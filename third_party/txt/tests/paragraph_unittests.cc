@@ -18,6 +18,7 @@
 #include <iostream>
 
 #include "flutter/fml/logging.h"
+#include "minikin/Layout.h"
 #include "render_test.h"
 #include "third_party/icu/source/common/unicode/unistr.h"
 #include "third_party/skia/include/core/SkColor.h"
@@ -176,6 +177,57 @@ TEST_F(ParagraphTest, GetGlyphPositionAtCoordinateSegfault) {
   ASSERT_TRUE(Snapshot());
 }
 
+// Check that hit testing and range queries find the right line in a
+// paragraph with many lines.
+TEST_F(ParagraphTest, QueriesInParagraphWithManyLines) {
+  const size_t kLineCount = 200;
+  std::u16string u16_text;
+  for (size_t i = 0; i < kLineCount; ++i) {
+    u16_text += u"AAA\n";
+  }
+
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Ahem");
+  text_style.color = SK_ColorBLACK;
+  text_style.font_size = 10;
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(GetTestCanvasWidth());
+  ASSERT_GE(paragraph->GetLineCount(), kLineCount);
+
+  for (size_t i = 0; i < kLineCount; i += 17) {
+    const size_t line_start = i * 4;
+    const double line_top = i == 0 ? 0 : paragraph->line_metrics_[i - 1].height;
+    const double line_bottom = paragraph->line_metrics_[i].height;
+    const double dy = (line_top + line_bottom) / 2;
+
+    EXPECT_EQ(paragraph->GetGlyphPositionAtCoordinate(1, dy).position,
+              line_start);
+    EXPECT_EQ(paragraph->GetGlyphPositionAtCoordinate(12, dy).position,
+              line_start + 1);
+
+    std::vector<txt::Paragraph::TextBox> boxes = paragraph->GetRectsForRange(
+        line_start + 1, line_start + 2, Paragraph::RectHeightStyle::kMax,
+        Paragraph::RectWidthStyle::kTight);
+    ASSERT_EQ(boxes.size(), 1ull);
+    EXPECT_FLOAT_EQ(boxes[0].rect.left(), 10);
+    EXPECT_FLOAT_EQ(boxes[0].rect.right(), 20);
+    EXPECT_NEAR(boxes[0].rect.top(), line_top, 1);
+    EXPECT_NEAR(boxes[0].rect.bottom(), line_bottom, 1);
+
+    txt::Paragraph::Range<size_t> word =
+        paragraph->GetWordBoundary(line_start + 1);
+    EXPECT_EQ(word.start, line_start);
+    EXPECT_EQ(word.end, line_start + 3);
+  }
+}
+
 // Check that GetGlyphPositionAtCoordinate computes correct text positions for
 // a paragraph containing multiple styled runs.
 TEST_F(ParagraphTest, GetGlyphPositionAtCoordinateMultiRun) {
@@ -2512,6 +2564,100 @@ TEST_F(ParagraphTest, DISABLE_ON_WINDOWS(LeadingSpaceRTL)) {
   // This test should crash if behavior regresses.
 }
 
+TEST_F(ParagraphTest, UpdatePaintStylesKeepsLayout) {
+  const std::u16string text = u"Paint only updates keep the glyphs";
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.font_size = 26;
+  text_style.color = SK_ColorBLACK;
+  text_style.decoration = TextDecoration::kUnderline;
+  text_style.decoration_style = txt::TextDecorationStyle::kWavy;
+  builder.PushStyle(text_style);
+  builder.AddText(text);
+  builder.Pop();
+
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(GetTestCanvasWidth());
+  paragraph->Paint(GetCanvas(), 10.0, 15.0);
+  ASSERT_FALSE(paragraph->records_.empty());
+  const SkTextBlob* blob = paragraph->records_[0].text();
+  const double height = paragraph->GetHeight();
+
+  auto make_runs = [&](const txt::TextStyle& style) {
+    txt::StyledRuns runs;
+    runs.AddStyle(paragraph_style.GetTextStyle());
+    runs.StartRun(runs.AddStyle(style), 0);
+    runs.EndRunIfNeeded(text.size());
+    return runs;
+  };
+
+  text_style.color = SK_ColorRED;
+  text_style.decoration_color = SK_ColorBLUE;
+  text_style.decoration_style = txt::TextDecorationStyle::kDouble;
+  text_style.text_shadows.emplace_back(SK_ColorGREEN, SkPoint::Make(2, 2), 1);
+  ASSERT_TRUE(paragraph->UpdatePaintStyles(make_runs(text_style)));
+  EXPECT_FALSE(paragraph->needs_layout_);
+  EXPECT_EQ(paragraph->records_[0].text(), blob);
+  EXPECT_EQ(paragraph->records_[0].style().color, SK_ColorRED);
+  EXPECT_EQ(paragraph->records_[0].style().decoration_style,
+            txt::TextDecorationStyle::kDouble);
+  EXPECT_EQ(paragraph->GetHeight(), height);
+
+  paragraph->Paint(GetCanvas(), 10.0, 15.0);
+  ASSERT_EQ(paragraph->record_paint_caches_.size(),
+            paragraph->records_.size());
+  EXPECT_EQ(paragraph->record_paint_caches_[0].shadow_paints.size(), 1ull);
+  // The double underline.
+  EXPECT_EQ(paragraph->record_paint_caches_[0].decoration_lines.size(), 2ull);
+  ASSERT_TRUE(Snapshot());
+
+  // Changes that affect layout are rejected.
+  txt::TextStyle larger_style = text_style;
+  larger_style.font_size = 30;
+  EXPECT_FALSE(paragraph->UpdatePaintStyles(make_runs(larger_style)));
+  EXPECT_EQ(paragraph->records_[0].style().font_size, 26);
+
+  // So are different runs.
+  txt::StyledRuns split_runs = make_runs(text_style);
+  split_runs.StartRun(0, 5);
+  split_runs.EndRunIfNeeded(text.size());
+  EXPECT_FALSE(paragraph->UpdatePaintStyles(std::move(split_runs)));
+}
+
+TEST_F(ParagraphTest, UpdatePaintStylesFromAnotherParagraph) {
+  const std::u16string text = u"Paint only updates keep the glyphs";
+  txt::ParagraphStyle paragraph_style;
+  auto build = [&](SkColor color, const std::u16string& content) {
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    txt::TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, "Roboto");
+    text_style.font_size = 26;
+    text_style.color = color;
+    builder.PushStyle(text_style);
+    builder.AddText(content);
+    builder.Pop();
+    return BuildParagraph(builder);
+  };
+
+  auto paragraph = build(SK_ColorBLACK, text);
+  paragraph->Layout(GetTestCanvasWidth());
+  ASSERT_FALSE(paragraph->records_.empty());
+  const SkTextBlob* blob = paragraph->records_[0].text();
+
+  auto recolored = build(SK_ColorRED, text);
+  ASSERT_TRUE(paragraph->UpdatePaintStyles(*recolored));
+  EXPECT_EQ(paragraph->records_[0].text(), blob);
+  EXPECT_EQ(paragraph->records_[0].style().color, SK_ColorRED);
+
+  // Paragraphs with other text are rejected.
+  auto other_text = build(SK_ColorBLUE, u"Other text");
+  EXPECT_FALSE(paragraph->UpdatePaintStyles(*other_text));
+  EXPECT_EQ(paragraph->records_[0].style().color, SK_ColorRED);
+}
+
 TEST_F(ParagraphTest, DecorationsParagraph) {
   txt::ParagraphStyle paragraph_style;
   paragraph_style.max_lines = 14;
@@ -6431,6 +6577,144 @@ TEST_F(ParagraphTest, FontFeaturesParagraph) {
   ASSERT_TRUE(Snapshot());
 }
 
+TEST_F(ParagraphTest, FontFeaturesParagraphIsCached) {
+  const char* text = "12ab 12ab 12ab";
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+  text_style.font_features.SetFeature("tnum", 1);
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+
+  auto paragraph = BuildParagraph(builder);
+
+  minikin::Layout::purgeCaches();
+  paragraph->Layout(GetTestCanvasWidth());
+  const auto first_layout = minikin::Layout::getCacheStats();
+
+  // The words and spaces repeat, so they are only shaped once.
+  EXPECT_GT(first_layout.misses, 0ull);
+  EXPECT_LE(first_layout.misses, 2ull);
+  EXPECT_GT(first_layout.hits, 0ull);
+
+  paragraph->SetDirty();
+  paragraph->Layout(GetTestCanvasWidth());
+  const auto second_layout = minikin::Layout::getCacheStats();
+
+  EXPECT_EQ(second_layout.misses, first_layout.misses);
+  EXPECT_GT(second_layout.hits, first_layout.hits);
+}
+
+TEST_F(ParagraphTest, SimpleTextLayoutMatchesBidiLayout) {
+  const std::vector<std::string> corpus = {
+      "Hello World",
+      "This is a very long sentence to test if the text will properly wrap "
+      "around and go to the next line. Sometimes, short sentence.",
+      "Numbers 1234567890, 3.14 and -42, punctuation (!?.,;:'\") and symbols "
+      "#$%&*+-/<=>@[]^_{|}~",
+      "Line one\nLine two\n\nLine four\x0b"
+      "vertical tab\x0c"
+      "form feed\rcarriage return",
+      "\ttabs\tand  double  spaces   ",
+      "Latin-1 and extended Latin: café, naïve, Ærøskøbing, Straße, Đorđe",
+      "Greek Ελληνικά, Cyrillic Кириллица and Armenian Հայերեն",
+      "trailing whitespace \n",
+      " ",
+  };
+
+  for (const std::string& text : corpus) {
+    SCOPED_TRACE(text);
+    auto icu_text = icu::UnicodeString::fromUTF8(text);
+    std::u16string u16_text(icu_text.getBuffer(),
+                            icu_text.getBuffer() + icu_text.length());
+
+    auto build_paragraph = [&]() {
+      txt::ParagraphStyle paragraph_style;
+      txt::ParagraphBuilderTxt builder(paragraph_style,
+                                       GetTestFontCollection());
+
+      // Split the text into two styles to exercise chunking of bidi runs.
+      txt::TextStyle text_style;
+      text_style.font_families = std::vector<std::string>(1, "Roboto");
+      text_style.color = SK_ColorBLACK;
+      builder.PushStyle(text_style);
+      builder.AddText(u16_text.substr(0, u16_text.size() / 2));
+      text_style.font_size = 20;
+      builder.PushStyle(text_style);
+      builder.AddText(u16_text.substr(u16_text.size() / 2));
+      builder.Pop();
+      builder.Pop();
+
+      return BuildParagraph(builder);
+    };
+
+    auto simple_paragraph = build_paragraph();
+    ASSERT_TRUE(simple_paragraph->is_simple_text_);
+    simple_paragraph->Layout(GetTestCanvasWidth());
+
+    auto bidi_paragraph = build_paragraph();
+    bidi_paragraph->is_simple_text_ = false;
+    bidi_paragraph->Layout(GetTestCanvasWidth());
+
+    EXPECT_EQ(simple_paragraph->GetHeight(), bidi_paragraph->GetHeight());
+    EXPECT_EQ(simple_paragraph->GetLongestLine(),
+              bidi_paragraph->GetLongestLine());
+    EXPECT_EQ(simple_paragraph->GetMaxIntrinsicWidth(),
+              bidi_paragraph->GetMaxIntrinsicWidth());
+    EXPECT_EQ(simple_paragraph->GetMinIntrinsicWidth(),
+              bidi_paragraph->GetMinIntrinsicWidth());
+
+    ASSERT_EQ(simple_paragraph->line_metrics_.size(),
+              bidi_paragraph->line_metrics_.size());
+    for (size_t i = 0; i < simple_paragraph->line_metrics_.size(); ++i) {
+      const auto& simple_line = simple_paragraph->line_metrics_[i];
+      const auto& bidi_line = bidi_paragraph->line_metrics_[i];
+      EXPECT_EQ(simple_line.start_index, bidi_line.start_index);
+      EXPECT_EQ(simple_line.end_index, bidi_line.end_index);
+      EXPECT_EQ(simple_line.end_including_newline,
+                bidi_line.end_including_newline);
+      EXPECT_EQ(simple_line.hard_break, bidi_line.hard_break);
+      EXPECT_EQ(simple_line.width, bidi_line.width);
+      EXPECT_EQ(simple_line.left, bidi_line.left);
+      EXPECT_EQ(simple_line.baseline, bidi_line.baseline);
+    }
+
+    ASSERT_EQ(simple_paragraph->glyph_lines_.size(),
+              bidi_paragraph->glyph_lines_.size());
+    for (size_t i = 0; i < simple_paragraph->glyph_lines_.size(); ++i) {
+      const auto& simple_line = simple_paragraph->glyph_lines_[i];
+      const auto& bidi_line = bidi_paragraph->glyph_lines_[i];
+      EXPECT_EQ(simple_line.total_code_units, bidi_line.total_code_units);
+      ASSERT_EQ(simple_line.positions.size(), bidi_line.positions.size());
+      for (size_t j = 0; j < simple_line.positions.size(); ++j) {
+        EXPECT_EQ(simple_line.positions[j].code_units.start,
+                  bidi_line.positions[j].code_units.start);
+        EXPECT_EQ(simple_line.positions[j].x_pos.start,
+                  bidi_line.positions[j].x_pos.start);
+        EXPECT_EQ(simple_line.positions[j].x_pos.end,
+                  bidi_line.positions[j].x_pos.end);
+      }
+    }
+
+    ASSERT_EQ(simple_paragraph->records_.size(),
+              bidi_paragraph->records_.size());
+    for (size_t i = 0; i < simple_paragraph->records_.size(); ++i) {
+      EXPECT_EQ(simple_paragraph->records_[i].offset(),
+                bidi_paragraph->records_[i].offset());
+      EXPECT_EQ(simple_paragraph->records_[i].line(),
+                bidi_paragraph->records_[i].line());
+    }
+  }
+}
+
 TEST_F(ParagraphTest, KhmerLineBreaker) {
   const char* text = "និងក្មេងចង់ផ្ទៃសមុទ្រសែនខៀវស្រងាត់";
   auto icu_text = icu::UnicodeString::fromUTF8(text);